@@ -1,4 +1,4 @@
-#include "PythonRunner.h"
+#include "pythonrunner/PythonRunner.h"
 #include <Python.h>
 #include <mutex>
 
@@ -57,9 +57,10 @@ int main() {
     // internal peripheral took longer to stop than anticipated.
     SLEEP_SEC(1);
 
-    size_t peripheral_count = simpleble_adapter_scan_get_results_count(adapter);
+    simpleble_adapter_scan_snapshot_t results = simpleble_adapter_scan_get_results_snapshot(adapter);
+    size_t peripheral_count = simpleble_adapter_scan_snapshot_count(results);
     for (size_t peripheral_index = 0; peripheral_index < peripheral_count; peripheral_index++) {
-        simpleble_peripheral_t peripheral = simpleble_adapter_scan_get_results_handle(adapter, peripheral_index);
+        simpleble_peripheral_t peripheral = simpleble_adapter_scan_snapshot_get_handle(results, peripheral_index);
 
         char* peripheral_identifier = simpleble_peripheral_identifier(peripheral);
         char* peripheral_address = simpleble_peripheral_address(peripheral);
@@ -97,7 +98,8 @@ int main() {
         simpleble_free(peripheral_identifier);
     }
 
-    // Let's not forget to release the associated handle.
+    // Let's not forget to release the associated handles.
+    simpleble_adapter_scan_snapshot_release_handle(results);
     simpleble_adapter_release_handle(adapter);
 
     return 0;
@@ -0,0 +1,42 @@
+import signal
+import asyncio
+import dbus_next
+from dbus_next.aio import MessageBus
+from mock import BluezMock
+
+active = True
+bus = None
+mock = None
+
+
+def handler(signum, frame):
+    global bus
+    global active
+    mock.stop()
+    bus.disconnect()
+    active = False
+
+
+async def setup():
+    global bus
+    global mock
+    bus = await MessageBus(bus_type=dbus_next.BusType.SESSION, negotiate_unix_fd=True).connect()
+
+    # Create and register the object instances
+    mock = BluezMock(bus)
+    mock.export()
+
+    # Request bus name, which makes the mock look like BlueZ to SimpleBLE
+    await bus.request_name("org.bluez")
+
+
+async def main():
+    global active
+    while active:
+        await asyncio.sleep(0.1)
+
+
+if __name__ == "__main__":
+    signal.signal(signal.SIGINT, handler)
+    asyncio.get_event_loop().run_until_complete(setup())
+    asyncio.get_event_loop().run_until_complete(main())
@@ -0,0 +1,3 @@
+from mock.bluez import BluezMock
+
+__all__ = ["BluezMock"]
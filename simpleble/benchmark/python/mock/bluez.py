@@ -0,0 +1,215 @@
+import asyncio
+
+from dbus_next import Message
+from dbus_next.service import ServiceInterface, method
+
+from mock.interfaces import (
+    ADAPTER_PATH,
+    AcquiringCharacteristic,
+    Adapter,
+    AgentManager,
+    Characteristic,
+    Device,
+    Service,
+)
+
+
+class Control(ServiceInterface):
+    """
+    Lets the benchmarks reconfigure the mock, on the same bus as the BlueZ objects.
+    """
+
+    def __init__(self, mock):
+        super().__init__("org.simpleble.BluezMock1")
+        self.mock = mock
+
+    @method()
+    def SetAdvertisers(self, count: "u", rate: "d"):
+        self.mock.set_advertisers(count, rate)
+
+    @method()
+    def SetNotificationRate(self, rate: "d"):
+        self.mock.notification_rate = rate
+
+    @method()
+    def SetConnectionDelay(self, delay: "d"):
+        self.mock.connection_delay = delay
+
+    @method()
+    def SetAcquire(self, enabled: "b"):
+        self.mock.acquire = enabled
+
+    @method()
+    def HangUpNotify(self):
+        self.mock.hang_up_notify()
+
+    @method()
+    def GetStatistics(self) -> "a{st}":
+        return dict(self.mock.statistics)
+
+    @method()
+    def ResetStatistics(self):
+        for name in self.mock.statistics:
+            self.mock.statistics[name] = 0
+
+
+class BluezMock:
+    """
+    Fake org.bluez service with a single adapter, a configurable number of advertisers, and a single
+    characteristic on every advertiser once connected, which can be read, written and notified. With acquire
+    set, the characteristics of the next connections also hand out sockets through AcquireNotify and AcquireWrite.
+    """
+
+    def __init__(self, bus):
+        # dbus_next announces every export and unexport itself, from the path of the object instead of the root
+        # where SimpleBluez listens. Silencing it keeps each object announced exactly once, by object_add.
+        bus._emit_interface_added = lambda path, interface: None
+        bus._emit_interface_removed = lambda path, interface: None
+
+        self.bus = bus
+        self.adapter = Adapter(self)
+        self.devices = {}
+        self.advertising_rate = 0.0
+        self.advertising = None
+        self.notification_rate = 100.0
+        self.connection_delay = 0.0
+        self.acquire = False
+        self.statistics = {"advertisements": 0, "notifications": 0, "writes": 0, "connections": 0}
+
+    def export(self):
+        self.bus.export("/org/bluez", AgentManager())
+        self.bus.export("/org/bluez", Control(self))
+        self.bus.export(ADAPTER_PATH, self.adapter)
+
+    def stop(self):
+        self.advertising_stop()
+        for device in self.devices.values():
+            for _, interface in device.gatt:
+                if isinstance(interface, Characteristic):
+                    interface.stop()
+
+    def object_add(self, path, interface):
+        # InterfacesAdded and InterfacesRemoved are sent from the root, where SimpleBluez listens for them.
+        self.bus.export(path, interface)
+        self._object_manager_signal("InterfacesAdded", "oa{sa{sv}}", [path, {interface.name: interface.properties()}])
+
+    def object_remove(self, path, interface):
+        self._object_manager_signal("InterfacesRemoved", "oas", [path, [interface.name]])
+        self.bus.unexport(path, interface)
+
+    def set_advertisers(self, count, rate):
+        self.advertising_stop()
+
+        for index in range(count, len(self.devices)):
+            self.device_remove(Device(self, index).path)
+        for index in range(len(self.devices), count):
+            device = Device(self, index)
+            self.devices[device.path] = device
+            self.object_add(device.path, device)
+
+        self.advertising_rate = rate
+        if self.adapter.discovering:
+            self.advertising_start()
+
+    def advertising_start(self):
+        devices = list(self.devices.values())
+        if self.advertising or not devices:
+            return
+
+        # Advertisers take turns, so that a single task keeps up with any number of them.
+        def advertise():
+            device = devices[self.statistics["advertisements"] % len(devices)]
+            device.advertise()
+            self.statistics["advertisements"] += 1
+
+        self.advertising = self.run_at_rate(self.advertising_rate * len(devices), advertise)
+
+    def advertising_stop(self):
+        if self.advertising:
+            self.advertising.cancel()
+            self.advertising = None
+
+    def device_remove(self, path):
+        device = self.devices.pop(path, None)
+        if device is None:
+            return
+
+        self.device_disconnect(device)
+        self.object_remove(device.path, device)
+        if self.advertising:
+            self.advertising_stop()
+            self.advertising_start()
+
+    def device_connect(self, device):
+        if device.connected:
+            return
+
+        device.connected = True
+        device.emit_properties_changed({"Connected": True})
+        self.statistics["connections"] += 1
+
+        service = Service(device.path)
+        characteristic = (AcquiringCharacteristic if self.acquire else Characteristic)(self, service.path)
+        device.gatt = [(service.path, service), (characteristic.path, characteristic)]
+        for path, interface in device.gatt:
+            self.object_add(path, interface)
+
+        asyncio.get_event_loop().call_later(self.connection_delay, self._resolve_services, device)
+
+    def device_disconnect(self, device):
+        if not device.connected:
+            return
+
+        for path, interface in reversed(device.gatt):
+            if isinstance(interface, Characteristic):
+                interface.stop()
+            self.object_remove(path, interface)
+        device.gatt = []
+
+        device.connected = False
+        device.services_resolved = False
+        device.emit_properties_changed({"ServicesResolved": False, "Connected": False})
+
+    def hang_up_notify(self):
+        for device in self.devices.values():
+            for _, interface in device.gatt:
+                if isinstance(interface, AcquiringCharacteristic):
+                    interface.hang_up()
+
+    def run_at_rate(self, rate, callback):
+        """
+        Calls the callback `rate` times per second until the returned task is cancelled. The event loop
+        can't wake up more than about a thousand times per second, so the calls that are due are made
+        in batches. Nothing is run if the rate is zero.
+        """
+        if rate <= 0:
+            return None
+
+        async def run():
+            loop = asyncio.get_event_loop()
+            start = loop.time()
+            done = 0
+            while True:
+                due = int((loop.time() - start) * rate) + 1
+                for _ in range(due - done):
+                    callback()
+                done = due
+                await asyncio.sleep(max(start + done / rate - loop.time(), 0.001))
+
+        return asyncio.ensure_future(run())
+
+    def _resolve_services(self, device):
+        if device.connected and not device.services_resolved:
+            device.services_resolved = True
+            device.emit_properties_changed({"ServicesResolved": True})
+
+    def _object_manager_signal(self, member, signature, body):
+        self.bus.send(
+            Message.new_signal(
+                path="/",
+                interface="org.freedesktop.DBus.ObjectManager",
+                member=member,
+                signature=signature,
+                body=body,
+            )
+        )
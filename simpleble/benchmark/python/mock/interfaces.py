@@ -0,0 +1,377 @@
+import asyncio
+import socket
+import struct
+import time
+
+from dbus_next import DBusError, Variant
+from dbus_next.constants import PropertyAccess
+from dbus_next.service import ServiceInterface, dbus_property, method
+
+ADAPTER_PATH = "/org/bluez/hci0"
+SERVICE_UUID = "7e5a0000-5b5f-4a46-9a8e-2d3c5b6e0a10"
+CHARACTERISTIC_UUID = "7e5a0001-5b5f-4a46-9a8e-2d3c5b6e0a10"
+MANUFACTURER_ID = 0xFFFF
+
+
+class MockInterface(ServiceInterface):
+    def properties(self):
+        """
+        Returns the current value of every property, as sent in InterfacesAdded.
+        """
+        return {
+            prop.name: Variant(prop.signature, getattr(self, prop.name))
+            for prop in ServiceInterface._get_properties(self)
+            if not prop.disabled
+        }
+
+
+class AgentManager(MockInterface):
+    def __init__(self):
+        super().__init__("org.bluez.AgentManager1")
+
+    @method()
+    def RegisterAgent(self, agent: "o", capability: "s"):
+        pass
+
+    @method()
+    def UnregisterAgent(self, agent: "o"):
+        pass
+
+    @method()
+    def RequestDefaultAgent(self, agent: "o"):
+        pass
+
+
+class Adapter(MockInterface):
+    def __init__(self, mock):
+        super().__init__("org.bluez.Adapter1")
+        self.mock = mock
+        self.discovering = False
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Address(self) -> "s":
+        return "00:00:00:00:00:00"
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Alias(self) -> "s":
+        return "hci0"
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Powered(self) -> "b":
+        return True
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Discovering(self) -> "b":
+        return self.discovering
+
+    @method()
+    def StartDiscovery(self):
+        if not self.discovering:
+            self.discovering = True
+            self.emit_properties_changed({"Discovering": True})
+            self.mock.advertising_start()
+
+    @method()
+    def StopDiscovery(self):
+        if self.discovering:
+            self.discovering = False
+            self.mock.advertising_stop()
+            self.emit_properties_changed({"Discovering": False})
+
+    @method()
+    def SetDiscoveryFilter(self, properties: "a{sv}"):
+        pass
+
+    @method()
+    def GetDiscoveryFilters(self) -> "as":
+        return ["UUIDs", "RSSI", "Pathloss", "Transport", "DuplicateData", "Discoverable", "Pattern"]
+
+    @method()
+    def RemoveDevice(self, device: "o"):
+        self.mock.device_remove(device)
+
+
+class Device(MockInterface):
+    def __init__(self, mock, index):
+        super().__init__("org.bluez.Device1")
+        self.mock = mock
+        self.address = "00:00:00:00:{:02X}:{:02X}".format((index >> 8) & 0xFF, index & 0xFF)
+        self.path = ADAPTER_PATH + "/dev_" + self.address.replace(":", "_")
+        self.name = "SimpleBLE Mock {}".format(index)
+        self.rssi = -60
+        self.sequence = 0
+        self.connected = False
+        self.services_resolved = False
+        self.gatt = []
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Address(self) -> "s":
+        return self.address
+
+    @dbus_property(access=PropertyAccess.READ)
+    def AddressType(self) -> "s":
+        return "public"
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Name(self) -> "s":
+        return self.name
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Alias(self) -> "s":
+        return self.name
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Adapter(self) -> "o":
+        return ADAPTER_PATH
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Paired(self) -> "b":
+        return False
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Connected(self) -> "b":
+        return self.connected
+
+    @dbus_property(access=PropertyAccess.READ)
+    def ServicesResolved(self) -> "b":
+        return self.services_resolved
+
+    @dbus_property(access=PropertyAccess.READ)
+    def RSSI(self) -> "n":
+        return self.rssi
+
+    @dbus_property(access=PropertyAccess.READ)
+    def ManufacturerData(self) -> "a{qv}":
+        return {MANUFACTURER_ID: Variant("ay", struct.pack("<I", self.sequence))}
+
+    @method()
+    def Connect(self):
+        self.mock.device_connect(self)
+
+    @method()
+    def Disconnect(self):
+        self.mock.device_disconnect(self)
+
+    def advertise(self):
+        """
+        Emits the PropertiesChanged signal BlueZ sends for every received advertisement. The payload
+        changes every time, so that SimpleBLE never discards the update as a duplicate.
+        """
+        self.sequence += 1
+        self.rssi = -60 - self.sequence % 20
+        self.emit_properties_changed({"RSSI": self.rssi, "ManufacturerData": self.ManufacturerData})
+
+
+class Service(MockInterface):
+    def __init__(self, device_path):
+        super().__init__("org.bluez.GattService1")
+        self.device_path = device_path
+        self.path = device_path + "/service0001"
+
+    @dbus_property(access=PropertyAccess.READ)
+    def UUID(self) -> "s":
+        return SERVICE_UUID
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Primary(self) -> "b":
+        return True
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Device(self) -> "o":
+        return self.device_path
+
+
+class Characteristic(MockInterface):
+    def __init__(self, mock, service_path):
+        super().__init__("org.bluez.GattCharacteristic1")
+        self.mock = mock
+        self.service_path = service_path
+        self.path = service_path + "/char0002"
+        self.value = bytes(12)
+        self.sequence = 0
+        self.notifying = False
+        self.stream = None
+
+    @dbus_property(access=PropertyAccess.READ)
+    def UUID(self) -> "s":
+        return CHARACTERISTIC_UUID
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Service(self) -> "o":
+        return self.service_path
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Value(self) -> "ay":
+        return self.value
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Notifying(self) -> "b":
+        return self.notifying
+
+    @dbus_property(access=PropertyAccess.READ)
+    def Flags(self) -> "as":
+        return ["read", "write", "write-without-response", "notify"]
+
+    @method()
+    def ReadValue(self, options: "a{sv}") -> "ay":
+        return self.value
+
+    @method()
+    def WriteValue(self, value: "ay", options: "a{sv}"):
+        self.value = value
+        self.mock.statistics["writes"] += 1
+
+    @method()
+    def StartNotify(self):
+        if not self.notifying:
+            self.notifying = True
+            self.emit_properties_changed({"Notifying": True})
+            self.stream = self.mock.run_at_rate(self.mock.notification_rate, self.notify)
+
+    @method()
+    def StopNotify(self):
+        self.stop()
+        self.emit_properties_changed({"Notifying": False})
+
+    def stop(self):
+        self.notifying = False
+        if self.stream:
+            self.stream.cancel()
+            self.stream = None
+
+    def notify(self):
+        """
+        Notifies a value made of the CLOCK_MONOTONIC timestamp it was sent at, in nanoseconds,
+        followed by a sequence number, both little endian.
+        """
+        self.sequence += 1
+        self.value = struct.pack("<QI", time.monotonic_ns(), self.sequence)
+        self.deliver(self.value)
+        self.mock.statistics["notifications"] += 1
+
+    def deliver(self, value):
+        self.emit_properties_changed({"Value": value})
+
+
+class AcquiringCharacteristic(Characteristic):
+    """
+    Characteristic that also hands out sockets through AcquireNotify and AcquireWrite, as BlueZ does for
+    the characteristics of LE devices. Each packet on a socket is a single value.
+    """
+
+    MTU = 247
+
+    # dbus_next neither takes ownership of the descriptors of a reply nor tells when the reply is out, so the copy
+    # of the mock is closed once it surely is. Until then, the client closing its end goes unnoticed.
+    HAND_OUT_DELAY = 1.0
+
+    def __init__(self, mock, service_path):
+        super().__init__(mock, service_path)
+        self.notify_socket = None
+        self.write_socket = None
+
+    @dbus_property(access=PropertyAccess.READ)
+    def NotifyAcquired(self) -> "b":
+        return self.notify_socket is not None
+
+    @dbus_property(access=PropertyAccess.READ)
+    def WriteAcquired(self) -> "b":
+        return self.write_socket is not None
+
+    @method()
+    def AcquireNotify(self, options: "a{sv}") -> "hq":
+        if self.notifying or self.notify_socket:
+            raise DBusError("org.bluez.Error.NotPermitted", "Notify already acquired")
+
+        self.notify_socket, fd = self._socket_pair(self._notify_readable)
+        self.emit_properties_changed({"NotifyAcquired": True})
+        self.stream = self.mock.run_at_rate(self.mock.notification_rate, self.notify)
+        return [fd, self.MTU]
+
+    @method()
+    def AcquireWrite(self, options: "a{sv}") -> "hq":
+        if self.write_socket:
+            raise DBusError("org.bluez.Error.NotPermitted", "Write already acquired")
+
+        self.write_socket, fd = self._socket_pair(self._write_readable)
+        self.emit_properties_changed({"WriteAcquired": True})
+        return [fd, self.MTU]
+
+    def deliver(self, value):
+        if not self.notify_socket:
+            super().deliver(value)
+            return
+
+        try:
+            self.notify_socket.send(value)
+        except BlockingIOError:
+            pass
+        except OSError:
+            self.release_notify()
+
+    def hang_up(self):
+        """
+        Closes the acquired notify socket from the side of the mock, as BlueZ does when the link goes down
+        under it.
+        """
+        self.release_notify()
+
+    def release_notify(self):
+        if not self.notify_socket:
+            return
+
+        super().stop()
+        self._close(self.notify_socket)
+        self.notify_socket = None
+        self.emit_properties_changed({"NotifyAcquired": False})
+
+    def release_write(self):
+        if not self.write_socket:
+            return
+
+        self._close(self.write_socket)
+        self.write_socket = None
+        self.emit_properties_changed({"WriteAcquired": False})
+
+    def stop(self):
+        super().stop()
+        self.release_notify()
+        self.release_write()
+
+    def _socket_pair(self, on_readable):
+        local, remote = socket.socketpair(socket.AF_UNIX, socket.SOCK_SEQPACKET)
+        local.setblocking(False)
+        loop = asyncio.get_event_loop()
+        loop.add_reader(local.fileno(), on_readable)
+        loop.call_later(self.HAND_OUT_DELAY, remote.close)
+        return local, remote.fileno()
+
+    def _close(self, local):
+        asyncio.get_event_loop().remove_reader(local.fileno())
+        local.close()
+
+    def _notify_readable(self):
+        # Nothing but a hangup is ever expected from the client.
+        try:
+            if self.notify_socket.recv(self.MTU):
+                return
+        except BlockingIOError:
+            return
+        except OSError:
+            pass
+        self.release_notify()
+
+    def _write_readable(self):
+        while True:
+            try:
+                value = self.write_socket.recv(self.MTU)
+            except BlockingIOError:
+                return
+            except OSError:
+                value = b""
+            if not value:
+                self.release_write()
+                return
+
+            self.value = value
+            self.mock.statistics["writes"] += 1
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include <simpleble/Adapter.h>
+
+#include "helpers/BluezMock.h"
+
+#include <exception>
+
+using namespace SimpleBLE;
+
+// Time for connect() to return, which includes waiting for the services to be resolved, with the mock
+// resolving them `delay` milliseconds after the connection. Disconnecting isn't part of the measurement.
+static void BM_ConnectTime(benchmark::State& state) {
+    const auto delay = std::chrono::milliseconds(state.range(0));
+
+    Peripheral peripheral;
+    try {
+        BluezMock::get().set_connection_delay(delay);
+        BluezMock::get().set_advertisers(1, 20.0);
+        Adapter adapter = mock_adapter();
+        peripheral = mock_peripherals(adapter, 1).front();
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+
+    std::chrono::nanoseconds disconnect_time{0};
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            peripheral.connect();
+        } catch (const std::exception& e) {
+            state.SkipWithError(e.what());
+            break;
+        }
+        const auto connected = std::chrono::steady_clock::now();
+        state.SetIterationTime(std::chrono::duration<double>(connected - start).count());
+
+        peripheral.disconnect();
+        disconnect_time += std::chrono::steady_clock::now() - connected;
+    }
+
+    BluezMock::get().set_connection_delay(std::chrono::milliseconds(0));
+    if (state.iterations() > 0) {
+        state.counters["disconnect_ms"] = std::chrono::duration<double, std::milli>(disconnect_time).count() /
+                                          static_cast<double>(state.iterations());
+    }
+}
+BENCHMARK(BM_ConnectTime)->ArgName("delay")->Arg(0)->Arg(50)->UseManualTime()->Unit(benchmark::kMillisecond);
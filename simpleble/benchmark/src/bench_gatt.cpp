@@ -0,0 +1,244 @@
+#include <benchmark/benchmark.h>
+
+#include <simpleble/Adapter.h>
+#include <simpleble/Metrics.h>
+
+#include "helpers/BluezMock.h"
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace SimpleBLE;
+
+namespace {
+
+constexpr double ADVERTISING_RATE = 20.0;
+constexpr auto NOTIFY_WINDOW = std::chrono::milliseconds(100);
+constexpr auto WRITE_SETTLE_TIMEOUT = std::chrono::seconds(1);
+constexpr size_t ASYNC_WINDOW = 64;
+
+const Metrics::Key NOTIFY_LATENCY_KEY{"notify_to_callback", "", ""};
+
+// With `acquire`, the characteristics of the mock hand out sockets through AcquireNotify and AcquireWrite.
+bool connect_peripherals(benchmark::State& state, size_t count, std::vector<Peripheral>& peripherals,
+                         bool acquire = false) {
+    try {
+        BluezMock::get().set_acquire(acquire);
+        BluezMock::get().set_advertisers(static_cast<uint32_t>(count), ADVERTISING_RATE);
+        Adapter adapter = mock_adapter();
+        peripherals = mock_peripherals(adapter, count);
+        for (auto& peripheral : peripherals) {
+            peripheral.connect();
+        }
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return false;
+    }
+    return true;
+}
+
+void disconnect_peripherals(std::vector<Peripheral>& peripherals) {
+    for (auto& peripheral : peripherals) {
+        if (peripheral.is_connected()) {
+            peripheral.disconnect();
+        }
+    }
+}
+
+// The mock stamps every notification with CLOCK_MONOTONIC, which std::chrono::steady_clock also reads on Linux.
+std::chrono::steady_clock::time_point sent_at(const ByteArray& payload) {
+    uint64_t nanoseconds = 0;
+    for (size_t i = 0; i < 8 && i < payload.size(); i++) {
+        nanoseconds |= uint64_t(static_cast<uint8_t>(payload[i])) << (8 * i);
+    }
+    return std::chrono::steady_clock::time_point(std::chrono::nanoseconds(nanoseconds));
+}
+
+double microseconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+}  // namespace
+
+// Time from the moment the mock emits a notification to the moment the callback of the subscription
+// runs, with `streams` peripherals notifying `rate` times per second each, over D-Bus or over acquired sockets.
+static void BM_NotifyLatency(benchmark::State& state) {
+    const auto streams = static_cast<size_t>(state.range(0));
+    const auto rate = static_cast<double>(state.range(1));
+    const bool acquired = state.range(2) != 0;
+
+    std::vector<Peripheral> peripherals;
+    try {
+        BluezMock::get().set_notification_rate(rate);
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+    if (!connect_peripherals(state, streams, peripherals, acquired)) return;
+
+    Metrics::reset();
+    Metrics::set_enabled(true);
+    auto received = std::make_shared<std::atomic<uint64_t>>(0);
+    for (auto& peripheral : peripherals) {
+        peripheral.notify(MOCK_SERVICE_UUID, MOCK_CHARACTERISTIC_UUID, [received](ByteArray payload) {
+            Metrics::record_latency(NOTIFY_LATENCY_KEY, std::chrono::steady_clock::now() - sent_at(payload));
+            (*received)++;
+        });
+    }
+
+    BluezMock::get().reset_statistics();
+    received->store(0);
+    for (auto _ : state) {
+        std::this_thread::sleep_for(NOTIFY_WINDOW);
+    }
+
+    for (auto& peripheral : peripherals) {
+        peripheral.unsubscribe(MOCK_SERVICE_UUID, MOCK_CHARACTERISTIC_UUID);
+    }
+    disconnect_peripherals(peripherals);
+
+    const Metrics::Snapshot snapshot = Metrics::snapshot();
+    Metrics::set_enabled(false);
+    Metrics::reset();
+
+    const uint64_t sent = BluezMock::get().statistics()["notifications"];
+    state.SetItemsProcessed(static_cast<int64_t>(received->load()));
+    state.counters["delivered"] = sent == 0 ? 0.0 : static_cast<double>(received->load()) / static_cast<double>(sent);
+    for (const auto& latency : snapshot.latencies) {
+        if (!(latency.key == NOTIFY_LATENCY_KEY)) continue;
+
+        state.counters["mean_us"] = microseconds(latency.mean());
+        state.counters["p50_us"] = microseconds(latency.percentile(0.5));
+        state.counters["p99_us"] = microseconds(latency.percentile(0.99));
+        state.counters["max_us"] = microseconds(latency.max);
+    }
+}
+BENCHMARK(BM_NotifyLatency)
+    ->ArgNames({"streams", "rate", "acquired"})
+    ->Args({1, 100, 0})
+    ->Args({1, 1000, 0})
+    ->Args({8, 100, 0})
+    ->Args({8, 1000, 0})
+    ->Args({1, 1000, 1})
+    ->Args({8, 1000, 1})
+    ->MinTime(2.0)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Notifications received after the mock hangs up the acquired socket of every subscription halfway through,
+// which the subscriptions have to survive by falling back to StartNotify.
+static void BM_NotifyHangUp(benchmark::State& state) {
+    const auto streams = static_cast<size_t>(state.range(0));
+
+    std::vector<Peripheral> peripherals;
+    try {
+        BluezMock::get().set_notification_rate(100);
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+    if (!connect_peripherals(state, streams, peripherals, true)) return;
+
+    auto received = std::make_shared<std::atomic<uint64_t>>(0);
+    for (auto& peripheral : peripherals) {
+        peripheral.notify(MOCK_SERVICE_UUID, MOCK_CHARACTERISTIC_UUID, [received](ByteArray) { (*received)++; });
+    }
+
+    uint64_t after_hang_up = 0;
+    for (auto _ : state) {
+        std::this_thread::sleep_for(NOTIFY_WINDOW);
+        BluezMock::get().hang_up_notify();
+        const uint64_t before = received->load();
+        std::this_thread::sleep_for(NOTIFY_WINDOW);
+        after_hang_up += received->load() - before;
+    }
+
+    for (auto& peripheral : peripherals) {
+        peripheral.unsubscribe(MOCK_SERVICE_UUID, MOCK_CHARACTERISTIC_UUID);
+    }
+    disconnect_peripherals(peripherals);
+
+    if (after_hang_up == 0) {
+        state.SkipWithError("No notification was received after the acquired sockets were hung up");
+        return;
+    }
+    state.counters["after_hang_up"] = benchmark::Counter(static_cast<double>(after_hang_up),
+                                                         benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_NotifyHangUp)
+    ->ArgName("streams")
+    ->Arg(1)
+    ->Arg(8)
+    ->Iterations(5)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Write requests to a single characteristic, each of them waiting for the reply of the mock.
+static void BM_WriteRequest(benchmark::State& state) {
+    std::vector<Peripheral> peripherals;
+    if (!connect_peripherals(state, 1, peripherals)) return;
+
+    const ByteArray payload(std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5A));
+    for (auto _ : state) {
+        peripherals.front().write_request(MOCK_SERVICE_UUID, MOCK_CHARACTERISTIC_UUID, payload);
+    }
+
+    disconnect_peripherals(peripherals);
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WriteRequest)->ArgName("size")->Arg(20)->Arg(244)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// Write commands to a single characteristic, over D-Bus or over an acquired socket, through write_command
+// or with up to ASYNC_WINDOW calls to write_command_async in flight. Commands don't wait for the mock, so
+// the rate at which they are sent can exceed the rate at which they are received: the delivered fraction
+// tells them apart.
+static void BM_WriteCommand(benchmark::State& state) {
+    std::vector<Peripheral> peripherals;
+    if (!connect_peripherals(state, 1, peripherals, state.range(1) != 0)) return;
+
+    BluezMock::get().reset_statistics();
+    const ByteArray payload(std::vector<uint8_t>(static_cast<size_t>(state.range(0)), 0x5A));
+    const bool async = state.range(2) != 0;
+    std::deque<std::future<void>> in_flight;
+    for (auto _ : state) {
+        if (!async) {
+            peripherals.front().write_command(MOCK_SERVICE_UUID, MOCK_CHARACTERISTIC_UUID, payload);
+            continue;
+        }
+        if (in_flight.size() == ASYNC_WINDOW) {
+            in_flight.front().get();
+            in_flight.pop_front();
+        }
+        in_flight.push_back(peripherals.front().write_command_async(MOCK_SERVICE_UUID, MOCK_CHARACTERISTIC_UUID,
+                                                                    payload));
+    }
+    for (auto& write : in_flight) write.get();
+
+    const auto sent = static_cast<uint64_t>(state.iterations());
+    uint64_t received = 0;
+    const auto deadline = std::chrono::steady_clock::now() + WRITE_SETTLE_TIMEOUT;
+    while ((received = BluezMock::get().statistics()["writes"]) < sent && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    disconnect_peripherals(peripherals);
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    state.counters["delivered"] = static_cast<double>(received) / static_cast<double>(sent);
+}
+BENCHMARK(BM_WriteCommand)
+    ->ArgNames({"size", "acquired", "async"})
+    ->Args({20, 0, 0})
+    ->Args({244, 0, 0})
+    ->Args({20, 1, 0})
+    ->Args({244, 1, 0})
+    ->Args({20, 0, 1})
+    ->Args({20, 1, 1})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include <simplebluez/standard/Adapter.h>
+#include <simpledbus/base/Message.h>
+
+#include <dbus/dbus.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace SimpleDBus;
+
+namespace {
+
+const std::string ADAPTER_PATH = "/org/bluez/hci0";
+constexpr size_t ROUNDS = 16;
+
+std::string device_path(size_t index) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "/dev_00_00_00_00_%02zX_%02zX", (index >> 8) & 0xFF, index & 0xFF);
+    return ADAPTER_PATH + buffer;
+}
+
+Holder device_interfaces(size_t index) {
+    char address[18];
+    std::snprintf(address, sizeof(address), "00:00:00:00:%02zX:%02zX", (index >> 8) & 0xFF, index & 0xFF);
+    Holder device1 = Holder::create(std::map<std::string, Holder>{{"Address", Holder::create<std::string>(address)},
+                                                                   {"RSSI", Holder::create<int16_t>(-90)}});
+    return Holder::create(std::map<std::string, Holder>{{"org.bluez.Device1", device1}});
+}
+
+// PropertiesChanged signal like the ones BlueZ emits for every received advertisement, in its wire format.
+std::vector<char> advertisement_signal(const std::string& path, uint32_t serial, uint8_t payload) {
+    Message msg = Message::create_signal(path, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    msg.append_argument(Holder::create<std::string>("org.bluez.Device1"), "s");
+
+    Holder manufacturer_data = Holder::create<std::map<uint16_t, Holder>>();
+    manufacturer_data.dict_append(Holder::UINT16, uint16_t(0x004C),
+                                  Holder::create(std::vector<uint8_t>{0x02, 0x15, payload, payload, payload}));
+
+    Holder service_data = Holder::create<std::map<std::string, Holder>>();
+    service_data.dict_append(Holder::STRING, std::string("0000feaa-0000-1000-8000-00805f9b34fb"),
+                             Holder::create(std::vector<uint8_t>{0x10, payload}));
+
+    Holder changed = Holder::create<std::map<std::string, Holder>>();
+    changed.dict_append(Holder::STRING, std::string("RSSI"), Holder::create<int16_t>(-60));
+    changed.dict_append(Holder::STRING, std::string("ManufacturerData"), manufacturer_data);
+    changed.dict_append(Holder::STRING, std::string("ServiceData"), service_data);
+    msg.append_argument(changed, "a{sv}");
+    msg.append_argument(Holder::create<std::vector<Holder>>(), "as");
+
+    char* buffer = nullptr;
+    int length = 0;
+    dbus_message_set_serial(msg, serial);
+    dbus_message_marshal(msg, &buffer, &length);
+    std::vector<char> signal(buffer, buffer + length);
+    dbus_free(buffer);
+    return signal;
+}
+
+}  // namespace
+
+// PropertiesChanged signals ingested per second by SimpleBluez, from the bytes read off the bus to the
+// device update callback. The advertising data of each device only changes once every `change_interval`
+// rounds, the remaining signals are duplicates, as in a dense environment. No bus or mock is involved.
+static void BM_ScanIngest(benchmark::State& state) {
+    const auto advertisers = static_cast<size_t>(state.range(0));
+    const auto change_interval = static_cast<size_t>(state.range(1));
+
+    auto adapter = Proxy::create<SimpleBluez::Adapter>(nullptr, "", ADAPTER_PATH);
+    for (size_t i = 0; i < advertisers; i++) {
+        adapter->path_add(device_path(i), device_interfaces(i));
+    }
+    adapter->set_on_device_updated([](std::shared_ptr<SimpleBluez::Device>) {});
+
+    std::vector<std::pair<std::shared_ptr<Proxy>, std::vector<char>>> signals;
+    signals.reserve(advertisers * ROUNDS);
+    for (size_t round = 0; round < ROUNDS; round++) {
+        for (size_t i = 0; i < advertisers; i++) {
+            const uint32_t serial = static_cast<uint32_t>(signals.size() + 1);
+            signals.emplace_back(adapter->path_get(device_path(i)),
+                                 advertisement_signal(device_path(i), serial, uint8_t(round / change_interval)));
+        }
+    }
+
+    for (auto _ : state) {
+        for (const auto& [device, signal] : signals) {
+            Message msg = Message::from_acquired(
+                dbus_message_demarshal(signal.data(), static_cast<int>(signal.size()), nullptr));
+            device->message_handle(msg);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * signals.size()));
+}
+BENCHMARK(BM_ScanIngest)
+    ->ArgNames({"advertisers", "change_interval"})
+    ->Args({1000, 1})
+    ->Args({1000, 4})
+    ->Args({1000, 16})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <simpleble/Adapter.h>
+
+#include "helpers/BluezMock.h"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+
+using namespace SimpleBLE;
+
+namespace {
+
+constexpr auto SCAN_WINDOW = std::chrono::milliseconds(100);
+
+}  // namespace
+
+// Advertisements ingested while the mock floods the bus with `advertisers` devices advertising `rate`
+// times per second each. Once the offered load exceeds what SimpleBLE keeps up with, the delivered
+// fraction drops below one.
+static void BM_ScanThroughput(benchmark::State& state) {
+    const auto advertisers = static_cast<uint32_t>(state.range(0));
+    const auto rate = static_cast<double>(state.range(1));
+
+    Adapter adapter;
+    try {
+        BluezMock::get().set_advertisers(advertisers, rate);
+        adapter = mock_adapter();
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+
+    // The counters are shared with the callbacks, which can still be running when this function returns.
+    auto reports = std::make_shared<std::atomic<uint64_t>>(0);
+    auto updates = std::make_shared<std::atomic<uint64_t>>(0);
+    adapter.set_callback_on_advertisement([reports](const AdvertisementReport&) { (*reports)++; });
+    adapter.set_callback_on_scan_updated([updates](Peripheral) { (*updates)++; });
+
+    BluezMock::get().reset_statistics();
+    adapter.scan_start();
+    for (auto _ : state) {
+        std::this_thread::sleep_for(SCAN_WINDOW);
+    }
+    adapter.scan_stop();
+
+    adapter.set_callback_on_advertisement(nullptr);
+    adapter.set_callback_on_scan_updated([](Peripheral) {});
+
+    const uint64_t sent = BluezMock::get().statistics()["advertisements"];
+    state.SetItemsProcessed(static_cast<int64_t>(reports->load()));
+    state.counters["sent"] = benchmark::Counter(static_cast<double>(sent), benchmark::Counter::kIsRate);
+    state.counters["updates"] = benchmark::Counter(static_cast<double>(updates->load()), benchmark::Counter::kIsRate);
+    state.counters["delivered"] = sent == 0 ? 0.0 : static_cast<double>(reports->load()) / static_cast<double>(sent);
+}
+BENCHMARK(BM_ScanThroughput)
+    ->ArgNames({"advertisers", "rate"})
+    ->Args({1, 1000})
+    ->Args({100, 50})
+    ->Args({1000, 10})
+    ->Args({1000, 100})
+    ->MinTime(2.0)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <simpleble/Types.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "backends/common/ScanFilterMatcher.h"
+
+using namespace SimpleBLE;
+
+namespace {
+
+std::string advertiser_address(size_t index) {
+    char address[18];
+    std::snprintf(address, sizeof(address), "00:00:00:00:%02zX:%02zX", (index >> 8) & 0xFF, index & 0xFF);
+    return address;
+}
+
+// Advertisers with a mix of names, manufacturer data and service data, as found in a crowded environment.
+// Every fourth one is an iBeacon, every third one a named sensor and the rest anonymous.
+std::vector<advertising_data_t> synthetic_advertisers(size_t count) {
+    std::vector<advertising_data_t> advertisers(count);
+    for (size_t i = 0; i < count; i++) {
+        auto& data = advertisers[i];
+        data.mac_address = advertiser_address(i);
+        data.identifier = i % 3 == 0 ? "Sensor-" + std::to_string(i) : "";
+        data.rssi = static_cast<int16_t>(-40 - int(i % 60));
+        data.tx_power = 0;
+
+        ByteArray payload(std::string(23, char(i)));
+        if (i % 4 == 0) {
+            payload[0] = 0x02;
+            payload[1] = 0x15;
+        }
+        data.manufacturer_data[i % 4 == 0 ? 0x004C : uint16_t(0x0100 + i % 16)] = payload;
+        data.service_data["0000feaa-0000-1000-8000-00805f9b34fb"] = ByteArray(std::string(4, char(i)));
+    }
+    return advertisers;
+}
+
+// The matcher runs its cheapest checks first, so the length of the address list decides how many
+// advertisements go on to the manufacturer data masks and the name regex.
+ScanFilter synthetic_filter(size_t advertisers, size_t allowed) {
+    ScanFilter filter;
+    filter.manufacturer_data.push_back({0x004C, ByteArray{0x02, 0x15, 0x00, 0x00}, ByteArray{0xFF, 0xFF, 0x00, 0x00}});
+    filter.manufacturer_data.push_back({0x0105, ByteArray(std::string(8, '\x05')), ByteArray()});
+    filter.name_regex = "^Sensor-[0-9]+$|^$";
+    for (size_t i = 0; i < allowed; i++) {
+        filter.addresses.push_back(advertiser_address(i * advertisers / allowed));
+    }
+    return filter;
+}
+
+}  // namespace
+
+// Advertisements checked per second by the host-side scan filter, with manufacturer data masks, a name
+// regex and an address list of the given length enabled, over a population of synthetic advertisers.
+static void BM_ScanFilterMatch(benchmark::State& state) {
+    const auto advertisers = static_cast<size_t>(state.range(0));
+    const auto allowed = static_cast<size_t>(state.range(1));
+
+    const auto population = synthetic_advertisers(advertisers);
+    const ScanFilterMatcher matcher(synthetic_filter(advertisers, allowed));
+
+    size_t matched = 0;
+    for (auto _ : state) {
+        for (const auto& data : population) {
+            matched += matcher.matches(data);
+        }
+    }
+    benchmark::DoNotOptimize(matched);
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * population.size()));
+    state.counters["matched"] = benchmark::Counter(double(matched) / double(state.iterations() * population.size()));
+}
+BENCHMARK(BM_ScanFilterMatch)
+    ->ArgNames({"advertisers", "addresses"})
+    ->Args({1000, 10})
+    ->Args({1000, 100})
+    ->Args({1000, 1000})
+    ->Unit(benchmark::kMicrosecond);
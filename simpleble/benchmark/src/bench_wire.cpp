@@ -0,0 +1,197 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "backends/dongl/serial/Wire.h"
+#include "backends/dongl/usb/UsbHelperImpl.h"
+
+using namespace SimpleBLE::Dongl;
+
+namespace {
+
+constexpr size_t PACKET_COUNT = 64;
+
+// Stand-in for the USB link that records everything sent through it.
+class CaptureUsbHelper : public USB::UsbHelperImpl {
+  public:
+    CaptureUsbHelper(std::vector<uint8_t>& output) : UsbHelperImpl("capture"), _output(output) {}
+
+    void tx(const uint8_t* data, size_t length) override { _output.insert(_output.end(), data, data + length); }
+
+    void set_rx_callback(std::function<void(const kvn::bytearray&)> callback) override {
+        _rx_callback.load(std::move(callback));
+    }
+
+  private:
+    std::vector<uint8_t>& _output;
+};
+
+std::unique_ptr<Serial::Wire> make_wire(std::vector<uint8_t>& output) {
+    return std::make_unique<Serial::Wire>(std::make_unique<USB::UsbHelper>(std::make_unique<CaptureUsbHelper>(output)));
+}
+
+std::vector<uint8_t> random_bytes(std::mt19937& rng, size_t length) {
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<uint8_t> data(length);
+    for (auto& byte : data) byte = dist(rng);
+    return data;
+}
+
+// Encoded packets of growing sizes, up to the maximum payload, separated by noise without sync bytes.
+std::vector<uint8_t> encoded_stream() {
+    std::mt19937 rng(42);
+    std::vector<uint8_t> stream;
+    auto encoder = make_wire(stream);
+    for (size_t i = 0; i < PACKET_COUNT; i++) {
+        encoder->send_packet(random_bytes(rng, std::min<size_t>(32 + i * 8, Serial::Wire::MAX_PAYLOAD_SIZE)));
+        stream.insert(stream.end(), {0x00, 0x55, 0xFF});
+    }
+    return stream;
+}
+
+// The bit by bit CRC the wire used before it was table driven.
+uint16_t crc16_bitwise(const uint8_t* data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x8005 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+// The parser the wire used before the bulk one: one state transition per byte, the bitwise CRC
+// and a copy of every packet before it is handed over.
+class BaselineParser {
+  public:
+    template <typename Callback>
+    void process(const uint8_t* data, size_t length, Callback&& callback) {
+        for (size_t i = 0; i < length; i++) {
+            process_byte(data[i], callback);
+        }
+    }
+
+  private:
+    template <typename Callback>
+    void process_byte(uint8_t byte, Callback& callback) {
+        switch (_state) {
+            case Serial::Wire::State::IDLE:
+                if (byte == Serial::Wire::SYNC_BYTE) {
+                    _state = Serial::Wire::State::HEADER_LOW;
+                    _buffer_index = 0;
+                }
+                break;
+            case Serial::Wire::State::HEADER_LOW:
+                _length = byte;
+                _state = Serial::Wire::State::HEADER_HIGH;
+                break;
+            case Serial::Wire::State::HEADER_HIGH:
+                _length |= (uint16_t)byte << 8;
+                if (_length > Serial::Wire::MAX_PAYLOAD_SIZE) {
+                    _state = Serial::Wire::State::IDLE;
+                } else {
+                    _state = _length == 0 ? Serial::Wire::State::CHECKSUM_LOW : Serial::Wire::State::PAYLOAD;
+                }
+                break;
+            case Serial::Wire::State::PAYLOAD:
+                _buffer[_buffer_index++] = byte;
+                if (_buffer_index == _length) {
+                    _state = Serial::Wire::State::CHECKSUM_LOW;
+                }
+                break;
+            case Serial::Wire::State::CHECKSUM_LOW:
+                _checksum = byte;
+                _state = Serial::Wire::State::CHECKSUM_HIGH;
+                break;
+            case Serial::Wire::State::CHECKSUM_HIGH:
+                _checksum |= (uint16_t)byte << 8;
+                if (_checksum == crc16_bitwise(_buffer.data(), _length)) {
+                    std::vector<uint8_t> packet(_buffer.begin(), _buffer.begin() + _length);
+                    callback(packet.data(), packet.size());
+                }
+                _state = Serial::Wire::State::IDLE;
+                break;
+        }
+    }
+
+    Serial::Wire::State _state = Serial::Wire::State::IDLE;
+    uint16_t _length = 0;
+    uint16_t _checksum = 0;
+    size_t _buffer_index = 0;
+    std::vector<uint8_t> _buffer = std::vector<uint8_t>(Serial::Wire::MAX_PAYLOAD_SIZE);
+};
+
+}  // namespace
+
+// Baseline for BM_Crc16: the bitwise CRC over a payload of the given length.
+static void BM_Crc16Bitwise(benchmark::State& state) {
+    std::mt19937 rng(42);
+    const auto data = random_bytes(rng, static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc16_bitwise(data.data(), data.size()));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+BENCHMARK(BM_Crc16Bitwise)->ArgNames({"length"})->Arg(64)->Arg(Serial::Wire::MAX_PAYLOAD_SIZE);
+
+// Table driven CRC of the wire over a payload of the given length.
+static void BM_Crc16(benchmark::State& state) {
+    std::mt19937 rng(42);
+    const auto data = random_bytes(rng, static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Serial::Wire::crc16(data.data(), data.size()));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+BENCHMARK(BM_Crc16)->ArgNames({"length"})->Arg(64)->Arg(Serial::Wire::MAX_PAYLOAD_SIZE);
+
+// Baseline for BM_WireProcess: the byte by byte parser, fed the received stream in chunks of the given size.
+static void BM_WireProcessBaseline(benchmark::State& state) {
+    const auto chunk = static_cast<size_t>(state.range(0));
+    const auto stream = encoded_stream();
+
+    BaselineParser parser;
+    size_t packets = 0;
+    auto callback = [&packets](const uint8_t*, size_t) { packets++; };
+
+    for (auto _ : state) {
+        for (size_t offset = 0; offset < stream.size(); offset += chunk) {
+            parser.process(stream.data() + offset, std::min(chunk, stream.size() - offset), callback);
+        }
+    }
+
+    if (packets != state.iterations() * PACKET_COUNT) state.SkipWithError("Packets were lost");
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+}
+BENCHMARK(BM_WireProcessBaseline)->ArgNames({"chunk"})->Arg(1)->Arg(64)->Arg(512)->Arg(4096);
+
+// Received bytes parsed per second by the wire, fed in chunks of the given size. A chunk of one byte
+// takes the byte by byte path only, larger ones deliver the frames they contain in place.
+static void BM_WireProcess(benchmark::State& state) {
+    const auto chunk = static_cast<size_t>(state.range(0));
+    const auto stream = encoded_stream();
+
+    std::vector<uint8_t> sent;
+    auto wire = make_wire(sent);
+    size_t packets = 0;
+    wire->set_packet_callback([&packets](const uint8_t*, size_t) { packets++; });
+
+    for (auto _ : state) {
+        for (size_t offset = 0; offset < stream.size(); offset += chunk) {
+            wire->process(stream.data() + offset, std::min(chunk, stream.size() - offset));
+        }
+    }
+
+    if (packets != state.iterations() * PACKET_COUNT) state.SkipWithError("Packets were lost");
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+}
+BENCHMARK(BM_WireProcess)->ArgNames({"chunk"})->Arg(1)->Arg(64)->Arg(512)->Arg(4096);
@@ -0,0 +1,144 @@
+#include "BluezMock.h"
+
+#include <cstdarg>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const char* const BUS_NAME = "org.bluez";
+const char* const CONTROL_PATH = "/org/bluez";
+const char* const CONTROL_INTERFACE = "org.simpleble.BluezMock1";
+const char* const PERIPHERAL_NAME_PREFIX = "SimpleBLE Mock";
+
+constexpr int REPLY_TIMEOUT_MS = 5000;
+constexpr auto DISCOVERY_TIMEOUT = std::chrono::seconds(10);
+
+}  // namespace
+
+const char* const MOCK_SERVICE_UUID = "7e5a0000-5b5f-4a46-9a8e-2d3c5b6e0a10";
+const char* const MOCK_CHARACTERISTIC_UUID = "7e5a0001-5b5f-4a46-9a8e-2d3c5b6e0a10";
+
+BluezMock& BluezMock::get() {
+    static BluezMock instance;
+    return instance;
+}
+
+BluezMock::BluezMock() {
+    DBusError err;
+    dbus_error_init(&err);
+    _conn = dbus_bus_get_private(DBUS_BUS_SESSION, &err);
+    if (dbus_error_is_set(&err)) {
+        std::string message = err.message;
+        dbus_error_free(&err);
+        throw std::runtime_error("Failed to connect to the session bus: " + message);
+    }
+}
+
+BluezMock::~BluezMock() {
+    if (_conn) {
+        dbus_connection_close(_conn);
+        dbus_connection_unref(_conn);
+    }
+}
+
+void BluezMock::set_advertisers(uint32_t count, double rate) {
+    dbus_message_unref(_call("SetAdvertisers", DBUS_TYPE_UINT32, &count, DBUS_TYPE_DOUBLE, &rate, DBUS_TYPE_INVALID));
+}
+
+void BluezMock::set_notification_rate(double rate) {
+    dbus_message_unref(_call("SetNotificationRate", DBUS_TYPE_DOUBLE, &rate, DBUS_TYPE_INVALID));
+}
+
+void BluezMock::set_connection_delay(std::chrono::milliseconds delay) {
+    double seconds = std::chrono::duration<double>(delay).count();
+    dbus_message_unref(_call("SetConnectionDelay", DBUS_TYPE_DOUBLE, &seconds, DBUS_TYPE_INVALID));
+}
+
+void BluezMock::set_acquire(bool enabled) {
+    dbus_bool_t value = enabled ? TRUE : FALSE;
+    dbus_message_unref(_call("SetAcquire", DBUS_TYPE_BOOLEAN, &value, DBUS_TYPE_INVALID));
+}
+
+void BluezMock::hang_up_notify() { dbus_message_unref(_call("HangUpNotify", DBUS_TYPE_INVALID)); }
+
+std::map<std::string, uint64_t> BluezMock::statistics() {
+    DBusMessage* reply = _call("GetStatistics", DBUS_TYPE_INVALID);
+
+    std::map<std::string, uint64_t> result;
+    DBusMessageIter array;
+    DBusMessageIter entry;
+    if (dbus_message_iter_init(reply, &array) && dbus_message_iter_get_arg_type(&array) == DBUS_TYPE_ARRAY) {
+        dbus_message_iter_recurse(&array, &entry);
+        while (dbus_message_iter_get_arg_type(&entry) == DBUS_TYPE_DICT_ENTRY) {
+            DBusMessageIter field;
+            const char* name = nullptr;
+            dbus_uint64_t value = 0;
+            dbus_message_iter_recurse(&entry, &field);
+            dbus_message_iter_get_basic(&field, &name);
+            dbus_message_iter_next(&field);
+            dbus_message_iter_get_basic(&field, &value);
+            result[name] = value;
+            dbus_message_iter_next(&entry);
+        }
+    }
+
+    dbus_message_unref(reply);
+    return result;
+}
+
+void BluezMock::reset_statistics() { dbus_message_unref(_call("ResetStatistics", DBUS_TYPE_INVALID)); }
+
+DBusMessage* BluezMock::_call(const char* method, int first_argument_type, ...) {
+    DBusMessage* msg = dbus_message_new_method_call(BUS_NAME, CONTROL_PATH, CONTROL_INTERFACE, method);
+
+    va_list arguments;
+    va_start(arguments, first_argument_type);
+    dbus_message_append_args_valist(msg, first_argument_type, arguments);
+    va_end(arguments);
+
+    DBusError err;
+    dbus_error_init(&err);
+    DBusMessage* reply = dbus_connection_send_with_reply_and_block(_conn, msg, REPLY_TIMEOUT_MS, &err);
+    dbus_message_unref(msg);
+    if (dbus_error_is_set(&err)) {
+        std::string message = std::string(method) + " failed: " + err.message;
+        dbus_error_free(&err);
+        throw std::runtime_error(message);
+    }
+
+    return reply;
+}
+
+SimpleBLE::Adapter mock_adapter() {
+    auto adapters = SimpleBLE::Adapter::get_adapters();
+    if (adapters.empty()) {
+        throw std::runtime_error("No adapter found, is the mock running?");
+    }
+    return adapters.front();
+}
+
+std::vector<SimpleBLE::Peripheral> mock_peripherals(SimpleBLE::Adapter& adapter, size_t count) {
+    std::vector<SimpleBLE::Peripheral> peripherals;
+
+    const auto deadline = std::chrono::steady_clock::now() + DISCOVERY_TIMEOUT;
+    adapter.scan_start();
+    while (peripherals.size() < count && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        peripherals.clear();
+        for (auto& peripheral : adapter.scan_get_results()) {
+            if (peripheral.identifier().rfind(PERIPHERAL_NAME_PREFIX, 0) == 0) {
+                peripherals.push_back(peripheral);
+            }
+        }
+    }
+    adapter.scan_stop();
+
+    if (peripherals.size() < count) {
+        throw std::runtime_error("Only found " + std::to_string(peripherals.size()) + " of " +
+                                 std::to_string(count) + " peripherals");
+    }
+    peripherals.resize(count);
+    return peripherals;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <simpleble/Adapter.h>
+#include <simpleble/Peripheral.h>
+
+#include <dbus/dbus.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Client for the control interface of the fake BlueZ service run by bluez_mock.py.
+class BluezMock {
+  public:
+    static BluezMock& get();
+
+    // Replaces the advertisers, each of them advertising `rate` times per second while scanning.
+    void set_advertisers(uint32_t count, double rate);
+    // Rate at which every subscribed characteristic notifies, applied to the next subscriptions.
+    void set_notification_rate(double rate);
+    // Time between a connection and the resolution of its services.
+    void set_connection_delay(std::chrono::milliseconds delay);
+    // Whether the characteristics of the next connections hand out sockets through AcquireNotify and AcquireWrite.
+    void set_acquire(bool enabled);
+    // Closes every acquired notify socket from the side of the mock, as BlueZ does when it drops one.
+    void hang_up_notify();
+
+    // Advertisements, notifications, writes and connections handled by the mock so far.
+    std::map<std::string, uint64_t> statistics();
+    void reset_statistics();
+
+    BluezMock(const BluezMock&) = delete;
+    BluezMock& operator=(const BluezMock&) = delete;
+
+  private:
+    BluezMock();
+    ~BluezMock();
+
+    DBusMessage* _call(const char* method, int first_argument_type, ...);
+
+    DBusConnection* _conn = nullptr;
+};
+
+// Characteristic exposed by every peripheral of the mock once connected.
+extern const char* const MOCK_SERVICE_UUID;
+extern const char* const MOCK_CHARACTERISTIC_UUID;
+
+// Adapter of the mock, throwing if SimpleBLE can't see it.
+SimpleBLE::Adapter mock_adapter();
+
+// Scans until at least `count` peripherals of the mock have been seen.
+std::vector<SimpleBLE::Peripheral> mock_peripherals(SimpleBLE::Adapter& adapter, size_t count);
@@ -0,0 +1,24 @@
+#include <benchmark/benchmark.h>
+#include <simpleble/Config.h>
+
+#include "pythonrunner/PythonRunner.h"
+
+int main(int argc, char** argv) {
+    // The mock claims org.bluez on the session bus, so it has to be running before the backend starts.
+    SimpleBLE::Config::SimpleBluez::use_system_bus = false;
+
+    PythonRunner runner("bluez_mock.py");
+    runner.init();
+
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        runner.uninit();
+        return 1;
+    }
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+
+    runner.uninit();
+
+    return 0;
+}
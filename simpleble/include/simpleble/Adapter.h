@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
@@ -64,11 +65,55 @@ class SIMPLEBLE_EXPORT Adapter {
     bool scan_is_active();
     std::vector<Peripheral> scan_get_results();
 
+    /**
+     * Restrict the peripherals reported by subsequent scans.
+     *
+     * On Linux the filter is handed to BlueZ, so that advertisers that don't match never
+     * reach the application. Other backends, and the criteria BlueZ can't apply, check each
+     * advertisement before creating a peripheral for it. Passing a default-constructed filter
+     * removes any filtering.
+     *
+     * @throws std::invalid_argument if any of the service UUIDs or the name regex is not valid,
+     *         or if a manufacturer data mask doesn't have the same length as its data.
+     */
+    void set_scan_filter(const ScanFilter& filter);
+    ScanFilter scan_filter();
+
     void set_callback_on_scan_start(std::function<void()> on_scan_start);
     void set_callback_on_scan_stop(std::function<void()> on_scan_stop);
     void set_callback_on_scan_updated(std::function<void(Peripheral)> on_scan_updated);
     void set_callback_on_scan_found(std::function<void(Peripheral)> on_scan_found);
 
+    /**
+     * Receive scan results in batches instead of one callback per advertisement.
+     *
+     * Found and updated peripherals are coalesced per peripheral over the given
+     * interval, and delivered from a dedicated thread so that the backend is never
+     * blocked by user code. This can be combined with the regular scan callbacks.
+     *
+     * Passing an empty callback disables batching.
+     */
+    void set_callback_on_scan_batch(std::function<void(std::vector<Peripheral>)> on_scan_batch,
+                                    std::chrono::milliseconds interval = std::chrono::milliseconds(50));
+
+    /**
+     * Receive every advertisement individually, as it arrives.
+     *
+     * Reports are copies of the advertisement that passed the scan filter, stamped with a monotonic
+     * host timestamp, and are delivered without creating or updating any Peripheral. They are
+     * delivered from the thread of the backend, so the callback should return quickly.
+     *
+     * NOTE: This is currently only supported by the Linux, Dongl and Plain backends.
+     *
+     * NOTE: BlueZ doesn't expose individual advertisements. On Linux, each report is sent when BlueZ
+     *       updates the device and holds its cached state, merged from every advertisement and scan
+     *       response received so far, so fields missing from the latest advertisement keep their
+     *       previous value.
+     *
+     * Passing an empty callback disables the reports.
+     */
+    void set_callback_on_advertisement(std::function<void(const AdvertisementReport&)> on_advertisement);
+
     /**
      * Retrieve a list of all paired peripherals.
      *
@@ -4,6 +4,7 @@
 
 #include <simpleble/Adapter.h>
 #include <simpleble/PeripheralSafe.h>
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -34,10 +35,16 @@ class SIMPLEBLE_EXPORT Adapter {
     std::optional<bool> scan_is_active() noexcept;
     std::optional<std::vector<SimpleBLE::Safe::Peripheral>> scan_get_results() noexcept;
 
+    bool set_scan_filter(const ScanFilter& filter) noexcept;
+    std::optional<ScanFilter> scan_filter() noexcept;
+
     bool set_callback_on_scan_start(std::function<void()> on_scan_start) noexcept;
     bool set_callback_on_scan_stop(std::function<void()> on_scan_stop) noexcept;
     bool set_callback_on_scan_updated(std::function<void(SimpleBLE::Safe::Peripheral)> on_scan_updated) noexcept;
     bool set_callback_on_scan_found(std::function<void(SimpleBLE::Safe::Peripheral)> on_scan_found) noexcept;
+    bool set_callback_on_scan_batch(std::function<void(std::vector<SimpleBLE::Safe::Peripheral>)> on_scan_batch,
+                                    std::chrono::milliseconds interval = std::chrono::milliseconds(50)) noexcept;
+    bool set_callback_on_advertisement(std::function<void(const AdvertisementReport&)> on_advertisement) noexcept;
 
     std::optional<std::vector<SimpleBLE::Safe::Peripheral>> get_paired_peripherals() noexcept;
 
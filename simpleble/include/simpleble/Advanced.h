@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <string>
@@ -138,6 +140,22 @@ void SIMPLEBLE_EXPORT set_context(jobject context);
 #endif
 
 #if defined(__linux__) && !defined(__ANDROID__)
-namespace SimpleBLE::Advanced::Linux {}
+namespace SimpleBLE::Advanced::Linux {
+
+struct PeripheralCacheStats {
+    size_t cached = 0;    // Peripherals currently held by the adapter.
+    size_t seen = 0;      // Peripherals reported by the current scan.
+    uint64_t evicted = 0; // Peripherals evicted since the adapter was created.
+};
+
+/**
+ * Retrieve the size of the peripheral cache of an adapter.
+ *
+ * The cache is bounded by Config::SimpleBluez::peripheral_cache_max_entries and
+ * Config::SimpleBluez::peripheral_cache_ttl.
+ */
+PeripheralCacheStats SIMPLEBLE_EXPORT peripheral_cache_stats(Adapter& adapter);
+
+}  // namespace SimpleBLE::Advanced::Linux
 
 #endif
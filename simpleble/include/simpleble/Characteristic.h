@@ -23,6 +23,12 @@ class SIMPLEBLE_EXPORT Characteristic {
     std::vector<Descriptor> descriptors();
     std::vector<std::string> capabilities();
 
+    /**
+     * Properties of the characteristic as a bitmask of CharacteristicProperty values,
+     * including the extended properties not covered by the can_* helpers.
+     */
+    CharacteristicProperties properties();
+
     bool can_read();
     bool can_write_request();
     bool can_write_command();
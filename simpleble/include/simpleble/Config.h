@@ -1,5 +1,6 @@
 #pragma once
 #include <chrono>
+#include <cstddef>
 #include <simpleble/export.h>
 
 //clang-format off
@@ -17,10 +18,24 @@ namespace SimpleBluez {
     extern SIMPLEBLE_EXPORT std::chrono::steady_clock::duration connection_timeout;
     extern SIMPLEBLE_EXPORT std::chrono::steady_clock::duration disconnection_timeout;
 
+    /**
+     * Maximum number of peripherals kept by each adapter, 0 for no limit.
+     *
+     * Once exceeded, the least recently seen peripherals are evicted and removed from BlueZ.
+     * Peripherals that are connected, paired or still referenced by the user are never evicted.
+     */
+    extern SIMPLEBLE_EXPORT size_t peripheral_cache_max_entries;
+    /**
+     * Time after which a peripheral that hasn't been seen is evicted, 0 to keep peripherals indefinitely.
+     */
+    extern SIMPLEBLE_EXPORT std::chrono::steady_clock::duration peripheral_cache_ttl;
+
     static void reset() {
         use_system_bus = true;
         connection_timeout = std::chrono::seconds(2);
         disconnection_timeout = std::chrono::seconds(1);
+        peripheral_cache_max_entries = 0;
+        peripheral_cache_ttl = std::chrono::steady_clock::duration::zero();
     }
 }  // namespace SimpleBluez
 
@@ -63,7 +78,28 @@ namespace Dongl {
 }  // namespace Dongl
 
 namespace Base {
+    /**
+     * Number of threads delivering the notifications of subscriptions with queued delivery.
+     *
+     * The threads are started along with the first such subscription, and shared by all peripherals.
+     */
+    extern SIMPLEBLE_EXPORT size_t notification_workers;
+
+    /**
+     * Number of threads running the operations of the non-blocking Peripheral methods, on backends
+     * that can't issue them natively.
+     *
+     * The threads are started along with the first such operation, and shared by all peripherals.
+     */
+    extern SIMPLEBLE_EXPORT size_t async_workers;
+
+    static void reset() {
+        notification_workers = 1;
+        async_workers = 2;
+    }
+
     static void reset_all() {
+        reset();
         SimpleBluez::reset();
         WinRT::reset();
         CoreBluetooth::reset();
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <mutex>
+#include <memory>
 #include <string>
 
 #include <simpleble/export.h>
@@ -31,6 +33,8 @@ using Callback = std::function<void(
     const std::string& message)>;
 // clang-format on
 
+class AsyncSink;
+
 class SIMPLEBLE_EXPORT Logger {
   public:
     static Logger* get();
@@ -38,6 +42,15 @@ class SIMPLEBLE_EXPORT Logger {
     void set_level(Level level);
     Level get_level();
 
+    // Cheap check meant to be done before formatting a message, as messages above the level are dropped anyway.
+    bool should_log(Level level) const { return level <= level_.load(std::memory_order_relaxed); }
+
+    /**
+     * Sets the function receiving the log messages.
+     *
+     * The callback is not serialized by the logger: when messages are logged from several threads, it can be
+     * invoked concurrently unless the asynchronous sink is enabled.
+     */
     void set_callback(Callback callback);
     bool has_callback();
 
@@ -45,6 +58,20 @@ class SIMPLEBLE_EXPORT Logger {
     void log_default_file();
     void log_default_file(const std::string path);
 
+    /**
+     * Hands the messages over to a dedicated writer thread, through a bounded ring of `capacity` messages,
+     * so that logging never waits on the callback. Messages logged while the ring is full are dropped and
+     * counted. Disabling it delivers the messages still queued before returning.
+     */
+    void set_async(bool enabled, size_t capacity = 4096);
+    bool is_async();
+
+    // Waits until the messages queued so far by the asynchronous sink have been delivered.
+    void flush();
+
+    // Messages dropped by the asynchronous sink because its ring was full.
+    uint64_t dropped();
+
     // clang-format off
     void log(
         Level level,
@@ -56,6 +83,8 @@ class SIMPLEBLE_EXPORT Logger {
     // clang-format on
 
   private:
+    friend class AsyncSink;
+
     Logger();
     ~Logger();
     Logger(Logger& other) = delete;          // Remove copy constructor
@@ -63,9 +92,16 @@ class SIMPLEBLE_EXPORT Logger {
 
     static std::string level_to_str(Level level);
 
-    Level level_{Level::Info};
-    Callback callback_{nullptr};
-    std::recursive_mutex mutex_;
+    void _deliver(Level level, const std::string& module, const std::string& file, uint32_t line,
+                  const std::string& function, const std::string& message);
+
+    std::atomic<Level> level_{Level::Info};
+
+    // Swapped as a whole through std::atomic_load and std::atomic_store, so that logging never takes a lock.
+    std::shared_ptr<const Callback> callback_;
+    std::shared_ptr<AsyncSink> async_sink_;
+
+    std::atomic<uint64_t> dropped_{0};
 };
 
 }  // namespace Logging
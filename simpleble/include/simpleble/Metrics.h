@@ -0,0 +1,134 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <simpleble/export.h>
+
+namespace SimpleBLE {
+
+/**
+ * Counters and latency histograms of the operations done by SimpleBLE.
+ *
+ * Nothing is recorded until metrics are enabled. Samples are keyed by operation, adapter and peripheral,
+ * and the adapter or the peripheral is left empty when it doesn't apply or the backend can't tell it.
+ * Recording through a Series only takes atomic operations, while recording by key looks the series of
+ * the key up first.
+ */
+namespace Metrics {
+
+struct SIMPLEBLE_EXPORT Key {
+    std::string operation;
+    std::string adapter;
+    std::string peripheral;
+
+    bool operator<(const Key& other) const;
+    bool operator==(const Key& other) const;
+};
+
+struct SIMPLEBLE_EXPORT Counter {
+    Key key;
+    uint64_t value = 0;
+};
+
+/**
+ * Distribution of the latencies of an operation.
+ *
+ * Latencies are counted in logarithmic buckets split in 16 linear sub-buckets, so that any percentile is
+ * within 1/16th of the real value whatever its magnitude.
+ */
+struct SIMPLEBLE_EXPORT Latency {
+    Key key;
+    uint64_t count = 0;
+    std::chrono::nanoseconds min{0};
+    std::chrono::nanoseconds max{0};
+    std::chrono::nanoseconds total{0};
+
+    // Non-empty buckets as their highest latency and count, in increasing order.
+    std::vector<std::pair<std::chrono::nanoseconds, uint64_t>> buckets;
+
+    std::chrono::nanoseconds mean() const;
+
+    // Latency under which the given fraction of the samples falls, from 0.0 to 1.0.
+    std::chrono::nanoseconds percentile(double fraction) const;
+};
+
+struct SIMPLEBLE_EXPORT Snapshot {
+    std::vector<Counter> counters;
+    std::vector<Latency> latencies;
+};
+
+SIMPLEBLE_EXPORT void set_enabled(bool enabled);
+SIMPLEBLE_EXPORT bool is_enabled();
+
+SIMPLEBLE_EXPORT void increment(const Key& key, uint64_t amount = 1);
+SIMPLEBLE_EXPORT void record_latency(const Key& key, std::chrono::nanoseconds latency);
+
+SIMPLEBLE_EXPORT Snapshot snapshot();
+
+// Clears every counter, latency and trace event recorded so far. Series handed out keep working.
+SIMPLEBLE_EXPORT void reset();
+
+// Snapshot as a JSON document, with the 50th, 90th, 99th and 99.9th percentiles of each latency.
+SIMPLEBLE_EXPORT std::string export_json();
+
+/**
+ * Records every timed operation as a trace event, keeping up to `capacity` of them.
+ *
+ * Tracing only happens while metrics are enabled. Events beyond the capacity are dropped.
+ */
+SIMPLEBLE_EXPORT void set_tracing(bool enabled, size_t capacity = 65536);
+SIMPLEBLE_EXPORT bool is_tracing();
+
+// Trace events in the Chrome trace event format, which can be opened with Perfetto or chrome://tracing.
+SIMPLEBLE_EXPORT std::string export_trace();
+
+/**
+ * Counter and latency histogram of a key, looked up once for all the samples recorded through it.
+ *
+ * Copies share the same series. Series that were created but never recorded into are left out of snapshots.
+ */
+class SIMPLEBLE_EXPORT Series {
+  public:
+    explicit Series(Key key);
+
+    const Key& key() const;
+
+    void increment(uint64_t amount = 1);
+    void record_latency(std::chrono::nanoseconds latency);
+
+  private:
+    struct State;
+    std::shared_ptr<State> _state;
+};
+
+/**
+ * Records the time elapsed between its construction and its destruction as a latency of its series,
+ * and as a trace event when tracing.
+ *
+ * Nothing is recorded if the timer is destroyed by an exception, so that failed operations don't skew
+ * the latencies. Counting them is left to the caller.
+ */
+class SIMPLEBLE_EXPORT Timer {
+  public:
+    explicit Timer(Key key);
+    explicit Timer(Series series);
+    ~Timer();
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+  private:
+    Series _series;
+    std::chrono::steady_clock::time_point _start;
+    int _uncaught_exceptions;
+};
+
+}  // namespace Metrics
+
+}  // namespace SimpleBLE
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
@@ -53,6 +54,18 @@ class SIMPLEBLE_EXPORT Peripheral {
      *       that were advertised by the device.
      */
     std::vector<Service> services();
+
+    /**
+     * @brief Number of services that services() would return.
+     */
+    size_t services_count();
+
+    /**
+     * @brief Provides the service at the given position of services().
+     *
+     * @throws std::out_of_range if the index is not smaller than services_count().
+     */
+    Service service(size_t index);
     std::map<uint16_t, ByteArray> manufacturer_data();
 
     /* Calling any of the methods below when the device is not connected will throw
@@ -69,6 +82,39 @@ class SIMPLEBLE_EXPORT Peripheral {
     void write(BluetoothUUID const& service, BluetoothUUID const& characteristic, BluetoothUUID const& descriptor, ByteArray const& data);
     // clang-format on
 
+    /**
+     * @brief Subscribe with the given delivery mode, see NotificationDelivery.
+     *
+     * Subscribing again or unsubscribing stops the queued delivery of the previous subscription,
+     * discarding the payloads it still had queued.
+     */
+    void notify(BluetoothUUID const& service, BluetoothUUID const& characteristic,
+                std::function<void(ByteArray payload)> callback, const NotificationDelivery& delivery);
+    void indicate(BluetoothUUID const& service, BluetoothUUID const& characteristic,
+                  std::function<void(ByteArray payload)> callback, const NotificationDelivery& delivery);
+
+    /**
+     * @brief Counters of the queued delivery of a subscription, all zero if it doesn't use one.
+     */
+    NotificationStats notification_stats(BluetoothUUID const& service, BluetoothUUID const& characteristic);
+
+    /**
+     * @brief Non-blocking variants of read, write_request and write_command.
+     *
+     * The operation is issued right away and its outcome, including any exception the
+     * blocking call would have thrown, is delivered through the returned future. Many
+     * operations can be in flight at once, across any number of peripherals.
+     *
+     * @note Exception::NotConnected is thrown immediately. Whether other errors, such as an
+     *       unknown characteristic, are thrown immediately or delivered through the future
+     *       depends on the backend.
+     */
+    // clang-format off
+    std::future<ByteArray> read_async(BluetoothUUID const& service, BluetoothUUID const& characteristic);
+    std::future<void> write_request_async(BluetoothUUID const& service, BluetoothUUID const& characteristic, ByteArray const& data);
+    std::future<void> write_command_async(BluetoothUUID const& service, BluetoothUUID const& characteristic, ByteArray const& data);
+    // clang-format on
+
     void set_callback_on_connected(std::function<void()> on_connected);
     void set_callback_on_disconnected(std::function<void()> on_disconnected);
 
@@ -1,7 +1,15 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "kvn/kvn_bytearray.h"
 
@@ -18,12 +26,252 @@ using BluetoothAddress = std::string;
 // returns the same string, but provides a homogeneous interface.
 using BluetoothUUID = std::string;
 
+/**
+ * @brief Binary representation of a Bluetooth UUID.
+ *
+ * Holds the 128 bits of a UUID in the order in which they are written, so that UUIDs can be
+ * compared and hashed without going through strings. Short 16 and 32-bit UUIDs are expanded
+ * over the Bluetooth SIG base UUID (0000xxxx-0000-1000-8000-00805f9b34fb).
+ *
+ * Conversion to and from BluetoothUUID is lossless: to_string() produces the canonical
+ * lowercase form, which parses back into the same value.
+ */
+class BluetoothUUID128 {
+  public:
+    using Bytes = std::array<uint8_t, 16>;
+
+    constexpr BluetoothUUID128() = default;
+    constexpr explicit BluetoothUUID128(const Bytes& bytes) : _bytes(bytes) {}
+
+    /**
+     * @brief Parses a UUID in its canonical 36 character form or in its 4 or 8 character short form.
+     *
+     * @throws std::invalid_argument if the string is not a valid UUID.
+     */
+    constexpr explicit BluetoothUUID128(std::string_view uuid) : _bytes(_parse_or_throw(uuid)) {}
+
+    /**
+     * @brief Parses a UUID without throwing.
+     */
+    static constexpr std::optional<BluetoothUUID128> parse(std::string_view uuid) noexcept {
+        if (uuid.size() == 4 || uuid.size() == 8) {
+            uint32_t value = 0;
+            for (char c : uuid) {
+                const int nibble = _hex_value(c);
+                if (nibble < 0) return std::nullopt;
+                value = (value << 4) | static_cast<uint32_t>(nibble);
+            }
+            return from_uuid32(value);
+        }
+
+        if (uuid.size() != 36) return std::nullopt;
+
+        Bytes bytes{};
+        size_t index = 0;
+        for (size_t i = 0; i < uuid.size();) {
+            if (i == 8 || i == 13 || i == 18 || i == 23) {
+                if (uuid[i] != '-') return std::nullopt;
+                i++;
+                continue;
+            }
+
+            const int high = _hex_value(uuid[i]);
+            const int low = _hex_value(uuid[i + 1]);
+            if (high < 0 || low < 0) return std::nullopt;
+            bytes[index++] = static_cast<uint8_t>((high << 4) | low);
+            i += 2;
+        }
+        return BluetoothUUID128(bytes);
+    }
+
+    static constexpr BluetoothUUID128 from_uuid16(uint16_t uuid16) noexcept { return from_uuid32(uuid16); }
+
+    static constexpr BluetoothUUID128 from_uuid32(uint32_t uuid32) noexcept {
+        Bytes bytes = SIG_BASE;
+        bytes[0] = static_cast<uint8_t>(uuid32 >> 24);
+        bytes[1] = static_cast<uint8_t>(uuid32 >> 16);
+        bytes[2] = static_cast<uint8_t>(uuid32 >> 8);
+        bytes[3] = static_cast<uint8_t>(uuid32);
+        return BluetoothUUID128(bytes);
+    }
+
+    constexpr const Bytes& bytes() const noexcept { return _bytes; }
+
+    constexpr bool is_nil() const noexcept { return *this == BluetoothUUID128(); }
+
+    /**
+     * @brief Whether the UUID is derived from the Bluetooth SIG base UUID.
+     */
+    constexpr bool is_sig() const noexcept {
+        for (size_t i = 4; i < _bytes.size(); i++) {
+            if (_bytes[i] != SIG_BASE[i]) return false;
+        }
+        return true;
+    }
+
+    constexpr std::optional<uint16_t> uuid16() const noexcept {
+        if (!is_sig() || _bytes[0] != 0 || _bytes[1] != 0) return std::nullopt;
+        return static_cast<uint16_t>((_bytes[2] << 8) | _bytes[3]);
+    }
+
+    constexpr std::optional<uint32_t> uuid32() const noexcept {
+        if (!is_sig()) return std::nullopt;
+        return (static_cast<uint32_t>(_bytes[0]) << 24) | (static_cast<uint32_t>(_bytes[1]) << 16) |
+               (static_cast<uint32_t>(_bytes[2]) << 8) | static_cast<uint32_t>(_bytes[3]);
+    }
+
+    /**
+     * @brief Canonical lowercase form, e.g. 0000180f-0000-1000-8000-00805f9b34fb.
+     */
+    std::string to_string() const {
+        constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+        std::string uuid(36, '-');
+        size_t position = 0;
+        for (size_t i = 0; i < _bytes.size(); i++) {
+            if (i == 4 || i == 6 || i == 8 || i == 10) position++;
+            uuid[position++] = HEX_DIGITS[_bytes[i] >> 4];
+            uuid[position++] = HEX_DIGITS[_bytes[i] & 0x0F];
+        }
+        return uuid;
+    }
+
+    operator BluetoothUUID() const { return to_string(); }
+
+    size_t hash() const noexcept {
+        uint64_t high = 0;
+        uint64_t low = 0;
+        for (size_t i = 0; i < 8; i++) {
+            high = (high << 8) | _bytes[i];
+            low = (low << 8) | _bytes[i + 8];
+        }
+        // SIG based UUIDs only differ in the high half, so it's mixed in after scrambling the low one.
+        return static_cast<size_t>(high ^ (low * 0x9E3779B97F4A7C15ULL + (high << 6) + (high >> 2)));
+    }
+
+    friend constexpr bool operator==(const BluetoothUUID128& lhs, const BluetoothUUID128& rhs) noexcept {
+        for (size_t i = 0; i < lhs._bytes.size(); i++) {
+            if (lhs._bytes[i] != rhs._bytes[i]) return false;
+        }
+        return true;
+    }
+
+    friend constexpr bool operator!=(const BluetoothUUID128& lhs, const BluetoothUUID128& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const BluetoothUUID128& lhs, const BluetoothUUID128& rhs) noexcept {
+        for (size_t i = 0; i < lhs._bytes.size(); i++) {
+            if (lhs._bytes[i] != rhs._bytes[i]) return lhs._bytes[i] < rhs._bytes[i];
+        }
+        return false;
+    }
+
+  private:
+    static constexpr Bytes SIG_BASE = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+                                       0x80, 0x00, 0x00, 0x80, 0x5F, 0x9B, 0x34, 0xFB};
+
+    static constexpr int _hex_value(char c) noexcept {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    static constexpr Bytes _parse_or_throw(std::string_view uuid) {
+        auto parsed = parse(uuid);
+        if (!parsed) {
+            throw std::invalid_argument("Invalid Bluetooth UUID: " + std::string(uuid));
+        }
+        return parsed->bytes();
+    }
+
+    Bytes _bytes{};
+};
+
+/**
+ * @typedef CharacteristicProperties
+ * @brief Bitmask of the properties of a GATT characteristic, see CharacteristicProperty.
+ */
+using CharacteristicProperties = uint32_t;
+
+/**
+ * @brief Individual bits of CharacteristicProperties.
+ *
+ * The lower eight bits match the Characteristic Properties field of the Bluetooth Core Specification,
+ * the bits above carry the Characteristic Extended Properties.
+ */
+namespace CharacteristicProperty {
+enum : CharacteristicProperties {
+    NONE = 0,
+    BROADCAST = 1 << 0,
+    READ = 1 << 1,
+    WRITE_COMMAND = 1 << 2,
+    WRITE_REQUEST = 1 << 3,
+    NOTIFY = 1 << 4,
+    INDICATE = 1 << 5,
+    AUTHENTICATED_SIGNED_WRITES = 1 << 6,
+    EXTENDED_PROPERTIES = 1 << 7,
+    RELIABLE_WRITE = 1 << 8,
+    WRITABLE_AUXILIARIES = 1 << 9,
+};
+}  // namespace CharacteristicProperty
+
 /**
  * @typedef ByteArray
  * @brief Represents a byte array using kvn::bytearray from the external library.
  */
 using ByteArray = kvn::bytearray;
 
+/**
+ * @brief Criteria that scanned peripherals must meet to be reported.
+ *
+ * Backends that support it apply the filter in the OS or the controller, so that advertisers
+ * that don't match never reach SimpleBLE. The other backends check every advertisement before
+ * creating any peripheral for it. A default-constructed filter reports every peripheral.
+ */
+struct ScanFilter {
+    enum class Transport { AUTO, BREDR, LE };
+    enum class BeaconType { IBEACON, EDDYSTONE_UID, EDDYSTONE_URL, EDDYSTONE_TLM, EDDYSTONE_EID };
+
+    /**
+     * Manufacturer data that starts with the given bytes, compared under the mask.
+     *
+     * An empty mask compares every byte, otherwise it must be as long as the data.
+     */
+    struct ManufacturerData {
+        uint16_t company_id = 0;
+        ByteArray data;
+        ByteArray mask;
+    };
+
+    // Only report peripherals advertising any of these services. Empty to allow any.
+    std::vector<BluetoothUUID> service_uuids;
+    // Only report advertisements received with at least this RSSI, in dBm.
+    std::optional<int16_t> rssi_threshold;
+    // Only report advertisements whose pathloss (TX power - RSSI) is at most this value, in dB.
+    std::optional<uint16_t> pathloss_threshold;
+    // Transport to discover peripherals on. Backends that only support LE report nothing for BREDR.
+    Transport transport = Transport::AUTO;
+    // Whether to report advertisements whose contents didn't change. Disabling it reduces
+    // the traffic from the backends that can detect duplicates natively.
+    bool duplicate_data = true;
+    // Only report peripherals whose address or name starts with this string. Empty to allow any.
+    std::string pattern;
+
+    // The criteria below can't be applied by the OS, all backends check them on the host before
+    // creating any peripheral for the advertiser.
+
+    // Only report peripherals advertising any of these manufacturer data. Empty to allow any.
+    std::vector<ManufacturerData> manufacturer_data;
+    // Only report peripherals whose name contains a match of this ECMAScript regular expression. Empty to allow any.
+    std::string name_regex;
+    // Only report peripherals with any of these addresses, regardless of case. Empty to allow any.
+    std::vector<BluetoothAddress> addresses;
+    // Only report peripherals broadcasting any of these beacon frames. Empty to allow any.
+    std::vector<BeaconType> beacon_types;
+};
+
 #ifdef ANDROID
 #pragma push_macro("ANDROID")
 #undef ANDROID
@@ -46,4 +294,68 @@ enum class OperatingSystem {
 // TODO: Add to_string functions for all enums.
 enum BluetoothAddressType : int32_t { PUBLIC = 0, RANDOM = 1, UNSPECIFIED = 2 };
 
+/**
+ * @brief How the notifications of a subscription reach its callback.
+ *
+ * Direct delivery, the default, runs the callback on the thread of the backend, so a slow callback
+ * holds back every other event of the adapter. Queued delivery pushes each payload into a bounded
+ * lock-free ring owned by the subscription, which is drained by a pool of worker threads, see
+ * Config::Base::notification_workers. Either way, the payloads of a subscription arrive in order.
+ */
+struct NotificationDelivery {
+    enum class Mode { DIRECT, QUEUED };
+
+    // What to do with a payload that arrives while the ring is full.
+    enum class OverflowPolicy {
+        DROP_NEWEST,       // Discard the incoming payload.
+        OVERWRITE_OLDEST,  // Discard the oldest queued payload to make room for it.
+        BLOCK,             // Hold back the thread of the backend until there is room.
+    };
+
+    Mode mode = Mode::DIRECT;
+    // Number of payloads the ring can hold, rounded up to a power of two of at least 2.
+    size_t capacity = 64;
+    OverflowPolicy overflow = OverflowPolicy::DROP_NEWEST;
+};
+
+/**
+ * @brief Counters of a subscription with queued delivery.
+ */
+struct NotificationStats {
+    size_t capacity = 0;
+    size_t queued = 0;
+    // Largest number of payloads that were queued at once.
+    size_t high_water_mark = 0;
+    uint64_t delivered = 0;
+    uint64_t dropped = 0;
+};
+
+/**
+ * @brief A single advertisement, as received by the adapter.
+ *
+ * Unlike a Peripheral, which holds the latest merged state of an advertiser, a report is a plain
+ * copy of one advertisement, stamped with the host's monotonic clock as soon as it is received.
+ */
+struct AdvertisementReport {
+    std::chrono::steady_clock::time_point timestamp;
+    BluetoothAddress address;
+    BluetoothAddressType address_type = BluetoothAddressType::UNSPECIFIED;
+    std::string identifier;
+    bool connectable = false;
+    int16_t rssi = 0;
+    int16_t tx_power = 0;
+    std::map<uint16_t, ByteArray> manufacturer_data;
+    std::map<BluetoothUUID, ByteArray> service_data;
+    std::vector<BluetoothUUID> service_uuids;
+};
+
 }  // namespace SimpleBLE
+
+namespace std {
+
+template <>
+struct hash<SimpleBLE::BluetoothUUID128> {
+    size_t operator()(const SimpleBLE::BluetoothUUID128& uuid) const noexcept { return uuid.hash(); }
+};
+
+}  // namespace std
@@ -3,6 +3,7 @@
 #include <functional>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include <simpleble/export.h>
 
@@ -40,6 +41,20 @@ class SIMPLEBLE_EXPORT Characteristic {
     ByteArray value();
     void set_value(ByteArray value);
 
+    /**
+     * Send values to the subscribed clients, one notification or indication each, in order.
+     *
+     * Unlike `set_value()`, every value is delivered rather than just the latest one, which
+     * makes this the call for streaming. `value()` becomes the last value sent. Values longer
+     * than what fits in a single packet for a client are truncated.
+     *
+     * On Linux, values are written straight to the sockets acquired by clients through BlueZ,
+     * several per system call, and only go through D-Bus for clients that didn't acquire one.
+     * Other backends send them through `set_value()`.
+     */
+    void notify(ByteArray value);
+    void notify(const std::vector<ByteArray>& values);
+
     /**
      * Optional value callbacks.
      *
@@ -6,6 +6,8 @@ namespace Config {
         bool use_system_bus = true;
         std::chrono::steady_clock::duration connection_timeout = std::chrono::seconds(2);
         std::chrono::steady_clock::duration disconnection_timeout = std::chrono::seconds(1);
+        size_t peripheral_cache_max_entries = 0;
+        std::chrono::steady_clock::duration peripheral_cache_ttl = std::chrono::steady_clock::duration::zero();
     }  // namespace SimpleBluez
 
     namespace WinRT {
@@ -24,5 +26,10 @@ namespace Config {
         bool force_update = false;
     }  // namespace Dongl
 
+    namespace Base {
+        size_t notification_workers = 1;
+        size_t async_workers = 2;
+    }  // namespace Base
+
 }  // namespace Config
 }  // namespace SimpleBLE
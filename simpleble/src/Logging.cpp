@@ -2,53 +2,278 @@
 
 #include <fmt/chrono.h>
 #include <fmt/core.h>
+#include <algorithm>
+#include <condition_variable>
 #include <ctime>
 #include <fstream>
 #include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SimpleBLE {
+
+namespace Logging {
+
+/**
+ * Bounded ring of log messages drained by a dedicated writer thread.
+ *
+ * Any thread can push without taking a lock, claiming a slot through its sequence number. The writer only
+ * sleeps when the ring is empty, and producers only take the mutex to wake it up. Stopping waits for the pushes
+ * in progress, so that every message accepted by push() is delivered before the writer exits.
+ */
+class AsyncSink {
+  public:
+    AsyncSink(Logger& logger, size_t capacity);
+    ~AsyncSink();
+
+    // Returns false once the sink has been stopped, in which case the message has to be delivered by the caller.
+    bool push(Level level, const std::string& module, const std::string& file, uint32_t line,
+              const std::string& function, const std::string& message);
+
+    void flush();
+
+    // Delivers the messages still queued and joins the writer thread.
+    void stop();
+
+  private:
+    struct Record {
+        Level level = Level::None;
+        std::string module;
+        std::string file;
+        uint32_t line = 0;
+        std::string function;
+        std::string message;
+    };
+
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        Record record;
+    };
+
+    bool _try_pop(Record& record);
+    bool _empty() const;
+    void _run();
+
+    Logger& _logger;
+    std::vector<Slot> _slots;
+    size_t _mask;
+
+    alignas(64) std::atomic<size_t> _head{0};
+    alignas(64) std::atomic<size_t> _tail{0};
+
+    // Set once push() starts refusing messages, and once the pushes that got in before that are done.
+    std::atomic_bool _stopped{false};
+    bool _closed = false;
+    std::atomic<size_t> _pushing{0};
+    std::atomic_bool _writer_sleeping{false};
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::condition_variable _flushed_cv;
+    std::thread _writer;
+};
+
+}  // namespace Logging
+
+}  // namespace SimpleBLE
 
 using namespace SimpleBLE::Logging;
 
+namespace {
+
+// With a single slot, the sequence of a filled slot and of a freed one would be the same.
+constexpr size_t MIN_ASYNC_CAPACITY = 2;
+
+size_t round_up_to_power_of_two(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+}  // namespace
+
+AsyncSink::AsyncSink(Logger& logger, size_t capacity)
+    : _logger(logger),
+      _slots(round_up_to_power_of_two(std::max(capacity, MIN_ASYNC_CAPACITY))),
+      _mask(_slots.size() - 1) {
+    for (size_t i = 0; i < _slots.size(); i++) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _writer = std::thread(&AsyncSink::_run, this);
+}
+
+AsyncSink::~AsyncSink() { stop(); }
+
+bool AsyncSink::push(Level level, const std::string& module, const std::string& file, uint32_t line,
+                     const std::string& function, const std::string& message) {
+    // Pairs with stop(), so that either this push sees the sink stopped or stop() waits for it to be done.
+    _pushing.fetch_add(1);
+    struct Pushed {
+        std::atomic<size_t>& pushing;
+        ~Pushed() { pushing.fetch_sub(1); }
+    } pushed{_pushing};
+    if (_stopped.load()) return false;
+
+    size_t position = _tail.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = _slots[position & _mask];
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+        if (difference == 0) {
+            if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.record.level = level;
+                slot.record.module = module;
+                slot.record.file = file;
+                slot.record.line = line;
+                slot.record.function = function;
+                slot.record.message = message;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                break;
+            }
+        } else if (difference < 0) {
+            _logger.dropped_++;
+            return true;
+        } else {
+            position = _tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Pairs with the fence in _run, so that either the writer sees the message or it is seen sleeping here.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_writer_sleeping.load(std::memory_order_relaxed)) {
+        std::scoped_lock lock(_mutex);
+        _cv.notify_one();
+    }
+    return true;
+}
+
+void AsyncSink::flush() {
+    if (std::this_thread::get_id() == _writer.get_id()) return;
+
+    const size_t target = _tail.load();
+    std::unique_lock lock(_mutex);
+    _cv.notify_one();
+    _flushed_cv.wait(lock, [this, target] {
+        return _stopped || static_cast<std::ptrdiff_t>(_head.load() - target) >= 0;
+    });
+}
+
+void AsyncSink::stop() {
+    {
+        std::scoped_lock lock(_mutex);
+        if (_stopped) return;
+        _stopped = true;
+    }
+
+    // A push that got past the check of _stopped is only ever a few copies away from publishing its slot.
+    while (_pushing.load() != 0) {
+        std::this_thread::yield();
+    }
+
+    {
+        std::scoped_lock lock(_mutex);
+        _closed = true;
+    }
+    _cv.notify_one();
+    _flushed_cv.notify_all();
+
+    if (_writer.joinable()) _writer.join();
+}
+
+bool AsyncSink::_try_pop(Record& record) {
+    const size_t position = _head.load(std::memory_order_relaxed);
+    Slot& slot = _slots[position & _mask];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1) return false;
+
+    record = std::move(slot.record);
+    slot.sequence.store(position + _slots.size(), std::memory_order_release);
+    _head.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool AsyncSink::_empty() const { return _tail.load() == _head.load(); }
+
+void AsyncSink::_run() {
+    Record record;
+    while (true) {
+        while (_try_pop(record)) {
+            _logger._deliver(record.level, record.module, record.file, record.line, record.function,
+                             record.message);
+        }
+
+        std::unique_lock lock(_mutex);
+        _flushed_cv.notify_all();
+        if (_closed && _empty()) break;
+
+        _writer_sleeping = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // A message claimed but not yet written leaves the ring non-empty, the writer then just tries again.
+        _cv.wait(lock, [this] { return _closed || !_empty(); });
+        _writer_sleeping = false;
+    }
+}
+
 Logger* Logger::get() {
-    static std::mutex get_mutex;       // Static mutex to ensure thread safety when accessing the logger
-    std::scoped_lock lock(get_mutex);  // Unlock the mutex on function return
-    static Logger instance;            // Static instance of the logger to ensure proper lifecycle management
+    // The initialization of a static local is thread-safe, and only checked once it has happened.
+    static Logger instance;
     return &instance;
 }
 
 Logger::Logger() { log_default_stdout(); }
 
-Logger::~Logger() {}
+Logger::~Logger() { set_async(false); }
 
-void Logger::set_level(Level level) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    level_ = level;
-}
+void Logger::set_level(Level level) { level_ = level; }
 
-Level Logger::get_level() {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    return level_;
-}
+Level Logger::get_level() { return level_; }
 
 void Logger::set_callback(Callback callback) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    callback_ = callback;
+    std::shared_ptr<const Callback> new_callback;
+    if (callback != nullptr) new_callback = std::make_shared<const Callback>(std::move(callback));
+
+    std::atomic_store(&callback_, std::move(new_callback));
 }
 
-bool Logger::has_callback() {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    return callback_ != nullptr;
+bool Logger::has_callback() { return std::atomic_load(&callback_) != nullptr; }
+
+void Logger::set_async(bool enabled, size_t capacity) {
+    std::shared_ptr<AsyncSink> sink;
+    if (enabled) sink = std::make_shared<AsyncSink>(*this, capacity);
+
+    sink = std::atomic_exchange(&async_sink_, std::move(sink));
+
+    // The previous sink delivers what it still holds before being released.
+    if (sink) sink->stop();
 }
 
+bool Logger::is_async() { return std::atomic_load(&async_sink_) != nullptr; }
+
+void Logger::flush() {
+    std::shared_ptr<AsyncSink> sink = std::atomic_load(&async_sink_);
+    if (sink) sink->flush();
+}
+
+uint64_t Logger::dropped() { return dropped_; }
+
 void Logger::log(Level level, const std::string& module, const std::string& file, uint32_t line,
                  const std::string& function, const std::string& message) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (!should_log(level)) return;
 
-    if (level <= level_ && callback_ != nullptr) {
-        try {
-            callback_(level, module, file, line, function, message);
-        } catch (...) {
-            // Clearly, if the logging callback throws an exception, we should not crash.
-        }
+    if (std::atomic_load(&callback_) == nullptr) return;
+
+    std::shared_ptr<AsyncSink> sink = std::atomic_load(&async_sink_);
+    if (sink && sink->push(level, module, file, line, function, message)) return;
+    _deliver(level, module, file, line, function, message);
+}
+
+void Logger::_deliver(Level level, const std::string& module, const std::string& file, uint32_t line,
+                      const std::string& function, const std::string& message) {
+    std::shared_ptr<const Callback> callback = std::atomic_load(&callback_);
+    if (callback == nullptr) return;
+
+    try {
+        (*callback)(level, module, file, line, function, message);
+    } catch (...) {
+        // Clearly, if the logging callback throws an exception, we should not crash.
     }
 }
 
@@ -96,12 +321,15 @@ void Logger::log_default_file() {
 }
 
 void Logger::log_default_file(const std::string path) {
+    // The callback can be invoked from several threads at once, which must not interleave their lines.
+    auto file_mutex = std::make_shared<std::mutex>();
     set_callback([=](Level level, const std::string& module, const std::string& file, uint32_t line,
                      const std::string& function, const std::string& message) {
         std::string level_str = level_to_str(level);
         std::string log_message = fmt::format("[{}] {}: {}:{} in {}: {}\n", level_str, module, file, line, function,
                                               message);
 
+        std::scoped_lock lock(*file_mutex);
         std::ofstream outfile;
         outfile.open(path, std::ios_base::app);  // open the file in append mode
         outfile << log_message;
@@ -123,7 +351,10 @@ void logfwd::receive(
     const std::string& message) {
 
     // Forward logs from internal modules into the SimpleBLE logger.
-    Logger::get()->log(
+    Logger* logger = Logger::get();
+    if (!logger->should_log(static_cast<Level>(level))) return;
+
+    logger->log(
         static_cast<Level>(level),
         fmt::format("SimpleBLE->{}", module),
         file,
@@ -17,69 +17,49 @@
 
 // clang-format off
 
-#if SIMPLEBLE_LOG_LEVEL == SIMPLEBLE_LOG_LEVEL_VERBOSE
-
-#define SIMPLEBLE_LOG_FATAL(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Fatal, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_ERROR(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Error, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_WARN(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Warn, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_INFO(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Info, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_DEBUG(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Debug, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_VERBOSE(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::VERBOSE, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-
-#elif SIMPLEBLE_LOG_LEVEL == SIMPLEBLE_LOG_LEVEL_DEBUG
-
-#define SIMPLEBLE_LOG_FATAL(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Fatal, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_ERROR(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Error, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_WARN(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Warn, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_INFO(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Info, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_DEBUG(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Debug, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_VERBOSE(msg)
-
-#elif SIMPLEBLE_LOG_LEVEL == SIMPLEBLE_LOG_LEVEL_INFO
-
-#define SIMPLEBLE_LOG_FATAL(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Fatal, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_ERROR(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Error, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_WARN(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Warn, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_INFO(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Info, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_DEBUG(msg) 
-#define SIMPLEBLE_LOG_VERBOSE(msg)
-
-#elif SIMPLEBLE_LOG_LEVEL == SIMPLEBLE_LOG_LEVEL_WARN
-
-#define SIMPLEBLE_LOG_FATAL(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Fatal, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_ERROR(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Error, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_WARN(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Warn, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_INFO(msg) 
-#define SIMPLEBLE_LOG_DEBUG(msg) 
-#define SIMPLEBLE_LOG_VERBOSE(msg)
+// The message is only evaluated, and formatted, when the runtime level of the logger lets it through.
+#define SIMPLEBLE_LOG(level, msg)                                                                   \
+    do {                                                                                            \
+        auto* simpleble_logger_ = SimpleBLE::Logging::Logger::get();                                \
+        if (simpleble_logger_->should_log(level)) {                                                 \
+            simpleble_logger_->log(level, "SimpleBLE", __FILE__, __LINE__, __func__, msg);          \
+        }                                                                                           \
+    } while (0)
+
+#if SIMPLEBLE_LOG_LEVEL >= SIMPLEBLE_LOG_LEVEL_FATAL
+#define SIMPLEBLE_LOG_FATAL(msg) SIMPLEBLE_LOG(SimpleBLE::Logging::Level::Fatal, msg)
+#else
+#define SIMPLEBLE_LOG_FATAL(msg)
+#endif
 
-#elif SIMPLEBLE_LOG_LEVEL == SIMPLEBLE_LOG_LEVEL_ERROR
+#if SIMPLEBLE_LOG_LEVEL >= SIMPLEBLE_LOG_LEVEL_ERROR
+#define SIMPLEBLE_LOG_ERROR(msg) SIMPLEBLE_LOG(SimpleBLE::Logging::Level::Error, msg)
+#else
+#define SIMPLEBLE_LOG_ERROR(msg)
+#endif
 
-#define SIMPLEBLE_LOG_FATAL(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Fatal, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_ERROR(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Error, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
+#if SIMPLEBLE_LOG_LEVEL >= SIMPLEBLE_LOG_LEVEL_WARN
+#define SIMPLEBLE_LOG_WARN(msg) SIMPLEBLE_LOG(SimpleBLE::Logging::Level::Warn, msg)
+#else
 #define SIMPLEBLE_LOG_WARN(msg)
-#define SIMPLEBLE_LOG_INFO(msg) 
-#define SIMPLEBLE_LOG_DEBUG(msg) 
-#define SIMPLEBLE_LOG_VERBOSE(msg)
-
-#elif SIMPLEBLE_LOG_LEVEL == SIMPLEBLE_LOG_LEVEL_FATAL
+#endif
 
-#define SIMPLEBLE_LOG_FATAL(msg) SimpleBLE::Logging::Logger::get()->log(SimpleBLE::Logging::Level::Fatal, "SimpleBLE", __FILE__, __LINE__, __func__, msg)
-#define SIMPLEBLE_LOG_ERROR(msg)
-#define SIMPLEBLE_LOG_WARN(msg)
-#define SIMPLEBLE_LOG_INFO(msg) 
-#define SIMPLEBLE_LOG_DEBUG(msg) 
-#define SIMPLEBLE_LOG_VERBOSE(msg)
+#if SIMPLEBLE_LOG_LEVEL >= SIMPLEBLE_LOG_LEVEL_INFO
+#define SIMPLEBLE_LOG_INFO(msg) SIMPLEBLE_LOG(SimpleBLE::Logging::Level::Info, msg)
+#else
+#define SIMPLEBLE_LOG_INFO(msg)
+#endif
 
+#if SIMPLEBLE_LOG_LEVEL >= SIMPLEBLE_LOG_LEVEL_DEBUG
+#define SIMPLEBLE_LOG_DEBUG(msg) SIMPLEBLE_LOG(SimpleBLE::Logging::Level::Debug, msg)
 #else
+#define SIMPLEBLE_LOG_DEBUG(msg)
+#endif
 
-#define SIMPLEBLE_LOG_FATAL(msg)
-#define SIMPLEBLE_LOG_ERROR(msg)
-#define SIMPLEBLE_LOG_WARN(msg)
-#define SIMPLEBLE_LOG_INFO(msg) 
-#define SIMPLEBLE_LOG_DEBUG(msg) 
+#if SIMPLEBLE_LOG_LEVEL >= SIMPLEBLE_LOG_LEVEL_VERBOSE
+#define SIMPLEBLE_LOG_VERBOSE(msg) SIMPLEBLE_LOG(SimpleBLE::Logging::Level::Verbose, msg)
+#else
 #define SIMPLEBLE_LOG_VERBOSE(msg)
-
 #endif
 
 // clang-format on
@@ -0,0 +1,372 @@
+#include "simpleble/Metrics.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+
+using namespace SimpleBLE::Metrics;
+
+namespace {
+
+// Values below 2^SUB_BUCKET_BITS get a bucket each, larger ones get 2^SUB_BUCKET_BITS buckets per power of two.
+constexpr unsigned SUB_BUCKET_BITS = 4;
+constexpr uint64_t SUB_BUCKET_COUNT = uint64_t(1) << SUB_BUCKET_BITS;
+constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+unsigned highest_bit(uint64_t value) {
+    unsigned bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+}
+
+size_t bucket_index(uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) return value;
+
+    const unsigned exponent = highest_bit(value);
+    const uint64_t sub_bucket = (value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + sub_bucket;
+}
+
+uint64_t bucket_upper_bound(size_t index) {
+    if (index < SUB_BUCKET_COUNT) return index;
+
+    const unsigned exponent = index / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+    const uint64_t sub_bucket = index % SUB_BUCKET_COUNT;
+    const unsigned shift = exponent - SUB_BUCKET_BITS;
+    return ((SUB_BUCKET_COUNT + sub_bucket) << shift) + ((uint64_t(1) << shift) - 1);
+}
+
+struct Histogram {
+    Histogram() {
+        for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+    }
+
+    void clear() {
+        for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+    }
+
+    void record(uint64_t value) {
+        buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t current = min.load(std::memory_order_relaxed);
+        while (value < current && !min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+        current = max.load(std::memory_order_relaxed);
+        while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets;
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> min{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max{0};
+};
+
+struct TraceEvent {
+    Key key;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::nanoseconds duration;
+    uint32_t thread;
+};
+
+// Series are never removed while metrics are recorded, only when reset, so that a lookup
+// only needs the shared lock once the series of a key exists. Series held by a Series handle
+// are cleared instead of removed.
+struct Registry {
+    std::atomic_bool enabled{false};
+    std::atomic_bool tracing{false};
+
+    std::shared_mutex mutex;
+    std::map<Key, std::shared_ptr<std::atomic<uint64_t>>> counters;
+    std::map<Key, std::shared_ptr<Histogram>> latencies;
+
+    std::mutex trace_mutex;
+    std::vector<TraceEvent> trace_events;
+    size_t trace_capacity = 0;
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    template <typename T>
+    std::shared_ptr<T> find_or_create(std::map<Key, std::shared_ptr<T>>& series, const Key& key) {
+        {
+            std::shared_lock lock(mutex);
+            auto it = series.find(key);
+            if (it != series.end()) return it->second;
+        }
+
+        std::unique_lock lock(mutex);
+        auto& entry = series[key];
+        if (!entry) entry = std::make_shared<T>();
+        return entry;
+    }
+
+    template <typename T, typename Clear>
+    static void reset(std::map<Key, std::shared_ptr<T>>& series, Clear clear) {
+        for (auto it = series.begin(); it != series.end();) {
+            if (it->second.use_count() > 1) {
+                clear(*it->second);
+                ++it;
+            } else {
+                it = series.erase(it);
+            }
+        }
+    }
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+uint32_t current_thread() {
+    static std::atomic<uint32_t> next_thread{1};
+    thread_local uint32_t thread = next_thread++;
+    return thread;
+}
+
+std::string escape_json(const std::string& value) {
+    std::string result;
+    result.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    result += fmt::format("\\u{:04x}", static_cast<int>(c));
+                } else {
+                    result += c;
+                }
+        }
+    }
+    return result;
+}
+
+std::string key_to_json(const Key& key) {
+    return fmt::format(R"("operation": "{}", "adapter": "{}", "peripheral": "{}")", escape_json(key.operation),
+                       escape_json(key.adapter), escape_json(key.peripheral));
+}
+
+}  // namespace
+
+bool Key::operator<(const Key& other) const {
+    return std::tie(operation, adapter, peripheral) < std::tie(other.operation, other.adapter, other.peripheral);
+}
+
+bool Key::operator==(const Key& other) const {
+    return operation == other.operation && adapter == other.adapter && peripheral == other.peripheral;
+}
+
+std::chrono::nanoseconds Latency::mean() const {
+    if (count == 0) return std::chrono::nanoseconds(0);
+
+    return total / static_cast<int64_t>(count);
+}
+
+std::chrono::nanoseconds Latency::percentile(double fraction) const {
+    if (count == 0) return std::chrono::nanoseconds(0);
+
+    const auto rank = static_cast<uint64_t>(std::ceil(std::clamp(fraction, 0.0, 1.0) * count));
+    if (rank == 0) return min;
+
+    uint64_t seen = 0;
+    for (const auto& [upper_bound, bucket_count] : buckets) {
+        seen += bucket_count;
+        if (seen >= rank) return std::min(upper_bound, max);
+    }
+    return max;
+}
+
+void SimpleBLE::Metrics::set_enabled(bool enabled) { registry().enabled = enabled; }
+
+bool SimpleBLE::Metrics::is_enabled() { return registry().enabled.load(std::memory_order_relaxed); }
+
+void SimpleBLE::Metrics::increment(const Key& key, uint64_t amount) {
+    if (!is_enabled()) return;
+
+    Registry& metrics = registry();
+    metrics.find_or_create(metrics.counters, key)->fetch_add(amount, std::memory_order_relaxed);
+}
+
+void SimpleBLE::Metrics::record_latency(const Key& key, std::chrono::nanoseconds latency) {
+    if (!is_enabled()) return;
+
+    Registry& metrics = registry();
+    const auto value = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+    metrics.find_or_create(metrics.latencies, key)->record(value);
+}
+
+Snapshot SimpleBLE::Metrics::snapshot() {
+    Registry& metrics = registry();
+    Snapshot result;
+
+    std::shared_lock lock(metrics.mutex);
+    for (const auto& [key, counter] : metrics.counters) {
+        const uint64_t value = counter->load(std::memory_order_relaxed);
+        if (value == 0) continue;
+
+        result.counters.push_back({key, value});
+    }
+
+    for (const auto& [key, histogram] : metrics.latencies) {
+        Latency latency;
+        latency.key = key;
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            const uint64_t bucket_count = histogram->buckets[i].load(std::memory_order_relaxed);
+            if (bucket_count == 0) continue;
+
+            latency.buckets.emplace_back(std::chrono::nanoseconds(bucket_upper_bound(i)), bucket_count);
+            latency.count += bucket_count;
+        }
+        if (latency.count == 0) continue;
+
+        // The count is taken from the buckets, so that percentiles stay consistent with samples recorded meanwhile.
+        latency.min = std::chrono::nanoseconds(histogram->min.load(std::memory_order_relaxed));
+        latency.max = std::chrono::nanoseconds(histogram->max.load(std::memory_order_relaxed));
+        latency.total = std::chrono::nanoseconds(histogram->total.load(std::memory_order_relaxed));
+        result.latencies.push_back(std::move(latency));
+    }
+
+    return result;
+}
+
+void SimpleBLE::Metrics::reset() {
+    Registry& metrics = registry();
+    {
+        std::unique_lock lock(metrics.mutex);
+        Registry::reset(metrics.counters, [](std::atomic<uint64_t>& counter) { counter.store(0); });
+        Registry::reset(metrics.latencies, [](Histogram& histogram) { histogram.clear(); });
+    }
+
+    std::scoped_lock lock(metrics.trace_mutex);
+    metrics.trace_events.clear();
+}
+
+std::string SimpleBLE::Metrics::export_json() {
+    const Snapshot metrics = snapshot();
+
+    std::string json = R"({"counters": [)";
+    for (size_t i = 0; i < metrics.counters.size(); i++) {
+        const Counter& counter = metrics.counters[i];
+        json += fmt::format(R"({}{{{}, "value": {}}})", i == 0 ? "" : ", ", key_to_json(counter.key), counter.value);
+    }
+
+    json += R"(], "latencies": [)";
+    for (size_t i = 0; i < metrics.latencies.size(); i++) {
+        const Latency& latency = metrics.latencies[i];
+        json += fmt::format(
+            R"({}{{{}, "count": {}, "min_ns": {}, "max_ns": {}, "mean_ns": {}, "p50_ns": {}, "p90_ns": {}, )"
+            R"("p99_ns": {}, "p999_ns": {}}})",
+            i == 0 ? "" : ", ", key_to_json(latency.key), latency.count, latency.min.count(), latency.max.count(),
+            latency.mean().count(), latency.percentile(0.5).count(), latency.percentile(0.9).count(),
+            latency.percentile(0.99).count(), latency.percentile(0.999).count());
+    }
+    json += "]}";
+
+    return json;
+}
+
+void SimpleBLE::Metrics::set_tracing(bool enabled, size_t capacity) {
+    Registry& metrics = registry();
+    std::scoped_lock lock(metrics.trace_mutex);
+    metrics.trace_capacity = capacity;
+    if (metrics.trace_events.size() > capacity) metrics.trace_events.resize(capacity);
+    metrics.tracing = enabled;
+}
+
+bool SimpleBLE::Metrics::is_tracing() { return registry().tracing.load(std::memory_order_relaxed); }
+
+std::string SimpleBLE::Metrics::export_trace() {
+    Registry& metrics = registry();
+    std::vector<TraceEvent> events;
+    {
+        std::scoped_lock lock(metrics.trace_mutex);
+        events = metrics.trace_events;
+    }
+
+    // Complete events, with timestamps in microseconds since the metrics were first used.
+    std::string json = R"({"displayTimeUnit": "ns", "traceEvents": [)";
+    for (size_t i = 0; i < events.size(); i++) {
+        const TraceEvent& event = events[i];
+        const auto start = std::chrono::duration<double, std::micro>(event.start - metrics.epoch).count();
+        const auto duration = std::chrono::duration<double, std::micro>(event.duration).count();
+        json += fmt::format(
+            R"({}{{"name": "{}", "cat": "simpleble", "ph": "X", "ts": {:.3f}, "dur": {:.3f}, "pid": 1, "tid": {}, )"
+            R"("args": {{"adapter": "{}", "peripheral": "{}"}}}})",
+            i == 0 ? "" : ", ", escape_json(event.key.operation), start, duration, event.thread,
+            escape_json(event.key.adapter), escape_json(event.key.peripheral));
+    }
+    json += "]}";
+
+    return json;
+}
+
+struct Series::State {
+    Key key;
+    std::shared_ptr<std::atomic<uint64_t>> counter;
+    std::shared_ptr<Histogram> histogram;
+};
+
+Series::Series(Key key) : _state(std::make_shared<State>()) {
+    Registry& metrics = registry();
+    _state->counter = metrics.find_or_create(metrics.counters, key);
+    _state->histogram = metrics.find_or_create(metrics.latencies, key);
+    _state->key = std::move(key);
+}
+
+const Key& Series::key() const { return _state->key; }
+
+void Series::increment(uint64_t amount) {
+    if (!is_enabled()) return;
+
+    _state->counter->fetch_add(amount, std::memory_order_relaxed);
+}
+
+void Series::record_latency(std::chrono::nanoseconds latency) {
+    if (!is_enabled()) return;
+
+    _state->histogram->record(static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0)));
+}
+
+Timer::Timer(Key key) : Timer(Series(std::move(key))) {}
+
+Timer::Timer(Series series)
+    : _series(std::move(series)),
+      _start(std::chrono::steady_clock::now()),
+      _uncaught_exceptions(std::uncaught_exceptions()) {}
+
+Timer::~Timer() {
+    if (!is_enabled() || std::uncaught_exceptions() > _uncaught_exceptions) return;
+
+    const auto duration = std::chrono::steady_clock::now() - _start;
+    _series.record_latency(duration);
+
+    Registry& metrics = registry();
+    if (!metrics.tracing.load(std::memory_order_relaxed)) return;
+
+    const uint32_t thread = current_thread();
+    std::scoped_lock lock(metrics.trace_mutex);
+    if (metrics.trace_events.size() < metrics.trace_capacity) {
+        metrics.trace_events.push_back({_series.key(), _start, duration, thread});
+    }
+}
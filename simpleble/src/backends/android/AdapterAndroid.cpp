@@ -4,6 +4,7 @@
 #include "CommonUtils.h"
 #include "PeripheralAndroid.h"
 #include "LocalPeripheralAndroid.h"
+#include "ScanFilterMatcher.h"
 #include "simpleble/Peripheral.h"
 
 #include <types/android/bluetooth/BluetoothDevice.h>
@@ -21,6 +22,22 @@ AdapterAndroid::AdapterAndroid() {
     _btScanCallback.set_callback_onScanResult([this](Android::ScanResult scan_result) {
         std::string address = scan_result.getDevice().getAddress();
 
+        // The scan filter is applied on the host, before any peripheral is created for the advertiser.
+        // Reading the advertisement goes through JNI, so it's only done when there is a filter.
+        if (auto scan_matcher = _scan_filter_matcher()) {
+            advertising_data_t data{};
+            data.identifier = scan_result.getDevice().getName();
+            data.mac_address = address;
+            data.rssi = scan_result.getRssi();
+            data.tx_power = scan_result.getTxPower();
+            for (auto& service_uuid : scan_result.getScanRecord().getServiceUuids()) {
+                data.service_data[service_uuid] = ByteArray();
+            }
+            if (!scan_matcher->matches(data)) {
+                return;
+            }
+        }
+
         if (this->peripherals_.count(address) == 0) {
             // If the incoming peripheral has never been seen before, create and save a reference to it.
             auto base_peripheral = std::make_shared<PeripheralAndroid>(scan_result.getDevice());
@@ -133,17 +133,11 @@ SharedPtrVector<ServiceBase> PeripheralAndroid::available_services() {
                 descriptor_list.push_back(std::make_shared<DescriptorBase>(descriptor.getUuid()));
             }
 
-            int flags = characteristic.getProperties();
-
-            bool can_read = flags & Android::BluetoothGattCharacteristic::PROPERTY_READ;
-            bool can_write_request = flags & Android::BluetoothGattCharacteristic::PROPERTY_WRITE;
-            bool can_write_command = flags & Android::BluetoothGattCharacteristic::PROPERTY_WRITE_NO_RESPONSE;
-            bool can_notify = flags & Android::BluetoothGattCharacteristic::PROPERTY_NOTIFY;
-            bool can_indicate = flags & Android::BluetoothGattCharacteristic::PROPERTY_INDICATE;
+            // BluetoothGattCharacteristic properties follow the Bluetooth specification, as CharacteristicProperties.
+            CharacteristicProperties properties = characteristic.getProperties() & 0xFF;
 
             characteristic_list.push_back(
-                std::make_shared<CharacteristicBase>(characteristic.getUuid(), descriptor_list, can_read,
-                                                     can_write_request, can_write_command, can_notify, can_indicate));
+                std::make_shared<CharacteristicBase>(characteristic.getUuid(), descriptor_list, properties));
         }
 
         service_list.push_back(std::make_shared<ServiceBase>(service.getUuid(), characteristic_list));
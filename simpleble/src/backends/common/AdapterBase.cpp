@@ -1,6 +1,12 @@
 #include "AdapterBase.h"
 
+#include <simpleble/Peripheral.h>
+
+#include "AdapterBaseTypes.h"
+#include "CommonUtils.h"
 #include "LocalPeripheralBase.h"
+#include "ScanBatcher.h"
+#include "ScanFilterMatcher.h"
 
 namespace SimpleBLE {
 
@@ -37,21 +43,122 @@ void AdapterBase::set_callback_on_scan_stop(std::function<void()> on_scan_stop)
 }
 
 void AdapterBase::set_callback_on_scan_updated(std::function<void(Peripheral)> on_scan_updated) {
+    {
+        std::scoped_lock lock(_scan_callbacks_mutex);
+        _user_callback_on_scan_updated = std::move(on_scan_updated);
+    }
+    _scan_callbacks_reload();
+}
+
+void AdapterBase::set_callback_on_scan_found(std::function<void(Peripheral)> on_scan_found) {
+    {
+        std::scoped_lock lock(_scan_callbacks_mutex);
+        _user_callback_on_scan_found = std::move(on_scan_found);
+    }
+    _scan_callbacks_reload();
+}
+
+void AdapterBase::set_callback_on_scan_batch(std::function<void(std::vector<Peripheral>)> on_scan_batch,
+                                             std::chrono::milliseconds interval) {
+    std::shared_ptr<ScanBatcher> previous_batcher;
+    {
+        std::scoped_lock lock(_scan_callbacks_mutex);
+        previous_batcher = std::move(_scan_batcher);
+        if (on_scan_batch) {
+            _scan_batcher = std::make_shared<ScanBatcher>(std::move(on_scan_batch), interval);
+        }
+    }
+    _scan_callbacks_reload();
+
+    // The previous batcher is released here, outside of the lock, as stopping it
+    // waits for any batch that is currently being delivered.
+}
+
+void AdapterBase::set_callback_on_advertisement(std::function<void(const AdvertisementReport&)> on_advertisement) {
+    if (on_advertisement) {
+        _callback_on_advertisement.load(std::move(on_advertisement));
+    } else {
+        _callback_on_advertisement.unload();
+    }
+}
+
+void AdapterBase::_scan_callbacks_reload() {
+    std::scoped_lock lock(_scan_callbacks_mutex);
+
+    auto compose = [batcher = _scan_batcher](std::function<void(Peripheral)> user_callback)
+        -> std::function<void(Peripheral)> {
+        if (!batcher) return user_callback;
+        if (!user_callback) return [batcher](Peripheral peripheral) { batcher->push(std::move(peripheral)); };
+
+        return [batcher, user_callback = std::move(user_callback)](Peripheral peripheral) {
+            batcher->push(peripheral);
+            user_callback(std::move(peripheral));
+        };
+    };
+
+    auto on_scan_updated = compose(_user_callback_on_scan_updated);
     if (on_scan_updated) {
-        _callback_on_scan_updated.load(on_scan_updated);
+        _callback_on_scan_updated.load(std::move(on_scan_updated));
     } else {
         _callback_on_scan_updated.unload();
     }
-}
 
-void AdapterBase::set_callback_on_scan_found(std::function<void(Peripheral)> on_scan_found) {
+    auto on_scan_found = compose(_user_callback_on_scan_found);
     if (on_scan_found) {
-        _callback_on_scan_found.load(on_scan_found);
+        _callback_on_scan_found.load(std::move(on_scan_found));
     } else {
         _callback_on_scan_found.unload();
     }
 }
 
+void AdapterBase::set_scan_filter(ScanFilter filter) {
+    auto matcher = std::make_shared<const ScanFilterMatcher>(filter);
+
+    std::scoped_lock lock(_scan_filter_mutex);
+    _scan_filter = std::move(filter);
+    // A filter that lets everything through is dropped, so that unfiltered scans skip the checks.
+    _scan_matcher = matcher->matches_all() ? nullptr : std::move(matcher);
+}
+
+ScanFilter AdapterBase::scan_filter() {
+    std::scoped_lock lock(_scan_filter_mutex);
+    return _scan_filter;
+}
+
+bool AdapterBase::_scan_filter_accepts(const advertising_data_t& data) {
+    auto matcher = _scan_filter_matcher();
+    return !matcher || matcher->matches(data);
+}
+
+std::shared_ptr<const ScanFilterMatcher> AdapterBase::_scan_filter_matcher() {
+    std::scoped_lock lock(_scan_filter_mutex);
+    return _scan_matcher;
+}
+
+void AdapterBase::_report_advertisement(const advertising_data_t& data) {
+    // Reports are only built when someone listens, so that scanning without them costs nothing.
+    if (!_callback_on_advertisement) return;
+
+    _report_advertisement(advertising_data_t(data), std::chrono::steady_clock::now());
+}
+
+void AdapterBase::_report_advertisement(advertising_data_t&& data, std::chrono::steady_clock::time_point timestamp) {
+    if (!_callback_on_advertisement) return;
+
+    AdvertisementReport report;
+    report.timestamp = timestamp;
+    report.address = std::move(data.mac_address);
+    report.address_type = data.address_type;
+    report.identifier = std::move(data.identifier);
+    report.connectable = data.connectable;
+    report.rssi = data.rssi;
+    report.tx_power = data.tx_power;
+    report.manufacturer_data = std::move(data.manufacturer_data);
+    report.service_data = std::move(data.service_data);
+    report.service_uuids = std::move(data.service_uuids);
+    SAFE_CALLBACK_CALL(_callback_on_advertisement, report);
+}
+
 std::shared_ptr<Local::PeripheralBase> AdapterBase::create_local_peripheral() {
     throw Exception::OperationNotSupported();
 }
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -14,6 +16,9 @@ namespace SimpleBLE {
 
 class Peripheral;
 class PeripheralBase;
+class ScanBatcher;
+class ScanFilterMatcher;
+struct advertising_data_t;
 
 namespace Local {
 class PeripheralBase;
@@ -58,6 +63,18 @@ class AdapterBase {
     virtual void set_callback_on_scan_stop(std::function<void()> on_scan_stop);
     virtual void set_callback_on_scan_updated(std::function<void(Peripheral)> on_scan_updated);
     virtual void set_callback_on_scan_found(std::function<void(Peripheral)> on_scan_found);
+    virtual void set_callback_on_scan_batch(std::function<void(std::vector<Peripheral>)> on_scan_batch,
+                                            std::chrono::milliseconds interval);
+    virtual void set_callback_on_advertisement(std::function<void(const AdvertisementReport&)> on_advertisement);
+
+    /**
+     * Set the filter applied to subsequent scans.
+     *
+     * The filter is stored here and evaluated on the host through `_scan_filter_accepts`.
+     * Backends that can filter natively read it back when starting a scan.
+     */
+    virtual void set_scan_filter(ScanFilter filter);
+    ScanFilter scan_filter();
 
     virtual std::vector<std::shared_ptr<PeripheralBase>> get_paired_peripherals() = 0;
     virtual std::vector<std::shared_ptr<PeripheralBase>> get_connected_peripherals() { return {}; };
@@ -82,6 +99,30 @@ class AdapterBase {
     kvn::safe_callback<void()> _callback_on_scan_stop;
     kvn::safe_callback<void(Peripheral)> _callback_on_scan_updated;
     kvn::safe_callback<void(Peripheral)> _callback_on_scan_found;
+    kvn::safe_callback<void(const AdvertisementReport&)> _callback_on_advertisement;
+
+    // Whether an advertisement passes the scan filter, to be checked before creating any peripheral for it.
+    bool _scan_filter_accepts(const advertising_data_t& data);
+    // Host-side form of the scan filter, or null if it lets every advertisement through.
+    std::shared_ptr<const ScanFilterMatcher> _scan_filter_matcher();
+    // Forwards an advertisement that passed the scan filter to the report callback, stamping it with the current time.
+    void _report_advertisement(const advertising_data_t& data);
+    // Same as above, for backends that stamp the advertisement themselves and no longer need its data.
+    void _report_advertisement(advertising_data_t&& data, std::chrono::steady_clock::time_point timestamp);
+
+  private:
+    // The scan found/updated callbacks invoked by the backends are composed from
+    // the user callbacks and the scan batcher, if any.
+    void _scan_callbacks_reload();
+
+    std::mutex _scan_callbacks_mutex;
+    std::function<void(Peripheral)> _user_callback_on_scan_updated;
+    std::function<void(Peripheral)> _user_callback_on_scan_found;
+    std::shared_ptr<ScanBatcher> _scan_batcher;
+
+    std::mutex _scan_filter_mutex;
+    ScanFilter _scan_filter;
+    std::shared_ptr<const ScanFilterMatcher> _scan_matcher;
 };
 
 }  // namespace SimpleBLE
@@ -17,6 +17,8 @@ struct advertising_data_t {
 
     std::map<uint16_t, ByteArray> manufacturer_data;
     std::map<BluetoothUUID, ByteArray> service_data;
+    // Service UUIDs listed by the advertisement, which don't necessarily come with service data.
+    std::vector<BluetoothUUID> service_uuids;
 };
 
 }  // namespace SimpleBLE
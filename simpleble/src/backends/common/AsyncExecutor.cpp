@@ -0,0 +1,54 @@
+#include "AsyncExecutor.h"
+
+#include <simpleble/Config.h>
+
+#include <algorithm>
+
+using namespace SimpleBLE;
+
+AsyncExecutor& AsyncExecutor::get() {
+    static AsyncExecutor executor(std::max<size_t>(Config::Base::async_workers, 1));
+    return executor;
+}
+
+AsyncExecutor::AsyncExecutor(size_t worker_count) {
+    for (size_t i = 0; i < worker_count; i++) {
+        _workers.emplace_back(&AsyncExecutor::_run, this);
+    }
+}
+
+AsyncExecutor::~AsyncExecutor() {
+    {
+        std::scoped_lock lock(_mutex);
+        _stop = true;
+    }
+    _cv.notify_all();
+
+    for (auto& worker : _workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void AsyncExecutor::_enqueue(std::function<void()> task) {
+    {
+        std::scoped_lock lock(_mutex);
+        _tasks.push_back(std::move(task));
+    }
+    _cv.notify_one();
+}
+
+void AsyncExecutor::_run() {
+    std::unique_lock lock(_mutex);
+    while (true) {
+        _cv.wait(lock, [this] { return _stop || !_tasks.empty(); });
+        if (_stop) break;
+
+        auto task = std::move(_tasks.front());
+        _tasks.pop_front();
+
+        // Exceptions are stored in the future of the task, so running it never throws.
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
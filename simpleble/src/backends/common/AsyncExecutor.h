@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace SimpleBLE {
+
+/**
+ * Pool of worker threads running the blocking operations behind the default non-blocking variants
+ * of PeripheralBase.
+ *
+ * Started on first use with Config::Base::async_workers threads, and shared by all peripherals. Tasks
+ * wait in a queue once all workers are busy. The returned futures come from std::packaged_task, so
+ * discarding one never blocks.
+ */
+class AsyncExecutor {
+  public:
+    static AsyncExecutor& get();
+    ~AsyncExecutor();
+
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+
+    template <typename Function>
+    std::future<std::invoke_result_t<Function>> submit(Function&& function) {
+        using Result = std::invoke_result_t<Function>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+        std::future<Result> future = task->get_future();
+        _enqueue([task]() { (*task)(); });
+        return future;
+    }
+
+  private:
+    explicit AsyncExecutor(size_t worker_count);
+
+    void _enqueue(std::function<void()> task);
+    void _run();
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _stop = false;
+    std::deque<std::function<void()>> _tasks;
+    std::vector<std::thread> _workers;
+};
+
+}  // namespace SimpleBLE
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <simpleble/Types.h>
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace SimpleBLE {
+
+/**
+ * Characteristics resolved for a connection, indexed by service and characteristic UUID.
+ *
+ * Keys hold the binary form of the UUIDs, so every spelling of a UUID finds the same entry.
+ * All methods are thread safe.
+ */
+template <typename Entry>
+class CharacteristicIndex {
+  public:
+    struct Key {
+        BluetoothUUID128 service;
+        BluetoothUUID128 characteristic;
+
+        bool operator==(const Key& other) const {
+            return service == other.service && characteristic == other.characteristic;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept { return key.service.hash() * 31 + key.characteristic.hash(); }
+    };
+
+    using Entries = std::unordered_map<Key, Entry, KeyHash>;
+
+    // Returns no key if either UUID can't be parsed, in which case the characteristic can't be indexed.
+    static std::optional<Key> key(BluetoothUUID const& service, BluetoothUUID const& characteristic) {
+        auto service_key = BluetoothUUID128::parse(service);
+        auto characteristic_key = BluetoothUUID128::parse(characteristic);
+        if (!service_key || !characteristic_key) return std::nullopt;
+        return Key{*service_key, *characteristic_key};
+    }
+
+    std::optional<Entry> find(const Key& key) const {
+        std::scoped_lock lock(_mutex);
+        auto it = _entries.find(key);
+        if (it == _entries.end()) return std::nullopt;
+        return it->second;
+    }
+
+    void insert(const Key& key, Entry entry) {
+        std::scoped_lock lock(_mutex);
+        _entries[key] = std::move(entry);
+    }
+
+    // Replaces the whole index, e.g. once the services of a connection have been resolved.
+    void assign(Entries entries) {
+        std::scoped_lock lock(_mutex);
+        _entries = std::move(entries);
+    }
+
+    void clear() noexcept {
+        std::scoped_lock lock(_mutex);
+        _entries.clear();
+    }
+
+    size_t size() const {
+        std::scoped_lock lock(_mutex);
+        return _entries.size();
+    }
+
+  private:
+    mutable std::mutex _mutex;
+    Entries _entries;
+};
+
+}  // namespace SimpleBLE
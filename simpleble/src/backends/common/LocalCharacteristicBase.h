@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <set>
+#include <vector>
 
 #include <simpleble/Types.h>
 #include <simpleble/local/Characteristic.h>
@@ -18,6 +19,11 @@ class CharacteristicBase {
     virtual ByteArray value() = 0;
     virtual void set_value(ByteArray value) = 0;
 
+    // Backends without a faster path publish every value in turn.
+    virtual void notify(const std::vector<ByteArray>& values) {
+        for (const auto& value : values) set_value(value);
+    }
+
     virtual void set_callback_on_read(std::function<ByteArray()> on_read) = 0;
     virtual void set_callback_on_write(std::function<void(ByteArray value)> on_write) = 0;
 
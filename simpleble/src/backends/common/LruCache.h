@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace SimpleBLE {
+
+/**
+ * Entries ordered by the last time they were seen, which can be bounded by count and by age.
+ *
+ * The cache is not thread safe, callers are expected to hold their own lock.
+ */
+template <typename Key, typename Value>
+class LruCache {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    Value* find(const Key& key) {
+        auto it = _entries.find(key);
+        return it == _entries.end() ? nullptr : &it->second.value;
+    }
+
+    // Inserts a new entry as the most recently seen one, or marks an existing one as seen.
+    Value& insert(const Key& key, Value value, Clock::time_point now) {
+        auto it = _entries.find(key);
+        if (it != _entries.end()) {
+            _touch(it->second, now);
+            return it->second.value;
+        }
+
+        _order.push_front(key);
+        return _entries.emplace(key, Entry{std::move(value), now, _order.begin()}).first->second.value;
+    }
+
+    // Marks an entry as seen, if it's present.
+    void touch(const Key& key, Clock::time_point now) {
+        auto it = _entries.find(key);
+        if (it != _entries.end()) {
+            _touch(it->second, now);
+        }
+    }
+
+    /**
+     * Evicts the least recently seen entries beyond `max_entries` and those not seen for longer than `ttl`.
+     * A limit of zero disables it. Entries for which `evictable(key, value)` is false are marked as seen
+     * instead, which bounds the number of iterations by the size of the cache.
+     */
+    template <typename Evictable>
+    std::vector<std::pair<Key, Value>> evict(Clock::time_point now, size_t max_entries, Clock::duration ttl,
+                                             Evictable&& evictable) {
+        std::vector<std::pair<Key, Value>> evicted;
+
+        size_t remaining = _order.size();
+        while (remaining-- > 0) {
+            auto it = _entries.find(_order.back());
+
+            const bool over_capacity = max_entries > 0 && _entries.size() > max_entries;
+            const bool expired = ttl > Clock::duration::zero() && now - it->second.last_seen > ttl;
+            if (!over_capacity && !expired) {
+                break;
+            }
+
+            if (!evictable(it->first, it->second.value)) {
+                _touch(it->second, now);
+                continue;
+            }
+
+            _order.pop_back();
+            evicted.emplace_back(it->first, std::move(it->second.value));
+            _entries.erase(it);
+        }
+
+        return evicted;
+    }
+
+    size_t size() const { return _entries.size(); }
+
+  private:
+    struct Entry {
+        Value value;
+        Clock::time_point last_seen;
+        typename std::list<Key>::iterator position;
+    };
+
+    void _touch(Entry& entry, Clock::time_point now) {
+        entry.last_seen = now;
+        _order.splice(_order.begin(), _order, entry.position);
+    }
+
+    std::map<Key, Entry> _entries;
+    // Keys of the entries, from the most to the least recently seen.
+    std::list<Key> _order;
+};
+
+}  // namespace SimpleBLE
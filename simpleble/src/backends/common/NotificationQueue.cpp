@@ -0,0 +1,244 @@
+#include "NotificationQueue.h"
+
+#include <simpleble/Config.h>
+
+#include <algorithm>
+
+#include "CommonUtils.h"
+
+using namespace SimpleBLE;
+
+namespace {
+
+// Payloads delivered per turn of a queue, so that a busy subscription can't starve the others.
+constexpr size_t DRAIN_BATCH_SIZE = 32;
+
+// With a single slot, the sequence of a filled slot and of a freed one would be the same.
+constexpr size_t MIN_CAPACITY = 2;
+
+size_t round_up_to_power_of_two(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+}  // namespace
+
+NotificationQueue::NotificationQueue(std::function<void(ByteArray payload)> callback,
+                                     const NotificationDelivery& delivery)
+    : _callback(std::move(callback)),
+      _overflow(delivery.overflow),
+      _slots(round_up_to_power_of_two(std::max<size_t>(delivery.capacity, MIN_CAPACITY))),
+      _mask(_slots.size() - 1) {
+    for (size_t i = 0; i < _slots.size(); i++) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+void NotificationQueue::push(ByteArray payload) {
+    if (_closed) return;
+
+    switch (_overflow) {
+        case NotificationDelivery::OverflowPolicy::DROP_NEWEST:
+            if (!_try_push(payload)) {
+                _dropped++;
+                return;
+            }
+            break;
+
+        case NotificationDelivery::OverflowPolicy::OVERWRITE_OLDEST:
+            while (!_try_push(payload)) {
+                ByteArray discarded;
+                if (_try_pop(discarded)) _dropped++;
+            }
+            break;
+
+        case NotificationDelivery::OverflowPolicy::BLOCK:
+            if (!_try_push(payload)) {
+                std::unique_lock lock(_producer_mutex);
+                _producers_waiting++;
+                // Pairs with the fence in _wake_producer, so that either the slot freed by the consumer
+                // is seen here or the consumer sees that a producer is waiting.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                _producer_cv.wait(lock, [this, &payload] { return _closed || _try_push(payload); });
+                _producers_waiting--;
+                if (_closed) return;
+            }
+            break;
+    }
+
+    const size_t head = _head.load(std::memory_order_relaxed);
+    const size_t queued = _tail.load(std::memory_order_relaxed) - head;
+    size_t high_water_mark = _high_water_mark.load(std::memory_order_relaxed);
+    while (queued > high_water_mark && !_high_water_mark.compare_exchange_weak(high_water_mark, queued)) {
+    }
+
+    _schedule();
+}
+
+void NotificationQueue::close() {
+    {
+        std::scoped_lock lock(_producer_mutex);
+        _closed = true;
+    }
+    _producer_cv.notify_all();
+
+    // The worker checks the flag before every payload, so at most the callback in progress is waited for.
+    std::unique_lock lock(_drain_mutex);
+    if (_draining == std::this_thread::get_id()) return;
+    _drain_cv.wait(lock, [this] { return _draining == std::thread::id(); });
+}
+
+NotificationStats NotificationQueue::stats() const {
+    NotificationStats stats;
+    stats.capacity = _slots.size();
+    // The head is read first, so that it can't be ahead of the tail.
+    const size_t head = _head.load();
+    stats.queued = _tail.load() - head;
+    stats.high_water_mark = _high_water_mark;
+    stats.delivered = _delivered;
+    stats.dropped = _dropped;
+    return stats;
+}
+
+bool NotificationQueue::_try_push(ByteArray& payload) {
+    size_t position = _tail.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = _slots[position & _mask];
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+        if (difference == 0) {
+            if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.payload = std::move(payload);
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = _tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool NotificationQueue::_try_pop(ByteArray& payload) {
+    size_t position = _head.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = _slots[position & _mask];
+        const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+        if (difference == 0) {
+            if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                payload = std::move(slot.payload);
+                slot.sequence.store(position + _slots.size(), std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = _head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void NotificationQueue::_wake_producer() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_producers_waiting.load(std::memory_order_relaxed) > 0) {
+        std::scoped_lock lock(_producer_mutex);
+        _producer_cv.notify_one();
+    }
+}
+
+void NotificationQueue::_schedule() {
+    // Only one worker drains a queue at a time, whoever flips the flag hands it to the dispatcher.
+    // Pairs with the fence in _drain, so that the worker either sees the payload or is scheduled again.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!_scheduled.exchange(true, std::memory_order_acq_rel)) {
+        NotificationDispatcher::get().schedule(shared_from_this());
+    }
+}
+
+bool NotificationQueue::_drain() {
+    {
+        std::scoped_lock lock(_drain_mutex);
+        _draining = std::this_thread::get_id();
+    }
+    const bool pending = _drain_batch();
+    {
+        std::scoped_lock lock(_drain_mutex);
+        _draining = std::thread::id();
+    }
+    _drain_cv.notify_all();
+    return pending;
+}
+
+bool NotificationQueue::_drain_batch() {
+    while (true) {
+        ByteArray payload;
+        size_t delivered = 0;
+        while (delivered < DRAIN_BATCH_SIZE && !_closed && _try_pop(payload)) {
+            if (_overflow == NotificationDelivery::OverflowPolicy::BLOCK) _wake_producer();
+            _delivered++;
+            delivered++;
+            SAFE_CALLBACK_CALL(_callback, std::move(payload));
+        }
+        if (delivered == DRAIN_BATCH_SIZE) return true;
+
+        // Payloads pushed after the ring looked empty must not be left behind, so the queue is checked
+        // again once it can be scheduled by the producer.
+        _scheduled.store(false, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_closed || _tail.load(std::memory_order_relaxed) == _head.load(std::memory_order_relaxed)) return false;
+        if (_scheduled.exchange(true, std::memory_order_acq_rel)) return false;
+        std::this_thread::yield();
+    }
+}
+
+NotificationDispatcher& NotificationDispatcher::get() {
+    static NotificationDispatcher dispatcher(std::max<size_t>(Config::Base::notification_workers, 1));
+    return dispatcher;
+}
+
+NotificationDispatcher::NotificationDispatcher(size_t worker_count) {
+    for (size_t i = 0; i < worker_count; i++) {
+        _workers.emplace_back(&NotificationDispatcher::_run, this);
+    }
+}
+
+NotificationDispatcher::~NotificationDispatcher() {
+    {
+        std::scoped_lock lock(_mutex);
+        _stop = true;
+    }
+    _cv.notify_all();
+
+    for (auto& worker : _workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void NotificationDispatcher::schedule(std::shared_ptr<NotificationQueue> queue) {
+    {
+        std::scoped_lock lock(_mutex);
+        _ready.push_back(std::move(queue));
+    }
+    _cv.notify_one();
+}
+
+void NotificationDispatcher::_run() {
+    std::unique_lock lock(_mutex);
+    while (true) {
+        _cv.wait(lock, [this] { return _stop || !_ready.empty(); });
+        if (_stop) break;
+
+        auto queue = std::move(_ready.front());
+        _ready.pop_front();
+
+        lock.unlock();
+        const bool pending = queue->_drain();
+        lock.lock();
+
+        // Queues that still have payloads go to the back, behind the other subscriptions.
+        if (pending) _ready.push_back(std::move(queue));
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <simpleble/Types.h>
+
+namespace SimpleBLE {
+
+/**
+ * Bounded ring of the payloads of a subscription with queued delivery.
+ *
+ * The thread of the backend fills the ring without taking any lock, and a notification worker drains it,
+ * one worker at a time so that payloads are delivered in order. Slots carry a sequence number that tells
+ * whether they are free or filled, which also lets the producer discard the oldest payload by itself
+ * when the overflow policy is OVERWRITE_OLDEST. A push still takes the lock of the dispatcher when it
+ * hands an idle queue over to the workers, which happens once per drained batch rather than per payload.
+ * Only the BLOCK policy parks the producer, and only while the ring is full.
+ */
+class NotificationQueue : public std::enable_shared_from_this<NotificationQueue> {
+  public:
+    NotificationQueue(std::function<void(ByteArray payload)> callback, const NotificationDelivery& delivery);
+
+    NotificationQueue(const NotificationQueue&) = delete;
+    NotificationQueue& operator=(const NotificationQueue&) = delete;
+
+    // Safe to call from any thread. With OVERWRITE_OLDEST, the producer discards the oldest payload itself,
+    // concurrently with the worker draining the ring.
+    void push(ByteArray payload);
+
+    /**
+     * Stops delivering, discarding whatever is still queued, and waits for a callback in progress to return
+     * so that none runs once this returns. Called from within the callback, it only stops the delivery.
+     */
+    void close();
+
+    NotificationStats stats() const;
+
+  private:
+    friend class NotificationDispatcher;
+
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        ByteArray payload;
+    };
+
+    bool _try_push(ByteArray& payload);
+    bool _try_pop(ByteArray& payload);
+    void _wake_producer();
+    void _schedule();
+
+    // Delivers queued payloads, returns whether it stopped early and the queue needs to be scheduled again.
+    bool _drain();
+    bool _drain_batch();
+
+    std::function<void(ByteArray payload)> _callback;
+    NotificationDelivery::OverflowPolicy _overflow;
+    std::vector<Slot> _slots;
+    size_t _mask;
+
+    alignas(64) std::atomic<size_t> _head{0};
+    alignas(64) std::atomic<size_t> _tail{0};
+
+    std::atomic_bool _scheduled{false};
+    std::atomic_bool _closed{false};
+
+    std::atomic<uint64_t> _delivered{0};
+    std::atomic<uint64_t> _dropped{0};
+    std::atomic<size_t> _high_water_mark{0};
+
+    std::atomic<size_t> _producers_waiting{0};
+    std::mutex _producer_mutex;
+    std::condition_variable _producer_cv;
+
+    // Thread running _drain, if any, so that close() can wait for it.
+    std::thread::id _draining;
+    std::mutex _drain_mutex;
+    std::condition_variable _drain_cv;
+};
+
+/**
+ * Pool of worker threads draining the queues that have payloads pending.
+ *
+ * Started on first use with Config::Base::notification_workers threads, and shared by all subscriptions.
+ */
+class NotificationDispatcher {
+  public:
+    static NotificationDispatcher& get();
+    ~NotificationDispatcher();
+
+    NotificationDispatcher(const NotificationDispatcher&) = delete;
+    NotificationDispatcher& operator=(const NotificationDispatcher&) = delete;
+
+    void schedule(std::shared_ptr<NotificationQueue> queue);
+
+  private:
+    explicit NotificationDispatcher(size_t worker_count);
+
+    void _run();
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _stop = false;
+    std::deque<std::shared_ptr<NotificationQueue>> _ready;
+    std::vector<std::thread> _workers;
+};
+
+}  // namespace SimpleBLE
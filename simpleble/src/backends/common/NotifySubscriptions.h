@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace SimpleBLE {
+
+/**
+ * How each characteristic of a connection is subscribed to, for backends that have more than one way to do it.
+ *
+ * Every subscription gets a token, so that an event raised by a subscription which has since been replaced or
+ * removed, like the hangup of a socket that was already released, can be told apart from one of the current
+ * subscription. All methods are thread safe.
+ */
+template <typename Key, typename KeyHash = std::hash<Key>>
+class NotifySubscriptions {
+  public:
+    enum class Mode {
+        // Values are read from a socket handed out by the backend.
+        ACQUIRED,
+        // Values are delivered as property changes of the characteristic.
+        PROPERTIES,
+    };
+
+    using Token = uint64_t;
+
+    // Records a subscription, replacing any previous one to the same key.
+    Token subscribe(const Key& key, Mode mode) {
+        std::scoped_lock lock(_mutex);
+        const Token token = ++_last_token;
+        _subscriptions[key] = Subscription{mode, token};
+        return token;
+    }
+
+    // Switches an acquired subscription over to property changes. Returns false if the subscription identified by
+    // the token is no longer the current one or has already been switched, in which case nothing should be done.
+    bool fall_back(const Key& key, Token token) {
+        std::scoped_lock lock(_mutex);
+        auto it = _subscriptions.find(key);
+        if (it == _subscriptions.end() || it->second.token != token || it->second.mode != Mode::ACQUIRED) {
+            return false;
+        }
+        it->second.mode = Mode::PROPERTIES;
+        return true;
+    }
+
+    // Removes a subscription, returning how it was made so that it can be undone the same way.
+    std::optional<Mode> unsubscribe(const Key& key) {
+        std::scoped_lock lock(_mutex);
+        auto it = _subscriptions.find(key);
+        if (it == _subscriptions.end()) return std::nullopt;
+        const Mode mode = it->second.mode;
+        _subscriptions.erase(it);
+        return mode;
+    }
+
+    std::optional<Mode> mode(const Key& key) const {
+        std::scoped_lock lock(_mutex);
+        auto it = _subscriptions.find(key);
+        if (it == _subscriptions.end()) return std::nullopt;
+        return it->second.mode;
+    }
+
+    void clear() noexcept {
+        std::scoped_lock lock(_mutex);
+        _subscriptions.clear();
+    }
+
+  private:
+    struct Subscription {
+        Mode mode;
+        Token token;
+    };
+
+    mutable std::mutex _mutex;
+    std::unordered_map<Key, Subscription, KeyHash> _subscriptions;
+    Token _last_token = 0;
+};
+
+}  // namespace SimpleBLE
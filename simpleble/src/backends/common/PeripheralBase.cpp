@@ -0,0 +1,82 @@
+#include "PeripheralBase.h"
+
+#include "AsyncExecutor.h"
+#include "NotificationQueue.h"
+
+using namespace SimpleBLE;
+
+PeripheralBase::~PeripheralBase() {
+    // The backend might still hold the callbacks pushing into the queues, so they are closed explicitly.
+    for (auto& [key, queue] : notification_queues_) {
+        queue->close();
+    }
+}
+
+std::future<ByteArray> PeripheralBase::read_async(BluetoothUUID const& service, BluetoothUUID const& characteristic) {
+    return AsyncExecutor::get().submit(
+        [self = shared_from_this(), service, characteristic]() { return self->read(service, characteristic); });
+}
+
+std::future<void> PeripheralBase::write_request_async(BluetoothUUID const& service,
+                                                      BluetoothUUID const& characteristic, ByteArray const& data) {
+    return AsyncExecutor::get().submit([self = shared_from_this(), service, characteristic, data]() {
+        self->write_request(service, characteristic, data);
+    });
+}
+
+std::future<void> PeripheralBase::write_command_async(BluetoothUUID const& service,
+                                                      BluetoothUUID const& characteristic, ByteArray const& data) {
+    return AsyncExecutor::get().submit([self = shared_from_this(), service, characteristic, data]() {
+        self->write_command(service, characteristic, data);
+    });
+}
+
+void PeripheralBase::subscribe_queued(BluetoothUUID const& service, BluetoothUUID const& characteristic,
+                                      std::function<void(ByteArray payload)> callback,
+                                      const NotificationDelivery& delivery,
+                                      const std::function<void(std::function<void(ByteArray payload)>)>& subscribe) {
+    auto queue = std::make_shared<NotificationQueue>(std::move(callback), delivery);
+    try {
+        subscribe([queue](ByteArray payload) { queue->push(std::move(payload)); });
+    } catch (...) {
+        queue->close();
+        throw;
+    }
+
+    std::shared_ptr<NotificationQueue> previous_queue;
+    {
+        std::scoped_lock lock(notification_queues_mutex_);
+        auto& entry = notification_queues_[{service, characteristic}];
+        previous_queue = std::exchange(entry, queue);
+    }
+    if (previous_queue) previous_queue->close();
+}
+
+void PeripheralBase::release_notification_queue(BluetoothUUID const& service, BluetoothUUID const& characteristic) {
+    std::shared_ptr<NotificationQueue> queue;
+    {
+        std::scoped_lock lock(notification_queues_mutex_);
+        auto it = notification_queues_.find({service, characteristic});
+        if (it == notification_queues_.end()) return;
+        queue = std::move(it->second);
+        notification_queues_.erase(it);
+    }
+    queue->close();
+}
+
+NotificationStats PeripheralBase::notification_stats(BluetoothUUID const& service,
+                                                     BluetoothUUID const& characteristic) {
+    std::scoped_lock lock(notification_queues_mutex_);
+    auto it = notification_queues_.find({service, characteristic});
+    return it == notification_queues_.end() ? NotificationStats() : it->second->stats();
+}
+
+Metrics::Series PeripheralBase::metrics_series(std::string_view operation) {
+    std::scoped_lock lock(metrics_series_mutex_);
+    auto it = metrics_series_.find(operation);
+    if (it == metrics_series_.end()) {
+        Metrics::Series series({std::string(operation), adapter_identifier(), address()});
+        it = metrics_series_.emplace(std::string(operation), std::move(series)).first;
+    }
+    return it->second;
+}
@@ -1,14 +1,21 @@
 #pragma once
 
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include <simpleble/Metrics.h>
 #include <simpleble/Types.h>
 
 namespace SimpleBLE {
 
+class NotificationQueue;
 class ServiceBase;
 
 /**
@@ -18,9 +25,9 @@ class ServiceBase;
  *
  * Notes for implementers: ...
  */
-class PeripheralBase {
+class PeripheralBase : public std::enable_shared_from_this<PeripheralBase> {
   public:
-    virtual ~PeripheralBase() = default;
+    virtual ~PeripheralBase();
 
     virtual void* underlying() const = 0;
 
@@ -38,6 +45,13 @@ class PeripheralBase {
     virtual int16_t tx_power() = 0;
     virtual uint16_t mtu() = 0;
 
+    /**
+     * Identifier of the adapter the peripheral belongs to, used to key its metrics.
+     *
+     * Empty for backends that don't keep track of it.
+     */
+    virtual std::string adapter_identifier() { return ""; }
+
     virtual void connect() = 0;
     virtual void disconnect() = 0;
     virtual bool is_connected() = 0;
@@ -50,6 +64,18 @@ class PeripheralBase {
      */
     virtual std::vector<std::shared_ptr<ServiceBase>> available_services() = 0;
 
+    /**
+     * Immutable snapshot of the available services.
+     *
+     * Backends that know when their GATT database changes should override this with
+     * cached_services_snapshot(), so that all callers share a single snapshot instead of
+     * rebuilding the service tree on every call. The default implementation builds a new
+     * snapshot every time.
+     */
+    virtual std::shared_ptr<const std::vector<std::shared_ptr<ServiceBase>>> services_snapshot() {
+        return std::make_shared<const std::vector<std::shared_ptr<ServiceBase>>>(available_services());
+    }
+
     /**
      * Advertised services (if the peripheral is not connected).
      */
@@ -70,13 +96,70 @@ class PeripheralBase {
 
     virtual ByteArray read(BluetoothUUID const& service, BluetoothUUID const& characteristic, BluetoothUUID const& descriptor) = 0;
     virtual void write(BluetoothUUID const& service, BluetoothUUID const& characteristic, BluetoothUUID const& descriptor, ByteArray const& data) = 0;
+
+    /**
+     * Non-blocking variants of the operations above.
+     *
+     * Backends that can issue requests without parking a thread should override these.
+     * The default implementations run the blocking operation on the shared AsyncExecutor,
+     * keeping the peripheral alive until the operation has completed.
+     */
+    virtual std::future<ByteArray> read_async(BluetoothUUID const& service, BluetoothUUID const& characteristic);
+    virtual std::future<void> write_request_async(BluetoothUUID const& service, BluetoothUUID const& characteristic, ByteArray const& data);
+    virtual std::future<void> write_command_async(BluetoothUUID const& service, BluetoothUUID const& characteristic, ByteArray const& data);
     // clang-format on
 
     virtual void set_callback_on_connected(std::function<void()> on_connected) = 0;
     virtual void set_callback_on_disconnected(std::function<void()> on_disconnected) = 0;
 
+    /**
+     * Queued delivery of notifications, shared by all backends.
+     *
+     * Calls `subscribe` with a callback feeding a new queue, to be handed to the backend instead of the one
+     * of the user. The new queue only replaces the one the subscription had before once `subscribe` returned,
+     * and is closed if it threw.
+     */
+    void subscribe_queued(BluetoothUUID const& service, BluetoothUUID const& characteristic,
+                          std::function<void(ByteArray payload)> callback, const NotificationDelivery& delivery,
+                          const std::function<void(std::function<void(ByteArray payload)>)>& subscribe);
+    // Stops the queued delivery of a subscription, if it has one.
+    void release_notification_queue(BluetoothUUID const& service, BluetoothUUID const& characteristic);
+    NotificationStats notification_stats(BluetoothUUID const& service, BluetoothUUID const& characteristic);
+
+    // Metrics series of an operation of this peripheral, keyed the first time it is asked for.
+    Metrics::Series metrics_series(std::string_view operation);
+
   protected:
     PeripheralBase() = default;
+
+    /**
+     * Returns the cached snapshot of available_services(), building it on first use.
+     *
+     * Backends using it must call invalidate_services_snapshot() whenever the GATT database
+     * changes, at the very least when connecting and disconnecting.
+     */
+    std::shared_ptr<const std::vector<std::shared_ptr<ServiceBase>>> cached_services_snapshot() {
+        std::scoped_lock lock(services_snapshot_mutex_);
+        if (!services_snapshot_) {
+            services_snapshot_ = std::make_shared<const std::vector<std::shared_ptr<ServiceBase>>>(available_services());
+        }
+        return services_snapshot_;
+    }
+
+    void invalidate_services_snapshot() noexcept {
+        std::scoped_lock lock(services_snapshot_mutex_);
+        services_snapshot_.reset();
+    }
+
+  private:
+    std::mutex services_snapshot_mutex_;
+    std::shared_ptr<const std::vector<std::shared_ptr<ServiceBase>>> services_snapshot_;
+
+    std::mutex notification_queues_mutex_;
+    std::map<std::pair<BluetoothUUID, BluetoothUUID>, std::shared_ptr<NotificationQueue>> notification_queues_;
+
+    std::mutex metrics_series_mutex_;
+    std::map<std::string, Metrics::Series, std::less<>> metrics_series_;
 };
 
 }  // namespace SimpleBLE
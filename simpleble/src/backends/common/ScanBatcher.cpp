@@ -0,0 +1,72 @@
+#include "ScanBatcher.h"
+
+#include "BuilderBase.h"
+#include "CommonUtils.h"
+#include "PeripheralBase.h"
+
+using namespace SimpleBLE;
+
+ScanBatcher::ScanBatcher(std::function<void(std::vector<Peripheral>)> callback, std::chrono::milliseconds interval)
+    : _state(std::make_shared<State>()) {
+    _state->callback = std::move(callback);
+    _state->interval = interval;
+    _thread = std::thread(&ScanBatcher::_run, _state);
+}
+
+ScanBatcher::~ScanBatcher() {
+    {
+        std::scoped_lock lock(_state->mutex);
+        _state->stop = true;
+    }
+    _state->cv.notify_all();
+
+    // The batcher might be replaced from within its own callback, in which case
+    // the worker can't be joined and will exit on its own once the callback returns.
+    if (_thread.get_id() == std::this_thread::get_id()) {
+        _thread.detach();
+    } else if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void ScanBatcher::push(Peripheral peripheral) {
+    const PeripheralBase* key = &Factory::get_internal<PeripheralBase>(peripheral);
+
+    bool first_in_batch = false;
+    {
+        std::scoped_lock lock(_state->mutex);
+        auto it = _state->pending_index.find(key);
+        if (it != _state->pending_index.end()) {
+            _state->pending[it->second] = std::move(peripheral);
+            return;
+        }
+
+        first_in_batch = _state->pending.empty();
+        _state->pending_index.emplace(key, _state->pending.size());
+        _state->pending.push_back(std::move(peripheral));
+    }
+
+    if (first_in_batch) {
+        _state->cv.notify_one();
+    }
+}
+
+void ScanBatcher::_run(std::shared_ptr<State> state) {
+    std::unique_lock lock(state->mutex);
+    while (true) {
+        state->cv.wait(lock, [&state] { return state->stop || !state->pending.empty(); });
+        if (state->stop) break;
+
+        // Keep collecting updates until the window of the first pending one closes.
+        state->cv.wait_for(lock, state->interval, [&state] { return state->stop; });
+        if (state->stop) break;
+
+        std::vector<Peripheral> batch;
+        batch.swap(state->pending);
+        state->pending_index.clear();
+
+        lock.unlock();
+        SAFE_CALLBACK_CALL(state->callback, std::move(batch));
+        lock.lock();
+    }
+}
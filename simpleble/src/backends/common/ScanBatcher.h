@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <simpleble/Peripheral.h>
+
+namespace SimpleBLE {
+
+class PeripheralBase;
+
+/**
+ * Coalesces scan results per peripheral and delivers them in batches.
+ *
+ * Updates pushed within the same interval are merged, so that each peripheral
+ * appears at most once per batch. Batches are delivered from a dedicated worker
+ * thread, which guarantees that the backend thread pushing the updates is never
+ * blocked by user code.
+ */
+class ScanBatcher {
+  public:
+    ScanBatcher(std::function<void(std::vector<Peripheral>)> callback, std::chrono::milliseconds interval);
+    ~ScanBatcher();
+
+    ScanBatcher(const ScanBatcher&) = delete;
+    ScanBatcher& operator=(const ScanBatcher&) = delete;
+
+    void push(Peripheral peripheral);
+
+  private:
+    // Shared with the worker thread, so that it can outlive the batcher if needed.
+    struct State {
+        std::function<void(std::vector<Peripheral>)> callback;
+        std::chrono::milliseconds interval;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool stop = false;
+
+        std::vector<Peripheral> pending;
+        std::unordered_map<const PeripheralBase*, size_t> pending_index;
+    };
+
+    static void _run(std::shared_ptr<State> state);
+
+    std::shared_ptr<State> _state;
+    std::thread _thread;
+};
+
+}  // namespace SimpleBLE
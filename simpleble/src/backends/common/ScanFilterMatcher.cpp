@@ -0,0 +1,262 @@
+#include "ScanFilterMatcher.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+using namespace SimpleBLE;
+
+namespace {
+
+constexpr uint16_t APPLE_COMPANY_ID = 0x004C;
+// Beacon type and length bytes, followed by a 16 byte UUID, major, minor and measured power.
+constexpr size_t IBEACON_LENGTH = 23;
+constexpr uint16_t EDDYSTONE_UUID16 = 0xFEAA;
+
+constexpr uint32_t beacon_bit(ScanFilter::BeaconType type) { return 1u << static_cast<uint32_t>(type); }
+
+// Loads up to eight bytes into a word, zero-filling whatever lies past the end of the data.
+uint64_t load_word(const uint8_t* data, size_t available) {
+    uint64_t word = 0;
+    std::memcpy(&word, data, std::min(available, sizeof(word)));
+    return word;
+}
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Parses a MAC address written as six hex pairs, or nothing for other forms such as the UUIDs used on Apple platforms.
+std::optional<uint64_t> parse_mac_address(std::string_view address) {
+    if (address.size() != 17) return std::nullopt;
+
+    uint64_t value = 0;
+    for (size_t i = 0; i < address.size(); i++) {
+        if (i % 3 == 2) {
+            if (address[i] != ':' && address[i] != '-') return std::nullopt;
+            continue;
+        }
+
+        const int nibble = hex_value(address[i]);
+        if (nibble < 0) return std::nullopt;
+        value = (value << 4) | static_cast<uint64_t>(nibble);
+    }
+    return value;
+}
+
+bool equal_ignoring_case(char a, char b) {
+    return std::toupper(static_cast<unsigned char>(a)) == std::toupper(static_cast<unsigned char>(b));
+}
+
+}  // namespace
+
+ScanFilterMatcher::ScanFilterMatcher(ScanFilter filter) : _filter(std::move(filter)) {
+    _service_uuids.reserve(_filter.service_uuids.size());
+    for (const auto& uuid : _filter.service_uuids) {
+        _service_uuids.emplace_back(uuid);
+    }
+    std::sort(_service_uuids.begin(), _service_uuids.end());
+
+    for (const auto& manufacturer_data : _filter.manufacturer_data) {
+        const size_t length = manufacturer_data.data.size();
+        if (!manufacturer_data.mask.empty() && manufacturer_data.mask.size() != length) {
+            throw std::invalid_argument("Manufacturer data mask must be as long as its data");
+        }
+
+        // Both buffers are padded to whole words, the padding of the mask keeps the bytes past the prefix out.
+        const size_t word_count = (length + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        std::vector<uint8_t> data(word_count * sizeof(uint64_t), 0);
+        std::vector<uint8_t> mask(word_count * sizeof(uint64_t), 0);
+        std::copy(manufacturer_data.data.data(), manufacturer_data.data.data() + length, data.begin());
+        if (manufacturer_data.mask.empty()) {
+            std::fill_n(mask.begin(), length, 0xFF);
+        } else {
+            std::copy(manufacturer_data.mask.data(), manufacturer_data.mask.data() + length, mask.begin());
+        }
+
+        ManufacturerDataMask compiled{manufacturer_data.company_id, length, {}, {}};
+        for (size_t offset = 0; offset < data.size(); offset += sizeof(uint64_t)) {
+            const uint64_t word_mask = load_word(mask.data() + offset, sizeof(uint64_t));
+            compiled.masks.push_back(word_mask);
+            compiled.values.push_back(load_word(data.data() + offset, sizeof(uint64_t)) & word_mask);
+        }
+        _manufacturer_data.push_back(std::move(compiled));
+    }
+    std::stable_sort(_manufacturer_data.begin(), _manufacturer_data.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.company_id < rhs.company_id; });
+
+    if (!_filter.name_regex.empty()) {
+        try {
+            _name_regex.emplace(_filter.name_regex, std::regex::ECMAScript | std::regex::optimize);
+        } catch (const std::regex_error& e) {
+            throw std::invalid_argument("Invalid name regex: " + _filter.name_regex + " (" + e.what() + ")");
+        }
+    }
+
+    for (const auto& address : _filter.addresses) {
+        if (auto mac_address = parse_mac_address(address)) {
+            _addresses.push_back(*mac_address);
+        } else {
+            _other_addresses.push_back(address);
+        }
+    }
+    std::sort(_addresses.begin(), _addresses.end());
+
+    for (auto beacon_type : _filter.beacon_types) {
+        _beacon_types |= beacon_bit(beacon_type);
+    }
+}
+
+bool ScanFilterMatcher::matches_all() const {
+    return _service_uuids.empty() && !_filter.rssi_threshold && !_filter.pathloss_threshold &&
+           _filter.transport != ScanFilter::Transport::BREDR && _filter.pattern.empty() &&
+           _manufacturer_data.empty() && !_name_regex && _addresses.empty() && _other_addresses.empty() &&
+           _beacon_types == 0;
+}
+
+bool ScanFilterMatcher::matches(const Advertisement& advertisement) const {
+    // Backends that filter on the host only support LE.
+    if (_filter.transport == ScanFilter::Transport::BREDR) return false;
+
+    // Cheapest checks first, the regex is left for the advertisements that passed everything else.
+    return matches_address(advertisement.address) && matches_signal(advertisement.rssi, advertisement.tx_power) &&
+           matches_manufacturer_data(advertisement.manufacturer_data) &&
+           matches_beacons(advertisement.manufacturer_data, advertisement.service_data) &&
+           matches_services(advertisement.service_uuids, advertisement.service_data) &&
+           matches_pattern(advertisement.address, advertisement.name) && matches_name(advertisement.name);
+}
+
+bool ScanFilterMatcher::matches(const advertising_data_t& data) const {
+    return matches(Advertisement{data.mac_address, data.identifier, data.rssi, data.tx_power, data.manufacturer_data,
+                                 data.service_data, data.service_uuids});
+}
+
+bool ScanFilterMatcher::matches_signal(int16_t rssi, int16_t tx_power) const {
+    if (_filter.rssi_threshold && rssi < *_filter.rssi_threshold) return false;
+
+    if (_filter.pathloss_threshold) {
+        // The pathloss can't be known for peripherals that don't advertise their TX power.
+        if (tx_power == std::numeric_limits<int16_t>::min()) return false;
+        if (tx_power - rssi > *_filter.pathloss_threshold) return false;
+    }
+
+    return true;
+}
+
+bool ScanFilterMatcher::matches_services(const std::vector<BluetoothUUID>& service_uuids,
+                                         const std::map<BluetoothUUID, ByteArray>& service_data) const {
+    if (_service_uuids.empty()) return true;
+
+    auto is_filtered = [this](const BluetoothUUID& uuid) {
+        auto parsed = BluetoothUUID128::parse(uuid);
+        return parsed && std::binary_search(_service_uuids.begin(), _service_uuids.end(), *parsed);
+    };
+
+    // A service can be advertised through the UUID lists, through its service data, or both.
+    for (const auto& uuid : service_uuids) {
+        if (is_filtered(uuid)) return true;
+    }
+    for (const auto& [uuid, data] : service_data) {
+        if (is_filtered(uuid)) return true;
+    }
+    return false;
+}
+
+bool ScanFilterMatcher::matches_pattern(const BluetoothAddress& address, const std::string& name) const {
+    const auto& pattern = _filter.pattern;
+    if (pattern.empty()) return true;
+
+    // Addresses are compared regardless of case, names as they are, both by prefix.
+    const bool address_matches = address.size() >= pattern.size() &&
+                                 std::equal(pattern.begin(), pattern.end(), address.begin(), equal_ignoring_case);
+    return address_matches || name.compare(0, pattern.size(), pattern) == 0;
+}
+
+bool ScanFilterMatcher::matches_manufacturer_data(const std::map<uint16_t, ByteArray>& manufacturer_data) const {
+    if (_manufacturer_data.empty()) return true;
+
+    for (const auto& [company_id, payload] : manufacturer_data) {
+        auto it = std::lower_bound(_manufacturer_data.begin(), _manufacturer_data.end(), company_id,
+                                   [](const ManufacturerDataMask& mask, uint16_t id) { return mask.company_id < id; });
+        for (; it != _manufacturer_data.end() && it->company_id == company_id; it++) {
+            if (it->matches(payload)) return true;
+        }
+    }
+    return false;
+}
+
+bool ScanFilterMatcher::matches_name(const std::string& name) const {
+    return !_name_regex || std::regex_search(name, *_name_regex);
+}
+
+bool ScanFilterMatcher::matches_address(const BluetoothAddress& address) const {
+    if (_addresses.empty() && _other_addresses.empty()) return true;
+
+    if (auto mac_address = parse_mac_address(address)) {
+        return std::binary_search(_addresses.begin(), _addresses.end(), *mac_address);
+    }
+
+    return std::any_of(_other_addresses.begin(), _other_addresses.end(), [&address](const BluetoothAddress& other) {
+        return other.size() == address.size() &&
+               std::equal(other.begin(), other.end(), address.begin(), equal_ignoring_case);
+    });
+}
+
+bool ScanFilterMatcher::matches_beacons(const std::map<uint16_t, ByteArray>& manufacturer_data,
+                                        const std::map<BluetoothUUID, ByteArray>& service_data) const {
+    if (_beacon_types == 0) return true;
+
+    if (_beacon_types & beacon_bit(ScanFilter::BeaconType::IBEACON)) {
+        auto it = manufacturer_data.find(APPLE_COMPANY_ID);
+        if (it != manufacturer_data.end() && it->second.size() >= IBEACON_LENGTH && it->second[0] == 0x02 &&
+            it->second[1] == 0x15) {
+            return true;
+        }
+    }
+
+    if ((_beacon_types & ~beacon_bit(ScanFilter::BeaconType::IBEACON)) == 0) return false;
+
+    for (const auto& [uuid, data] : service_data) {
+        if (data.empty()) continue;
+
+        auto parsed = BluetoothUUID128::parse(uuid);
+        if (!parsed || parsed->uuid16() != EDDYSTONE_UUID16) continue;
+
+        // The first byte of an Eddystone frame identifies its type.
+        std::optional<ScanFilter::BeaconType> frame_type;
+        switch (data[0]) {
+            case 0x00:
+                frame_type = ScanFilter::BeaconType::EDDYSTONE_UID;
+                break;
+            case 0x10:
+                frame_type = ScanFilter::BeaconType::EDDYSTONE_URL;
+                break;
+            case 0x20:
+                frame_type = ScanFilter::BeaconType::EDDYSTONE_TLM;
+                break;
+            case 0x30:
+                frame_type = ScanFilter::BeaconType::EDDYSTONE_EID;
+                break;
+        }
+        if (frame_type && (_beacon_types & beacon_bit(*frame_type))) return true;
+    }
+    return false;
+}
+
+bool ScanFilterMatcher::ManufacturerDataMask::matches(const ByteArray& payload) const {
+    if (payload.size() < length) return false;
+
+    // Compared a word at a time, the mask discards the bytes of the payload past the prefix.
+    const uint8_t* bytes = payload.data();
+    for (size_t i = 0; i < masks.size(); i++) {
+        const size_t offset = i * sizeof(uint64_t);
+        if ((load_word(bytes + offset, payload.size() - offset) & masks[i]) != values[i]) return false;
+    }
+    return true;
+}
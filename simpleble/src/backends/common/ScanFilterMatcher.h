@@ -0,0 +1,79 @@
+#pragma once
+
+#include <simpleble/Types.h>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "AdapterBaseTypes.h"
+
+namespace SimpleBLE {
+
+/**
+ * Host-side evaluation of a ScanFilter, for the criteria that backends can't apply natively.
+ *
+ * The filter is compiled once when constructed: UUIDs and addresses are parsed and sorted, manufacturer
+ * data is split into masked 64-bit words and the name regex is built, so that checking an advertisement
+ * doesn't allocate and can run on the raw advertising data before any peripheral is created for it.
+ */
+class ScanFilterMatcher {
+  public:
+    // Non-owning view of an advertisement, so that backends don't need to copy their data to check it.
+    struct Advertisement {
+        const BluetoothAddress& address;
+        const std::string& name;
+        int16_t rssi;
+        int16_t tx_power;
+        const std::map<uint16_t, ByteArray>& manufacturer_data;
+        const std::map<BluetoothUUID, ByteArray>& service_data;
+        const std::vector<BluetoothUUID>& service_uuids;
+    };
+
+    /**
+     * @throws std::invalid_argument if any of the service UUIDs or the name regex is not valid,
+     *         or if a manufacturer data mask doesn't have the same length as its data.
+     */
+    explicit ScanFilterMatcher(ScanFilter filter);
+
+    const ScanFilter& filter() const { return _filter; }
+
+    // Whether every advertisement passes the checks done on the host.
+    bool matches_all() const;
+    bool matches(const Advertisement& advertisement) const;
+    bool matches(const advertising_data_t& data) const;
+
+    bool matches_signal(int16_t rssi, int16_t tx_power) const;
+    bool matches_services(const std::vector<BluetoothUUID>& service_uuids,
+                          const std::map<BluetoothUUID, ByteArray>& service_data) const;
+    bool matches_pattern(const BluetoothAddress& address, const std::string& name) const;
+    bool matches_manufacturer_data(const std::map<uint16_t, ByteArray>& manufacturer_data) const;
+    bool matches_name(const std::string& name) const;
+    bool matches_address(const BluetoothAddress& address) const;
+    bool matches_beacons(const std::map<uint16_t, ByteArray>& manufacturer_data,
+                         const std::map<BluetoothUUID, ByteArray>& service_data) const;
+
+  private:
+    // Manufacturer data prefix, stored as native-endian words with the mask already applied to the value.
+    struct ManufacturerDataMask {
+        uint16_t company_id;
+        size_t length;
+        std::vector<uint64_t> values;
+        std::vector<uint64_t> masks;
+
+        bool matches(const ByteArray& payload) const;
+    };
+
+    ScanFilter _filter;
+    std::vector<BluetoothUUID128> _service_uuids;
+    std::vector<ManufacturerDataMask> _manufacturer_data;
+    std::optional<std::regex> _name_regex;
+    std::vector<uint64_t> _addresses;
+    std::vector<std::string> _other_addresses;
+    uint32_t _beacon_types = 0;
+};
+
+}  // namespace SimpleBLE
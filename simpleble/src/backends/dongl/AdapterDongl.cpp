@@ -183,13 +183,20 @@ void AdapterDongl::_on_simpleble_event(const simpleble_Event& event) {
                 data.manufacturer_data[event.evt.adv_evt.manufacturer_data[i].company_id] = manufacturer_data;
             }
 
-            // TODO: Implement service data extraction
-            // for (int i = 0; i < event.evt.adv_evt.service_data_count; i++) {
-            //     ByteArray service_data(event.evt.adv_evt.service_data[i].data.bytes,
-            //     event.evt.adv_evt.service_data[i].data.size);
-            //     data.service_data[BluetoothUUID(event.evt.adv_evt.service_data[i].uuid)] = service_data;
-            // }
+            for (int i = 0; i < event.evt.adv_evt.service_data_count; i++) {
+                const auto& entry = event.evt.adv_evt.service_data[i];
+                if (!entry.has_uuid || entry.uuid.which_uuid == 0) continue;
+                ByteArray service_data(entry.data.bytes, entry.data.size);
+                data.service_data[PeripheralDongl::_uuid_from_proto(entry.uuid).to_string()] = service_data;
+            }
+
+            // The dongle reports every advertisement, so the scan filter is applied before any peripheral is created.
+            // Its firmware doesn't report the advertised UUID lists, so service UUIDs are matched on service data only.
+            if (!_scan_filter_accepts(data)) {
+                break;
+            }
 
+            _report_advertisement(data);
             _scan_received_callback(data);
             break;
         }
@@ -134,18 +134,21 @@ SharedPtrVector<ServiceBase> PeripheralDongl::available_services() {
         for (auto& characteristic : service.characteristics) {
             SharedPtrVector<DescriptorBase> descriptor_list;
             for (auto& descriptor : characteristic.descriptors) {
-                descriptor_list.push_back(std::make_shared<DescriptorBase>(descriptor.uuid));
+                descriptor_list.push_back(std::make_shared<DescriptorBase>(descriptor.uuid.to_string()));
             }
-            characteristic_list.push_back(std::make_shared<CharacteristicBase>(
-                characteristic.uuid, descriptor_list, characteristic.can_read, characteristic.can_write_request,
-                characteristic.can_write_command, characteristic.can_notify, characteristic.can_indicate));
+            characteristic_list.push_back(std::make_shared<CharacteristicBase>(characteristic.uuid.to_string(),
+                                                                               descriptor_list, characteristic.properties));
         }
-        service_list.push_back(std::make_shared<ServiceBase>(service.uuid, characteristic_list));
+        service_list.push_back(std::make_shared<ServiceBase>(service.uuid.to_string(), characteristic_list));
     }
 
     return service_list;
 }
 
+std::shared_ptr<const SharedPtrVector<ServiceBase>> PeripheralDongl::services_snapshot() {
+    return cached_services_snapshot();
+}
+
 SharedPtrVector<ServiceBase> PeripheralDongl::advertised_services() {
     SharedPtrVector<ServiceBase> service_list;
     for (auto& [service_uuid, data] : _service_data) {
@@ -160,7 +163,7 @@ std::map<uint16_t, ByteArray> PeripheralDongl::manufacturer_data() { return _man
 ByteArray PeripheralDongl::read(BluetoothUUID const& service_uuid, BluetoothUUID const& characteristic_uuid) {
     auto& characteristic = _find_characteristic_from_uuid(service_uuid, characteristic_uuid);
 
-    if (!characteristic.can_read) {
+    if (!(characteristic.properties & CharacteristicProperty::READ)) {
         throw Exception::OperationFailed(fmt::format("Characteristic {} is not readable", characteristic_uuid));
     }
 
@@ -177,7 +180,7 @@ void PeripheralDongl::write_request(BluetoothUUID const& service_uuid, Bluetooth
                                     ByteArray const& data) {
     auto& characteristic = _find_characteristic_from_uuid(service_uuid, characteristic_uuid);
 
-    if (!characteristic.can_write_request) {
+    if (!(characteristic.properties & CharacteristicProperty::WRITE_REQUEST)) {
         throw Exception::OperationFailed(fmt::format("Characteristic {} is not writable", characteristic_uuid));
     }
 
@@ -193,7 +196,7 @@ void PeripheralDongl::write_command(BluetoothUUID const& service_uuid, Bluetooth
                                     ByteArray const& data) {
     auto& characteristic = _find_characteristic_from_uuid(service_uuid, characteristic_uuid);
 
-    if (!characteristic.can_write_command) {
+    if (!(characteristic.properties & CharacteristicProperty::WRITE_COMMAND)) {
         throw Exception::OperationFailed(fmt::format("Characteristic {} is not writable", characteristic_uuid));
     }
 
@@ -205,11 +208,60 @@ void PeripheralDongl::write_command(BluetoothUUID const& service_uuid, Bluetooth
     }
 }
 
+std::future<ByteArray> PeripheralDongl::read_async(BluetoothUUID const& service_uuid,
+                                                   BluetoothUUID const& characteristic_uuid) {
+    auto& characteristic = _find_characteristic_from_uuid(service_uuid, characteristic_uuid);
+
+    if (!(characteristic.properties & CharacteristicProperty::READ)) {
+        throw Exception::OperationFailed(fmt::format("Characteristic {} is not readable", characteristic_uuid));
+    }
+
+    // The request is pipelined with the ones of other operations, without a thread waiting for its response.
+    auto promise = std::make_shared<std::promise<ByteArray>>();
+    _serial_protocol->simpleble_read_async(
+        _conn_handle, characteristic.handle_value,
+        [promise, characteristic_uuid](const simpleble_ReadRsp& rsp, std::exception_ptr error) {
+            if (error) {
+                promise->set_exception(error);
+            } else if (rsp.ret_code != 0) {
+                promise->set_exception(std::make_exception_ptr(Exception::OperationFailed(fmt::format(
+                    "Failed to read characteristic {} - ret_code: {}", characteristic_uuid, rsp.ret_code))));
+            } else {
+                promise->set_value(ByteArray(rsp.data.bytes, rsp.data.size));
+            }
+        });
+    return promise->get_future();
+}
+
+std::future<void> PeripheralDongl::write_request_async(BluetoothUUID const& service_uuid,
+                                                       BluetoothUUID const& characteristic_uuid,
+                                                       ByteArray const& data) {
+    auto& characteristic = _find_characteristic_from_uuid(service_uuid, characteristic_uuid);
+
+    if (!(characteristic.properties & CharacteristicProperty::WRITE_REQUEST)) {
+        throw Exception::OperationFailed(fmt::format("Characteristic {} is not writable", characteristic_uuid));
+    }
+
+    return _write_async(characteristic_uuid, characteristic.handle_value, simpleble_WriteOperation_WRITE_REQ, data);
+}
+
+std::future<void> PeripheralDongl::write_command_async(BluetoothUUID const& service_uuid,
+                                                       BluetoothUUID const& characteristic_uuid,
+                                                       ByteArray const& data) {
+    auto& characteristic = _find_characteristic_from_uuid(service_uuid, characteristic_uuid);
+
+    if (!(characteristic.properties & CharacteristicProperty::WRITE_COMMAND)) {
+        throw Exception::OperationFailed(fmt::format("Characteristic {} is not writable", characteristic_uuid));
+    }
+
+    return _write_async(characteristic_uuid, characteristic.handle_value, simpleble_WriteOperation_WRITE_CMD, data);
+}
+
 void PeripheralDongl::notify(BluetoothUUID const& service_uuid, BluetoothUUID const& characteristic_uuid,
                              std::function<void(ByteArray payload)> callback) {
     auto& characteristic = _find_characteristic_from_uuid(service_uuid, characteristic_uuid);
 
-    if (!characteristic.can_notify) {
+    if (!(characteristic.properties & CharacteristicProperty::NOTIFY)) {
         throw Exception::OperationFailed(fmt::format("Characteristic {} is not notifyable", characteristic_uuid));
     }
 
@@ -232,7 +284,7 @@ void PeripheralDongl::indicate(BluetoothUUID const& service_uuid, BluetoothUUID
                                std::function<void(ByteArray payload)> callback) {
     auto& characteristic = _find_characteristic_from_uuid(service_uuid, characteristic_uuid);
 
-    if (!characteristic.can_indicate) {
+    if (!(characteristic.properties & CharacteristicProperty::INDICATE)) {
         throw Exception::OperationFailed(fmt::format("Characteristic {} is not indicateable", characteristic_uuid));
     }
 
@@ -321,6 +373,7 @@ bool PeripheralDongl::_attempt_connect() {
 
     _conn_handle = BLE_CONN_HANDLE_INVALID;
     _services.clear();
+    invalidate_services_snapshot();
     _attributes_discovered.store(false, std::memory_order_relaxed);
 
     auto response = _serial_protocol->simpleble_connect(static_cast<simpleble_BluetoothAddressType>(_address_type),
@@ -370,7 +423,7 @@ bool PeripheralDongl::_attempt_connect() {
     // Retrieve any missing 128-bit UUIDs.
     for (auto& service : _services) {
         // Fetch the service UUID if missing.
-        if (service.uuid.empty()) {
+        if (service.uuid.is_nil()) {
             simpleble_ReadRsp rsp = _serial_protocol->simpleble_read(_conn_handle, service.start_handle);
             if (rsp.ret_code != 0) {
                 SIMPLEBLE_LOG_ERROR(fmt::format("Failed to read UUID for service {} - ret_code: {}",
@@ -394,7 +447,7 @@ bool PeripheralDongl::_attempt_connect() {
 
         for (auto& characteristic : service.characteristics) {
             // Fetch the characteristic UUID if missing.
-            if (characteristic.uuid.empty()) {
+            if (characteristic.uuid.is_nil()) {
                 simpleble_ReadRsp rsp = _serial_protocol->simpleble_read(_conn_handle, characteristic.handle_decl);
                 if (rsp.ret_code != 0) {
                     SIMPLEBLE_LOG_ERROR(fmt::format("Failed to read UUID for characteristic {} - ret_code: {}",
@@ -414,6 +467,9 @@ bool PeripheralDongl::_attempt_connect() {
             }
         }
     }
+
+    // Any snapshot taken while the UUIDs were still being resolved is incomplete.
+    invalidate_services_snapshot();
     return true;
 }
 
@@ -424,6 +480,8 @@ void PeripheralDongl::notify_connected(uint16_t conn_handle) {
 
 void PeripheralDongl::notify_disconnected() {
     _conn_handle = BLE_CONN_HANDLE_INVALID;
+    // The GATT database may be different on the next connection.
+    invalidate_services_snapshot();
     disconnection_cv_.notify_all();
     attributes_discovered_cv_.notify_all();
 
@@ -432,7 +490,7 @@ void PeripheralDongl::notify_disconnected() {
 }
 
 void PeripheralDongl::notify_service_discovered(simpleble_ServiceDiscoveredEvt const& evt) {
-    BluetoothUUID uuid;
+    BluetoothUUID128 uuid;
     if (evt.has_uuid16) {
         uuid = _uuid_from_uuid16(evt.uuid16.uuid);
     }
@@ -447,7 +505,7 @@ void PeripheralDongl::notify_service_discovered(simpleble_ServiceDiscoveredEvt c
 void PeripheralDongl::notify_characteristic_discovered(simpleble_CharacteristicDiscoveredEvt const& evt) {
     auto& service = _find_service_from_handle(evt.handle_decl);
 
-    BluetoothUUID uuid;
+    BluetoothUUID128 uuid;
     if (evt.has_uuid16) {
         uuid = _uuid_from_uuid16(evt.uuid16.uuid);
     }
@@ -457,11 +515,7 @@ void PeripheralDongl::notify_characteristic_discovered(simpleble_CharacteristicD
         evt.handle_decl,
         evt.handle_value,
         0,
-        evt.props.read,
-        evt.props.write,
-        evt.props.write_wo_resp,
-        evt.props.notify,
-        evt.props.indicate,
+        _properties_from_props(evt.props),
     });
 }
 
@@ -595,6 +649,24 @@ void PeripheralDongl::notify_auth_key_request(simpleble_AuthKeyRequestEvt const&
         0ms);
 }
 
+std::future<void> PeripheralDongl::_write_async(BluetoothUUID const& characteristic_uuid, uint16_t handle,
+                                                simpleble_WriteOperation operation, ByteArray const& data) {
+    auto promise = std::make_shared<std::promise<void>>();
+    _serial_protocol->simpleble_write_async(
+        _conn_handle, handle, operation, data,
+        [promise, characteristic_uuid](const simpleble_WriteRsp& rsp, std::exception_ptr error) {
+            if (error) {
+                promise->set_exception(error);
+            } else if (rsp.ret_code != 0) {
+                promise->set_exception(std::make_exception_ptr(Exception::OperationFailed(fmt::format(
+                    "Failed to write characteristic {} - ret_code: {}", characteristic_uuid, rsp.ret_code))));
+            } else {
+                promise->set_value();
+            }
+        });
+    return promise->get_future();
+}
+
 void PeripheralDongl::_send_auth_key_reply(uint16_t conn_handle, uint32_t request_id, const std::vector<uint8_t>& key,
                                            bool accept) {
     try {
@@ -609,61 +681,42 @@ void PeripheralDongl::_send_auth_key_reply(uint16_t conn_handle, uint32_t reques
     }
 }
 
-BluetoothUUID PeripheralDongl::_uuid_from_uuid16(uint16_t uuid16) {
-    return BluetoothUUID(fmt::format("0000{:04X}-0000-1000-8000-00805F9B34FB", uuid16));
-}
-
-BluetoothUUID PeripheralDongl::_uuid_from_uuid32(uint32_t uuid32) {
-    return BluetoothUUID(fmt::format("{:08X}-0000-1000-8000-00805F9B34FB", uuid32));
-}
-
-BluetoothUUID PeripheralDongl::_uuid_from_uuid128(const uint8_t id[16]) {
-    std::string uuid_str;
-    uuid_str.reserve(36);  // Pre-allocate memory for the UUID string
+BluetoothUUID128 PeripheralDongl::_uuid_from_uuid16(uint16_t uuid16) { return BluetoothUUID128::from_uuid16(uuid16); }
 
-    uuid_str += fmt::format("{:02X}{:02X}{:02X}{:02X}", id[0], id[1], id[2], id[3]);
-    uuid_str += "-";
-    uuid_str += fmt::format("{:02X}{:02X}", id[4], id[5]);
-    uuid_str += "-";
-    uuid_str += fmt::format("{:02X}{:02X}", id[6], id[7]);
-    uuid_str += "-";
-    uuid_str += fmt::format("{:02X}{:02X}", id[8], id[9]);
-    uuid_str += "-";
-    uuid_str += fmt::format("{:02X}{:02X}{:02X}{:02X}{:02X}{:02X}", id[10], id[11], id[12], id[13], id[14], id[15]);
+BluetoothUUID128 PeripheralDongl::_uuid_from_uuid32(uint32_t uuid32) { return BluetoothUUID128::from_uuid32(uuid32); }
 
-    return BluetoothUUID(uuid_str);
+BluetoothUUID128 PeripheralDongl::_uuid_from_uuid128(const uint8_t id[16]) {
+    BluetoothUUID128::Bytes bytes;
+    std::copy(id, id + bytes.size(), bytes.begin());
+    return BluetoothUUID128(bytes);
 }
 
-BluetoothUUID PeripheralDongl::_uuid_from_proto(simpleble_UUID const& uuid) {
+BluetoothUUID128 PeripheralDongl::_uuid_from_proto(simpleble_UUID const& uuid) {
     switch (uuid.which_uuid) {
         case simpleble_UUID_uuid16_tag:
-            return BluetoothUUID(fmt::format("0000{:04X}-0000-1000-8000-00805F9B34FB", uuid.uuid.uuid16.uuid));
+            return _uuid_from_uuid16(uuid.uuid.uuid16.uuid);
         case simpleble_UUID_uuid32_tag:
-            return BluetoothUUID(fmt::format("{:08X}-0000-1000-8000-00805F9B34FB", uuid.uuid.uuid32.uuid));
-        case simpleble_UUID_uuid128_tag: {
-            const auto& bytes = uuid.uuid.uuid128.uuid;
-            std::string uuid_str;
-            uuid_str.reserve(36);  // Pre-allocate memory for the UUID string
-
-            uuid_str += fmt::format("{:02X}{:02X}{:02X}{:02X}", bytes[0], bytes[1], bytes[2], bytes[3]);
-            uuid_str += "-";
-            uuid_str += fmt::format("{:02X}{:02X}", bytes[4], bytes[5]);
-            uuid_str += "-";
-            uuid_str += fmt::format("{:02X}{:02X}", bytes[6], bytes[7]);
-            uuid_str += "-";
-            uuid_str += fmt::format("{:02X}{:02X}", bytes[8], bytes[9]);
-            uuid_str += "-";
-            uuid_str += fmt::format("{:02X}{:02X}{:02X}{:02X}{:02X}{:02X}", bytes[10], bytes[11], bytes[12], bytes[13],
-                                    bytes[14], bytes[15]);
-
-            return BluetoothUUID(uuid_str);
-        }
+            return _uuid_from_uuid32(uuid.uuid.uuid32.uuid);
+        case simpleble_UUID_uuid128_tag:
+            return _uuid_from_uuid128(uuid.uuid.uuid128.uuid);
     }
 
     // Should not be reached
     throw std::runtime_error(fmt::format("Unknown UUID type: {}", uuid.which_uuid));
 }
 
+CharacteristicProperties PeripheralDongl::_properties_from_props(simpleble_CharacteristicProperties const& props) {
+    CharacteristicProperties properties = CharacteristicProperty::NONE;
+    if (props.broadcast) properties |= CharacteristicProperty::BROADCAST;
+    if (props.read) properties |= CharacteristicProperty::READ;
+    if (props.write_wo_resp) properties |= CharacteristicProperty::WRITE_COMMAND;
+    if (props.write) properties |= CharacteristicProperty::WRITE_REQUEST;
+    if (props.notify) properties |= CharacteristicProperty::NOTIFY;
+    if (props.indicate) properties |= CharacteristicProperty::INDICATE;
+    if (props.auth_signed_wr) properties |= CharacteristicProperty::AUTHENTICATED_SIGNED_WRITES;
+    return properties;
+}
+
 PeripheralDongl::ServiceDefinition& PeripheralDongl::_find_service_from_handle(uint16_t handle) {
     for (auto& service : _services) {
         if (service.start_handle <= handle && service.end_handle >= handle) {
@@ -692,10 +745,17 @@ PeripheralDongl::CharacteristicDefinition& PeripheralDongl::_find_characteristic
 
 PeripheralDongl::CharacteristicDefinition& PeripheralDongl::_find_characteristic_from_uuid(
     BluetoothUUID const& service_uuid, BluetoothUUID const& characteristic_uuid) {
+    // Comparing binary UUIDs also makes the lookup independent of the case of the given strings.
+    auto service_key = BluetoothUUID128::parse(service_uuid);
+    auto characteristic_key = BluetoothUUID128::parse(characteristic_uuid);
+    if (!service_key || !characteristic_key) {
+        throw std::runtime_error(fmt::format("Characteristic {} not found", characteristic_uuid));
+    }
+
     for (auto& service : _services) {
-        if (service.uuid == service_uuid) {
+        if (service.uuid == *service_key) {
             for (auto& characteristic : service.characteristics) {
-                if (characteristic.uuid == characteristic_uuid) {
+                if (characteristic.uuid == *characteristic_key) {
                     return characteristic;
                 }
             }
@@ -11,6 +11,7 @@
 #include <kvn_safe_map.hpp>
 
 #include <atomic>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -47,6 +48,7 @@ class PeripheralDongl : public PeripheralBase {
     void set_numeric_comparison_callback(const std::function<bool(const std::string& passkey)>& callback);
 
     virtual std::vector<std::shared_ptr<ServiceBase>> available_services() override;
+    virtual std::shared_ptr<const std::vector<std::shared_ptr<ServiceBase>>> services_snapshot() override;
     virtual std::vector<std::shared_ptr<ServiceBase>> advertised_services() override;
 
     virtual std::map<uint16_t, ByteArray> manufacturer_data() override;
@@ -55,6 +57,9 @@ class PeripheralDongl : public PeripheralBase {
     virtual ByteArray read(BluetoothUUID const& service, BluetoothUUID const& characteristic) override;
     virtual void write_request(BluetoothUUID const& service, BluetoothUUID const& characteristic, ByteArray const& data) override;
     virtual void write_command(BluetoothUUID const& service, BluetoothUUID const& characteristic, ByteArray const& data) override;
+    virtual std::future<ByteArray> read_async(BluetoothUUID const& service, BluetoothUUID const& characteristic) override;
+    virtual std::future<void> write_request_async(BluetoothUUID const& service, BluetoothUUID const& characteristic, ByteArray const& data) override;
+    virtual std::future<void> write_command_async(BluetoothUUID const& service, BluetoothUUID const& characteristic, ByteArray const& data) override;
     virtual void notify(BluetoothUUID const& service, BluetoothUUID const& characteristic, std::function<void(ByteArray payload)> callback) override;
     virtual void indicate(BluetoothUUID const& service, BluetoothUUID const& characteristic, std::function<void(ByteArray payload)> callback) override;
     virtual void unsubscribe(BluetoothUUID const& service, BluetoothUUID const& characteristic) override;
@@ -84,42 +89,45 @@ class PeripheralDongl : public PeripheralBase {
     const uint16_t BLE_CONN_HANDLE_PENDING = 0xFFFE;
 
   private:
+    // Attribute UUIDs are kept in binary form, as that's how the dongle reports them.
     struct DescriptorDefinition {
-        BluetoothUUID uuid;
+        BluetoothUUID128 uuid;
         uint16_t handle;
     };
 
     struct CharacteristicDefinition {
-        BluetoothUUID uuid;
+        BluetoothUUID128 uuid;
         uint16_t handle_decl;
         uint16_t handle_value;
         uint16_t handle_cccd = 0;
-        bool can_read;
-        bool can_write_request;
-        bool can_write_command;
-        bool can_notify;
-        bool can_indicate;
+        CharacteristicProperties properties;
 
         std::vector<DescriptorDefinition> descriptors;
     };
 
     struct ServiceDefinition {
-        BluetoothUUID uuid;
+        BluetoothUUID128 uuid;
         uint16_t start_handle;
         uint16_t end_handle;
         std::vector<CharacteristicDefinition> characteristics;
     };
 
+    // The adapter decodes the UUIDs of advertised service data with the same helpers.
+    friend class AdapterDongl;
+
     bool _attempt_connect();
-    BluetoothUUID _uuid_from_uuid16(uint16_t uuid16);
-    BluetoothUUID _uuid_from_uuid32(uint32_t uuid32);
-    BluetoothUUID _uuid_from_uuid128(const uint8_t uuid[16]);
-    BluetoothUUID _uuid_from_proto(simpleble_UUID const& uuid);
+    static BluetoothUUID128 _uuid_from_uuid16(uint16_t uuid16);
+    static BluetoothUUID128 _uuid_from_uuid32(uint32_t uuid32);
+    static BluetoothUUID128 _uuid_from_uuid128(const uint8_t uuid[16]);
+    static BluetoothUUID128 _uuid_from_proto(simpleble_UUID const& uuid);
+    static CharacteristicProperties _properties_from_props(simpleble_CharacteristicProperties const& props);
 
     ServiceDefinition& _find_service_from_handle(uint16_t handle);
     CharacteristicDefinition& _find_characteristic_from_handle(uint16_t handle);
     CharacteristicDefinition& _find_characteristic_from_uuid(BluetoothUUID const& service,
                                                              BluetoothUUID const& characteristic);
+    std::future<void> _write_async(BluetoothUUID const& characteristic_uuid, uint16_t handle,
+                                   simpleble_WriteOperation operation, ByteArray const& data);
     void _send_auth_key_reply(uint16_t conn_handle, uint32_t request_id, const std::vector<uint8_t>& key, bool accept);
 
     uint16_t _conn_handle = BLE_CONN_HANDLE_INVALID;
@@ -138,6 +138,36 @@ simpleble_DisconnectRsp Protocol::simpleble_disconnect(uint16_t conn_handle) {
 }
 
 simpleble_ReadRsp Protocol::simpleble_read(uint16_t conn_handle, uint16_t handle) {
+    fmt::print("simpleble_read: conn_handle: {}, handle: {}\n", conn_handle, handle);
+    dongl_Response response = exchange(_read_command(conn_handle, handle));
+    fmt::print("simpleble_read: response: {}\n", response.rsp.simpleble.rsp.read.ret_code);
+    return response.rsp.simpleble.rsp.read;
+}
+
+void Protocol::simpleble_read_async(uint16_t conn_handle, uint16_t handle,
+                                    std::function<void(const simpleble_ReadRsp&, std::exception_ptr)> callback) {
+    exchange_async(_read_command(conn_handle, handle),
+                   [callback = std::move(callback)](const dongl_Response& response, std::exception_ptr error) {
+                       callback(response.rsp.simpleble.rsp.read, error);
+                   });
+}
+
+simpleble_WriteRsp Protocol::simpleble_write(uint16_t conn_handle, uint16_t handle, simpleble_WriteOperation operation,
+                                             const std::vector<uint8_t>& data) {
+    dongl_Response response = exchange(_write_command(conn_handle, handle, operation, data));
+    return response.rsp.simpleble.rsp.write;
+}
+
+void Protocol::simpleble_write_async(uint16_t conn_handle, uint16_t handle, simpleble_WriteOperation operation,
+                                     const std::vector<uint8_t>& data,
+                                     std::function<void(const simpleble_WriteRsp&, std::exception_ptr)> callback) {
+    exchange_async(_write_command(conn_handle, handle, operation, data),
+                   [callback = std::move(callback)](const dongl_Response& response, std::exception_ptr error) {
+                       callback(response.rsp.simpleble.rsp.write, error);
+                   });
+}
+
+dongl_Command Protocol::_read_command(uint16_t conn_handle, uint16_t handle) {
     dongl_Command command = dongl_Command_init_zero;
     command.which_cmd = dongl_Command_simpleble_tag;
     command.cmd.simpleble.which_cmd = simpleble_Command_read_tag;
@@ -145,15 +175,11 @@ simpleble_ReadRsp Protocol::simpleble_read(uint16_t conn_handle, uint16_t handle
     command.cmd.simpleble.cmd.read = read_cmd;
     command.cmd.simpleble.cmd.read.conn_handle = conn_handle;
     command.cmd.simpleble.cmd.read.handle = handle;
-
-    fmt::print("simpleble_read: conn_handle: {}, handle: {}\n", conn_handle, handle);
-    dongl_Response response = exchange(command);
-    fmt::print("simpleble_read: response: {}\n", response.rsp.simpleble.rsp.read.ret_code);
-    return response.rsp.simpleble.rsp.read;
+    return command;
 }
 
-simpleble_WriteRsp Protocol::simpleble_write(uint16_t conn_handle, uint16_t handle, simpleble_WriteOperation operation,
-                                             const std::vector<uint8_t>& data) {
+dongl_Command Protocol::_write_command(uint16_t conn_handle, uint16_t handle, simpleble_WriteOperation operation,
+                                       const std::vector<uint8_t>& data) {
     if (data.size() > sizeof(simpleble_WriteCmd_data_t::bytes)) {
         throw std::length_error("Payload exceeds maximum size of 512 bytes");
     }
@@ -168,9 +194,7 @@ simpleble_WriteRsp Protocol::simpleble_write(uint16_t conn_handle, uint16_t hand
     command.cmd.simpleble.cmd.write.op = operation;
     command.cmd.simpleble.cmd.write.data.size = data.size();
     memcpy(command.cmd.simpleble.cmd.write.data.bytes, data.data(), data.size());
-
-    dongl_Response response = exchange(command);
-    return response.rsp.simpleble.rsp.write;
+    return command;
 }
 
 simpleble_IsPairedRsp Protocol::simpleble_is_paired(simpleble_BluetoothAddressType address_type,
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <exception>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -34,6 +36,13 @@ class Protocol : public ProtocolBase {
     simpleble_DisconnectRsp simpleble_disconnect(uint16_t conn_handle);
     simpleble_ReadRsp simpleble_read(uint16_t conn_handle, uint16_t handle);
     simpleble_WriteRsp simpleble_write(uint16_t conn_handle, uint16_t handle, simpleble_WriteOperation operation, const std::vector<uint8_t>& data);
+
+    // Pipelined variants of read and write, the callback runs once the response arrives or the request fails.
+    void simpleble_read_async(uint16_t conn_handle, uint16_t handle,
+                              std::function<void(const simpleble_ReadRsp&, std::exception_ptr)> callback);
+    void simpleble_write_async(uint16_t conn_handle, uint16_t handle, simpleble_WriteOperation operation,
+                               const std::vector<uint8_t>& data,
+                               std::function<void(const simpleble_WriteRsp&, std::exception_ptr)> callback);
     simpleble_IsPairedRsp simpleble_is_paired(simpleble_BluetoothAddressType address_type,
                                               const std::string& address);
     simpleble_UnpairRsp simpleble_unpair(simpleble_BluetoothAddressType address_type, const std::string& address);
@@ -41,6 +50,11 @@ class Protocol : public ProtocolBase {
                                                        const std::vector<uint8_t>& key, bool accept);
     simpleble_GetPairedPeripheralRsp simpleble_get_paired_peripheral(uint16_t index);
     simpleble_GetPairedPeripheralCountRsp simpleble_get_paired_peripheral_count();
+
+  private:
+    static dongl_Command _read_command(uint16_t conn_handle, uint16_t handle);
+    static dongl_Command _write_command(uint16_t conn_handle, uint16_t handle, simpleble_WriteOperation operation,
+                                        const std::vector<uint8_t>& data);
 };
 
 }  // namespace Serial
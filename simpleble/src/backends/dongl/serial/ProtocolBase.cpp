@@ -6,14 +6,20 @@ using namespace SimpleBLE::Dongl::Serial;
 #include "nanopb/pb_encode.h"
 
 #include <fmt/core.h>
+#include <simpleble/Metrics.h>
+
+#include <algorithm>
+#include <optional>
 
 #include "LoggingInternal.h"
 
-ProtocolBase::ProtocolBase(const std::string& device_path) : _wire(std::make_unique<Wire>(device_path)) {
+ProtocolBase::ProtocolBase(const std::string& device_path) : ProtocolBase(std::make_unique<Wire>(device_path)) {}
+
+ProtocolBase::ProtocolBase(std::unique_ptr<Wire> wire) : _wire(std::move(wire)) {
     // Set up the Wire packet callback to handle incoming packets
-    _wire->set_packet_callback([this](const std::vector<uint8_t>& packet) {
+    _wire->set_packet_callback([this](const uint8_t* data, size_t length) {
         dongl_D2H d2h = dongl_D2H_init_zero;
-        pb_istream_t stream = pb_istream_from_buffer(packet.data(), packet.size());
+        pb_istream_t stream = pb_istream_from_buffer(data, length);
         if (!pb_decode(&stream, dongl_D2H_fields, &d2h)) {
             // TODO: Handle decoding failure
             fmt::print("Failed to decode D2H: {}\n", PB_GET_ERROR(&stream));
@@ -21,15 +27,7 @@ ProtocolBase::ProtocolBase(const std::string& device_path) : _wire(std::make_uni
         }
 
         if (d2h.which_type == dongl_D2H_rsp_tag) {
-            // First, try to fulfill any pending sync request
-            {
-                std::lock_guard<std::mutex> lock(_pending_mutex);
-                if (!_pending_response.has_value()) {
-                    _pending_response = d2h.type.rsp;
-                    _response_cv.notify_one();
-                }
-            }
-
+            _handle_response(d2h.type.rsp);
         } else if (d2h.which_type == dongl_D2H_evt_tag) {
             std::lock_guard<std::mutex> lock(_event_mutex);
             if (_event_callback) {
@@ -47,54 +45,172 @@ ProtocolBase::ProtocolBase(const std::string& device_path) : _wire(std::make_uni
     _wire->set_error_callback([this](const Wire::Error& error) {
         fmt::print("Error: {}\n", (int)error);
     });
+
+    _expiry_thread = std::thread(&ProtocolBase::_expiry_loop, this);
 }
 
 ProtocolBase::~ProtocolBase() {
+    {
+        std::lock_guard<std::mutex> lock(_pending_mutex);
+        _stopping = true;
+    }
+    _pending_cv.notify_all();
+    _expiry_thread.join();
+
     // The reader callback captures this object, so stop and join its thread
     // before the callback state and mutexes are destroyed.
     _wire.reset();
 }
 
 dongl_Response ProtocolBase::exchange(const dongl_Command& command) {
-    // The wire protocol has no transaction IDs, so serialize exchanges and
-    // discard any response that arrived after a previous timeout.
-    std::lock_guard<std::mutex> exchange_lock(_exchange_mutex);
+    std::optional<SimpleBLE::Metrics::Timer> timer;
+    if (SimpleBLE::Metrics::is_enabled()) timer.emplace(SimpleBLE::Metrics::Key{"dongl_exchange", "", ""});
+
+    // Pending requests are failed by the expiry thread once RESPONSE_TIMEOUT has passed,
+    // so the future is always resolved eventually.
+    return exchange_async(command).get();
+}
 
-    // Clear any previous response and send the command
+std::future<dongl_Response> ProtocolBase::exchange_async(const dongl_Command& command) {
+    auto promise = std::make_shared<std::promise<dongl_Response>>();
+    exchange_async(command, [promise](const dongl_Response& response, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(response);
+        }
+    });
+    return promise->get_future();
+}
+
+void ProtocolBase::exchange_async(const dongl_Command& command, ResponseCallback callback) {
+    std::lock_guard<std::mutex> send_lock(_send_mutex);
+
+    uint64_t id = 0;
     {
         std::unique_lock<std::mutex> lock(_pending_mutex);
-        _pending_response.reset();  // Ensure it's empty to indicate we're waiting
+        _pending_cv.wait(lock, [this]() { return _pending_requests.size() < MAX_PIPELINED_REQUESTS; });
+
+        // Register the request before sending it, as the response might arrive before send_packet returns.
+        id = _next_request_id++;
+        PendingRequest& request = _pending_requests.emplace_back();
+        request.id = id;
+        request.kind = _command_kind(command);
+        request.deadline = std::chrono::steady_clock::now() + RESPONSE_TIMEOUT;
+        request.callback = std::move(callback);
     }
+    _pending_cv.notify_all();
 
     try {
-        size_t command_size = 0;
-        pb_get_encoded_size(&command_size, dongl_Command_fields, &command);
-
-        std::vector<uint8_t> tx_buffer_raw(command_size);
-        pb_ostream_t stream = pb_ostream_from_buffer(tx_buffer_raw.data(), tx_buffer_raw.size());
-        bool status = pb_encode(&stream, dongl_Command_fields, &command);
-        if (!status) {
-            // TODO: Handle encoding failure
-            throw std::runtime_error("Failed to encode command");
+        // The command is encoded straight into the frame buffer of the wire.
+        _wire->send_packet_with([&command](uint8_t* payload, size_t capacity) {
+            pb_ostream_t stream = pb_ostream_from_buffer(payload, capacity);
+            if (!pb_encode(&stream, dongl_Command_fields, &command)) {
+                // TODO: Handle encoding failure
+                throw std::runtime_error("Failed to encode command");
+            }
+            return stream.bytes_written;
+        });
+    } catch (...) {
+        _cancel_pending(id);
+        throw;
+    }
+}
+
+ProtocolBase::Kind ProtocolBase::_command_kind(const dongl_Command& command) {
+    const pb_size_t inner = command.which_cmd == dongl_Command_basic_tag ? command.cmd.basic.which_cmd
+                                                                           : command.cmd.simpleble.which_cmd;
+    return (Kind(command.which_cmd) << 16) | inner;
+}
+
+ProtocolBase::Kind ProtocolBase::_response_kind(const dongl_Response& response) {
+    const pb_size_t inner = response.which_rsp == dongl_Response_basic_tag ? response.rsp.basic.which_rsp
+                                                                             : response.rsp.simpleble.which_rsp;
+    return (Kind(response.which_rsp) << 16) | inner;
+}
+
+void ProtocolBase::_handle_response(const dongl_Response& response) {
+    const Kind kind = _response_kind(response);
+    const auto now = std::chrono::steady_clock::now();
+    ResponseCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(_pending_mutex);
+
+        while (!_expired_requests.empty() && _expired_requests.front().forget_at <= now) {
+            _expired_requests.pop_front();
         }
 
-        _wire->send_packet(tx_buffer_raw);
-    } catch (const std::runtime_error& e) {
-        // If sending fails, no cleanup needed since we didn't set pending_response
-        throw;
+        // Responses arrive in the order the commands were sent, so a late response to an expired request
+        // comes ahead of those to pending requests. Expired requests that were answered by a response of
+        // another kind are assumed to never get theirs.
+        while (!_expired_requests.empty()) {
+            const bool late = _expired_requests.front().kind == kind;
+            _expired_requests.pop_front();
+            if (late) {
+                SIMPLEBLE_LOG_WARN("Dropping late response to an expired request");
+                return;
+            }
+        }
+
+        if (_pending_requests.empty() || _pending_requests.front().kind != kind) {
+            SIMPLEBLE_LOG_WARN(fmt::format("Dropping unexpected response of kind {:#x}", kind));
+            return;
+        }
+
+        callback = std::move(_pending_requests.front().callback);
+        _pending_requests.pop_front();
+    }
+    _pending_cv.notify_all();
+
+    // The callback runs outside of the lock, as it might issue the next request.
+    callback(response, nullptr);
+}
+
+std::vector<ProtocolBase::PendingRequest> ProtocolBase::_expire_pending(std::chrono::steady_clock::time_point now) {
+    // Requests are sent in order, so expired ones are always at the front.
+    std::vector<PendingRequest> expired;
+    while (!_pending_requests.empty() && _pending_requests.front().deadline <= now) {
+        _expired_requests.push_back({_pending_requests.front().kind, now + RESPONSE_TIMEOUT});
+        expired.push_back(std::move(_pending_requests.front()));
+        _pending_requests.pop_front();
+        SimpleBLE::Metrics::increment({"dongl_exchange_timeout", "", ""});
     }
+    return expired;
+}
 
-    // Wait for the response with 1 second timeout
+void ProtocolBase::_cancel_pending(uint64_t id) {
     {
-        std::unique_lock<std::mutex> lock(_pending_mutex);
-        if (_response_cv.wait_for(lock, std::chrono::seconds(1), [this]() { return _pending_response.has_value(); })) {
-            dongl_Response response = *_pending_response;
-            _pending_response.reset();
-            return response;
-        } else {
-            // Timeout occurred, reset pending state
-            _pending_response.reset();
-            throw std::runtime_error("Timeout waiting for response");
+        std::lock_guard<std::mutex> lock(_pending_mutex);
+        auto it = std::find_if(_pending_requests.begin(), _pending_requests.end(),
+                               [id](const PendingRequest& request) { return request.id == id; });
+        if (it != _pending_requests.end()) {
+            _pending_requests.erase(it);
+        }
+    }
+    _pending_cv.notify_all();
+}
+
+void ProtocolBase::_expiry_loop() {
+    std::unique_lock<std::mutex> lock(_pending_mutex);
+    while (!_stopping) {
+        if (_pending_requests.empty()) {
+            _pending_cv.wait(lock);
+            continue;
+        }
+
+        // Requests can be resolved or added while waiting, so the deadline is checked again on every wake up.
+        const auto deadline = _pending_requests.front().deadline;
+        _pending_cv.wait_until(lock, deadline);
+        auto expired = _expire_pending(std::chrono::steady_clock::now());
+        if (!expired.empty()) {
+            lock.unlock();
+            _pending_cv.notify_all();
+            const dongl_Response no_response = dongl_Response_init_zero;
+            for (auto& request : expired) {
+                request.callback(no_response,
+                                 std::make_exception_ptr(std::runtime_error("Timeout waiting for response")));
+            }
+            lock.lock();
         }
     }
 }
@@ -1,13 +1,17 @@
 #pragma once
 
-#include <functional>
-#include <memory>
-#include <optional>
-#include <vector>
-
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include "Wire.h"
 
@@ -20,19 +24,69 @@ namespace Serial {
 
 class ProtocolBase {
   public:
+    /**
+     * @brief Time after which a pending request is considered lost.
+     */
+    static constexpr std::chrono::milliseconds RESPONSE_TIMEOUT{1000};
+
+    /**
+     * @brief Number of requests that can be on the link before a response comes back.
+     */
+    static constexpr size_t MAX_PIPELINED_REQUESTS = 8;
+
+    /**
+     * @brief Callback receiving the response to a command, or the error that kept it from arriving.
+     *
+     * The response is only meaningful if error is null.
+     */
+    using ResponseCallback = std::function<void(const dongl_Response& response, std::exception_ptr error)>;
+
     ProtocolBase(const std::string& device_path);
+    ProtocolBase(std::unique_ptr<Wire> wire);
     ~ProtocolBase();
 
     /**
      * @brief Sends a command synchronously and waits for the response.
-     * Only one exchange can be pending at a time.
+     * Multiple exchanges from different threads can be in flight at the same time.
      *
      * @param command The command to send.
      * @return The response when it arrives.
-     * @throws std::runtime_error if another exchange is already pending or if timeout occurs.
+     * @throws std::runtime_error if sending fails or if timeout occurs.
      */
     dongl_Response exchange(const dongl_Command& command);
 
+    /**
+     * @brief Sends a command and returns immediately.
+     *
+     * Responses don't carry any request ID, but the dongle answers commands in the
+     * order it receives them. Requests are therefore sent in the order they are
+     * registered and matched to responses first in, first out. A response must also
+     * be of the kind of its command, otherwise it is dropped. Up to
+     * MAX_PIPELINED_REQUESTS requests can be in flight, beyond which this call waits
+     * for a response before sending.
+     *
+     * Requests that haven't been answered within RESPONSE_TIMEOUT are failed with
+     * std::runtime_error. Their response can still arrive late, ahead of the ones of
+     * later requests, in which case it is dropped.
+     *
+     * @param command The command to send.
+     * @return A future holding the response.
+     * @throws std::runtime_error if sending fails.
+     */
+    std::future<dongl_Response> exchange_async(const dongl_Command& command);
+
+    /**
+     * @brief Sends a command and returns immediately, like the variant returning a future.
+     *
+     * The callback runs on the thread that received the response, or on the one that
+     * expired the request, and must not block.
+     *
+     * @param command The command to send.
+     * @param callback Function to call once the response arrives or the request fails.
+     * @throws std::runtime_error if sending fails, in which case the callback is never called.
+     */
+    void exchange_async(const dongl_Command& command, ResponseCallback callback);
+
     /**
      * @brief Sets the callback for received events.
      *
@@ -41,14 +95,49 @@ class ProtocolBase {
     void set_event_callback(std::function<void(const dongl_Event&)> callback);
 
   private:
+    // Which command a response answers, as the tags of its message in the oneofs of dongl_Response.
+    // Commands and their responses share the same tags.
+    using Kind = uint32_t;
+
+    struct PendingRequest {
+        uint64_t id;
+        Kind kind;
+        std::chrono::steady_clock::time_point deadline;
+        ResponseCallback callback;
+    };
+
+    struct ExpiredRequest {
+        Kind kind;
+        // The response of an expired request is only waited for up to another RESPONSE_TIMEOUT.
+        std::chrono::steady_clock::time_point forget_at;
+    };
+
+    static Kind _command_kind(const dongl_Command& command);
+    static Kind _response_kind(const dongl_Response& response);
+
+    void _handle_response(const dongl_Response& response);
+    std::vector<PendingRequest> _expire_pending(std::chrono::steady_clock::time_point now);
+    void _cancel_pending(uint64_t id);
+    void _expiry_loop();
+
     std::unique_ptr<Wire> _wire;
     std::function<void(const dongl_Event&)> _event_callback;
     std::mutex _event_mutex;
 
-    std::optional<dongl_Response> _pending_response;
-    std::condition_variable _response_cv;
+    // Held from registering a request until it has been sent, so that requests are sent in the order
+    // in which they are registered.
+    std::mutex _send_mutex;
+
+    // Requests are kept in the order they were sent, which is also the order of their responses
+    // and of their deadlines.
+    std::deque<PendingRequest> _pending_requests;
+    std::deque<ExpiredRequest> _expired_requests;
+    uint64_t _next_request_id = 0;
     std::mutex _pending_mutex;
-    std::mutex _exchange_mutex;
+    std::condition_variable _pending_cv;
+
+    bool _stopping = false;
+    std::thread _expiry_thread;
 };
 
 }  // namespace Serial
@@ -1,13 +1,36 @@
 #include "Wire.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <kvn/kvn_bytearray.h>
 #include <fmt/core.h>
 
 using namespace SimpleBLE::Dongl::Serial;
 
-Wire::Wire(const std::string& device_path)
-    : _usb_helper(std::make_unique<USB::UsbHelper>(device_path))
+namespace {
+
+// CRC-16 with polynomial 0x8005, processed MSB first, one table lookup per byte.
+constexpr std::array<uint16_t, 256> make_crc16_table() {
+    std::array<uint16_t, 256> table{};
+    for (uint16_t i = 0; i < 256; i++) {
+        uint16_t crc = i << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x8005 : (crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<uint16_t, 256> CRC16_TABLE = make_crc16_table();
+
+}  // namespace
+
+Wire::Wire(const std::string& device_path) : Wire(std::make_unique<USB::UsbHelper>(device_path)) {}
+
+Wire::Wire(std::unique_ptr<USB::UsbHelper> usb_helper)
+    : _usb_helper(std::move(usb_helper))
     , _state(State::IDLE)
     , _length(0)
     , _checksum(0)
@@ -15,11 +38,7 @@ Wire::Wire(const std::string& device_path)
     , _buffer(MAX_PAYLOAD_SIZE) {
 
     // Set up the USB receive callback to process incoming bytes
-    _usb_helper->set_rx_callback([this](const kvn::bytearray& data) {
-        for (size_t i = 0; i < data.size(); ++i) {
-            process_byte(data[i]);
-        }
-    });
+    _usb_helper->set_rx_callback([this](const kvn::bytearray& data) { process(data.data(), data.size()); });
 }
 
 Wire::~Wire() {
@@ -33,26 +52,30 @@ void Wire::send_packet(const std::vector<uint8_t>& payload) {
 }
 
 void Wire::send_packet(const uint8_t* data, size_t length) {
+    send_packet_with([data, length](uint8_t* payload, size_t capacity) {
+        if (length > capacity) {
+            throw std::runtime_error("Payload length exceeds maximum allowed");
+        }
+        std::memcpy(payload, data, length);
+        return length;
+    });
+}
+
+void Wire::send_frame(size_t length) {
     if (length > MAX_PAYLOAD_SIZE) {
         throw std::runtime_error("Payload length exceeds maximum allowed");
     }
 
-    // Create the encoded packet
-    std::vector<uint8_t> packet;
-    packet.reserve(5 + length);  // sync + length(2) + payload + crc(2)
-
-    packet.push_back(SYNC_BYTE);
-    packet.push_back(length & 0xFF);
-    packet.push_back((length >> 8) & 0xFF);
-    packet.insert(packet.end(), data, data + length);
+    // sync + length(2) + payload + crc(2), with the payload already in place
+    _tx_frame[0] = SYNC_BYTE;
+    _tx_frame[1] = length & 0xFF;
+    _tx_frame[2] = (length >> 8) & 0xFF;
 
-    uint16_t crc = crc16(data, length);
-    packet.push_back(crc & 0xFF);
-    packet.push_back((crc >> 8) & 0xFF);
+    uint16_t crc = crc16(_tx_frame.data() + HEADER_SIZE, length);
+    _tx_frame[HEADER_SIZE + length] = crc & 0xFF;
+    _tx_frame[HEADER_SIZE + length + 1] = (crc >> 8) & 0xFF;
 
-    // Send via USB
-    kvn::bytearray usb_data(packet.data(), packet.size());
-    _usb_helper->tx(usb_data);
+    _usb_helper->tx(_tx_frame.data(), HEADER_SIZE + length + TRAILER_SIZE);
 }
 
 void Wire::set_packet_callback(PacketCallback callback) {
@@ -63,6 +86,53 @@ void Wire::set_error_callback(ErrorCallback callback) {
     _error_callback = std::move(callback);
 }
 
+void Wire::process(const uint8_t* data, size_t length) {
+    const uint8_t* end = data + length;
+
+    while (data < end) {
+        switch (_state) {
+            case State::IDLE: {
+                // Skip everything up to the next sync byte in one go.
+                auto sync = static_cast<const uint8_t*>(std::memchr(data, SYNC_BYTE, end - data));
+                if (sync == nullptr) return;
+
+                data = sync + 1;
+                _state = State::HEADER_LOW;
+                _buffer_index = 0;
+
+                // Fast path: the whole frame is available, so deliver it in place.
+                if (end - data >= 2) {
+                    uint16_t frame_length = data[0] | (uint16_t)data[1] << 8;
+                    if (frame_length <= MAX_PAYLOAD_SIZE && (size_t)(end - data) >= 4u + frame_length) {
+                        const uint8_t* payload = data + 2;
+                        uint16_t checksum = payload[frame_length] | (uint16_t)payload[frame_length + 1] << 8;
+                        data = payload + frame_length + 2;
+                        _state = State::IDLE;
+                        deliver(payload, frame_length, checksum);
+                    }
+                }
+                break;
+            }
+
+            case State::PAYLOAD: {
+                // Copy as much of the split payload as is available.
+                size_t count = std::min<size_t>(end - data, _length - _buffer_index);
+                std::memcpy(_buffer.data() + _buffer_index, data, count);
+                _buffer_index += count;
+                data += count;
+                if (_buffer_index == _length) {
+                    _state = State::CHECKSUM_LOW;
+                }
+                break;
+            }
+
+            default:
+                process_byte(*data++);
+                break;
+        }
+    }
+}
+
 void Wire::process_byte(uint8_t byte) {
     switch (_state) {
         case State::IDLE:
@@ -107,31 +177,26 @@ void Wire::process_byte(uint8_t byte) {
 
         case State::CHECKSUM_HIGH:
             _checksum |= (uint16_t)byte << 8;
-            uint16_t computed_crc = crc16(_buffer.data(), _length);
-            if (_checksum == computed_crc) {
-                if (_packet_callback) {
-                    std::vector<uint8_t> packet(_buffer.begin(), _buffer.begin() + _length);
-                    _packet_callback(packet);
-                }
-            } else if (_error_callback) {
-                _error_callback(Error::CRC_FAILURE);
-            }
             _state = State::IDLE;
+            deliver(_buffer.data(), _length, _checksum);
             break;
     }
 }
 
+void Wire::deliver(const uint8_t* payload, size_t length, uint16_t checksum) {
+    if (checksum == crc16(payload, length)) {
+        if (_packet_callback) {
+            _packet_callback(payload, length);
+        }
+    } else if (_error_callback) {
+        _error_callback(Error::CRC_FAILURE);
+    }
+}
+
 uint16_t Wire::crc16(const uint8_t* data, size_t len) {
     uint16_t crc = 0xFFFF;
     for (size_t i = 0; i < len; i++) {
-        crc ^= (uint16_t)data[i] << 8;
-        for (uint8_t bit = 0; bit < 8; bit++) {
-            if (crc & 0x8000) {
-                crc = (crc << 1) ^ 0x8005;
-            } else {
-                crc <<= 1;
-            }
-        }
+        crc = (crc << 8) ^ CRC16_TABLE[(crc >> 8) ^ data[i]];
     }
     return crc;
 }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "../usb/UsbHelper.h"
@@ -34,8 +38,11 @@ public:
 
     /**
      * @brief Callback function type for received packets.
+     *
+     * The payload is only valid for the duration of the call, as it points
+     * straight into the receive buffers.
      */
-    using PacketCallback = std::function<void(const std::vector<uint8_t>&)>;
+    using PacketCallback = std::function<void(const uint8_t* data, size_t length)>;
 
     /**
      * @brief Callback function type for errors.
@@ -52,7 +59,18 @@ public:
      */
     static constexpr uint8_t SYNC_BYTE = 0xAA;
 
+    /**
+     * @brief Size of the frame header (sync byte and length).
+     */
+    static constexpr size_t HEADER_SIZE = 3;
+
+    /**
+     * @brief Size of the frame trailer (CRC-16).
+     */
+    static constexpr size_t TRAILER_SIZE = 2;
+
     Wire(const std::string& device_path);
+    Wire(std::unique_ptr<USB::UsbHelper> usb_helper);
     ~Wire();
 
     /**
@@ -70,6 +88,23 @@ public:
      */
     void send_packet(const uint8_t* data, size_t length);
 
+    /**
+     * @brief Encodes a payload straight into the transmit frame and sends it.
+     *
+     * The encoder receives the payload area of a preallocated frame together with its
+     * capacity and returns the number of bytes it wrote. Header and CRC are filled in
+     * around it, so no intermediate buffers are allocated. Concurrent senders are
+     * serialized, as packets must not be interleaved on the wire.
+     *
+     * @param encoder Callable with signature size_t(uint8_t* payload, size_t capacity).
+     */
+    template <typename Encoder>
+    void send_packet_with(Encoder&& encoder) {
+        std::lock_guard<std::mutex> lock(_tx_mutex);
+        const size_t length = encoder(_tx_frame.data() + HEADER_SIZE, MAX_PAYLOAD_SIZE);
+        send_frame(length);
+    }
+
     /**
      * @brief Sets the callback for received packets.
      *
@@ -84,6 +119,26 @@ public:
      */
     void set_error_callback(ErrorCallback callback);
 
+    /**
+     * @brief Computes CRC-16 checksum.
+     *
+     * @param data Pointer to the data.
+     * @param len Length of the data.
+     * @return The computed CRC-16 value.
+     */
+    static uint16_t crc16(const uint8_t* data, size_t len);
+
+    /**
+     * @brief Processes a chunk of incoming bytes.
+     *
+     * Frames that are fully contained in the chunk are delivered without being copied.
+     * Only frames split across chunks are assembled in the internal buffer.
+     *
+     * @param data Pointer to the received data.
+     * @param length Length of the data.
+     */
+    void process(const uint8_t* data, size_t length);
+
 private:
     /**
      * @brief Processes a single incoming byte through the protocol state machine.
@@ -93,13 +148,14 @@ private:
     void process_byte(uint8_t byte);
 
     /**
-     * @brief Computes CRC-16 checksum.
-     *
-     * @param data Pointer to the data.
-     * @param len Length of the data.
-     * @return The computed CRC-16 value.
+     * @brief Validates the checksum of a complete packet and forwards it.
      */
-    static uint16_t crc16(const uint8_t* data, size_t len);
+    void deliver(const uint8_t* payload, size_t length, uint16_t checksum);
+
+    /**
+     * @brief Completes the frame around a payload already in the transmit buffer and sends it.
+     */
+    void send_frame(size_t length);
 
     std::unique_ptr<USB::UsbHelper> _usb_helper;
     State _state;
@@ -109,6 +165,9 @@ private:
     std::vector<uint8_t> _buffer;
     PacketCallback _packet_callback;
     ErrorCallback _error_callback;
+
+    std::array<uint8_t, HEADER_SIZE + MAX_PAYLOAD_SIZE + TRAILER_SIZE> _tx_frame;
+    std::mutex _tx_mutex;
 };
 
 }  // namespace Serial
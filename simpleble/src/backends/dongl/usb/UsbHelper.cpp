@@ -26,10 +26,12 @@ UsbHelper::UsbHelper(const std::string& device_path) : _impl(nullptr) {
 #endif
 }
 
+UsbHelper::UsbHelper(std::unique_ptr<UsbHelperImpl> impl) : _impl(std::move(impl)) {}
+
 UsbHelper::~UsbHelper() = default;
 
-void UsbHelper::tx(const kvn::bytearray& data) {
-    _impl->tx(data);
+void UsbHelper::tx(const uint8_t* data, size_t length) {
+    _impl->tx(data, length);
 }
 
 void UsbHelper::set_rx_callback(std::function<void(const kvn::bytearray&)> callback) {
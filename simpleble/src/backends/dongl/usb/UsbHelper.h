@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
@@ -16,9 +18,10 @@ class UsbHelperImpl;
 class UsbHelper {
   public:
     UsbHelper(const std::string& device_path);
+    UsbHelper(std::unique_ptr<UsbHelperImpl> impl);
     ~UsbHelper();
 
-    void tx(const kvn::bytearray& data);
+    void tx(const uint8_t* data, size_t length);
     void set_rx_callback(std::function<void(const kvn::bytearray&)> callback);
 
     static std::vector<std::string> get_dongl_devices();
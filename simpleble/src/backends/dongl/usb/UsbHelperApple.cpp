@@ -71,9 +71,9 @@ UsbHelperApple::~UsbHelperApple() {
     _close_serial_port();
 }
 
-void UsbHelperApple::tx(const kvn::bytearray& data) {
-    const ssize_t written = write(_serial_fd, data.data(), data.size());
-    if (written != data.size()) {
+void UsbHelperApple::tx(const uint8_t* data, size_t length) {
+    const ssize_t written = write(_serial_fd, data, length);
+    if (written != static_cast<ssize_t>(length)) {
         throw std::runtime_error("Failed to write to serial port: " + std::string(strerror(errno)));
     }
 }
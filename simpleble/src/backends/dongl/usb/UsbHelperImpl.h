@@ -2,6 +2,8 @@
 
 #include <kvn/kvn_bytearray.h>
 #include <kvn/kvn_safe_callback.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace SimpleBLE {
@@ -13,7 +15,7 @@ class UsbHelperImpl {
     UsbHelperImpl(const std::string& device_path) : _device_path(device_path) {}
     virtual ~UsbHelperImpl() = default;
 
-    virtual void tx(const kvn::bytearray& data) = 0;
+    virtual void tx(const uint8_t* data, size_t length) = 0;
     virtual void set_rx_callback(std::function<void(const kvn::bytearray&)> callback) = 0;
 
     static const uint16_t DONGL_VENDOR_ID = 0x3918;
@@ -82,7 +82,7 @@ UsbHelperLinux::~UsbHelperLinux() {
     _close_serial_port();
 }
 
-void UsbHelperLinux::tx(const kvn::bytearray& data) {
+void UsbHelperLinux::tx(const uint8_t* data, size_t length) {
     std::scoped_lock lock(_serial_mutex);
     if (!_running || _serial_fd < 0) {
         throw std::runtime_error("Serial port is not available: " + _device_path);
@@ -90,8 +90,8 @@ void UsbHelperLinux::tx(const kvn::bytearray& data) {
 
     size_t offset = 0;
 
-    while (offset < data.size()) {
-        const ssize_t bytes_written = write(_serial_fd, data.data() + offset, data.size() - offset);
+    while (offset < length) {
+        const ssize_t bytes_written = write(_serial_fd, data + offset, length - offset);
         if (bytes_written > 0) {
             offset += static_cast<size_t>(bytes_written);
             continue;
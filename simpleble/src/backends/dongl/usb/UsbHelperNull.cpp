@@ -8,7 +8,7 @@ UsbHelperNull::UsbHelperNull(const std::string& device_path) : UsbHelperImpl(dev
 
 UsbHelperNull::~UsbHelperNull() = default;
 
-void UsbHelperNull::tx(const kvn::bytearray& data) {}
+void UsbHelperNull::tx(const uint8_t*, size_t) {}
 
 void UsbHelperNull::set_rx_callback(std::function<void(const kvn::bytearray&)> callback) {
     _rx_callback.load(callback);
@@ -11,7 +11,7 @@ class UsbHelperNull : public UsbHelperImpl {
     UsbHelperNull(const std::string& device_path);
     ~UsbHelperNull();
 
-    void tx(const kvn::bytearray& data);
+    void tx(const uint8_t* data, size_t length);
     void set_rx_callback(std::function<void(const kvn::bytearray&)> callback);
 
     static std::vector<std::string> get_dongl_devices();
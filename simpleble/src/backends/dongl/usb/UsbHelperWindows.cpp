@@ -199,7 +199,7 @@ UsbHelperWindows::~UsbHelperWindows() {
     _close_serial_port();
 }
 
-void UsbHelperWindows::tx(const kvn::bytearray& data) {
+void UsbHelperWindows::tx(const uint8_t* data, size_t length) {
     std::scoped_lock tx_lock(_tx_mutex);
 
     if (!_running || _serial_handle == nullptr) {
@@ -209,13 +209,13 @@ void UsbHelperWindows::tx(const kvn::bytearray& data) {
 
     size_t offset = 0;
 
-    while (offset < data.size()) {
-        const size_t remaining = data.size() - offset;
+    while (offset < length) {
+        const size_t remaining = length - offset;
         const DWORD requested = static_cast<DWORD>(
             std::min(remaining, static_cast<size_t>(std::numeric_limits<DWORD>::max())));
 
         DWORD bytes_written = 0;
-        if (!WriteFile(serial_handle, data.data() + offset, requested, &bytes_written, nullptr)) {
+        if (!WriteFile(serial_handle, data + offset, requested, &bytes_written, nullptr)) {
             const DWORD error = GetLastError();
             throw std::system_error(static_cast<int>(error), std::system_category(),
                                     "Failed to write to serial port " + _device_path);
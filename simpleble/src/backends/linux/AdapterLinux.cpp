@@ -1,7 +1,11 @@
 #include <algorithm>
+#include <chrono>
+#include <exception>
+#include <optional>
 #include <thread>
 #include <utility>
 
+#include <simpleble/Config.h>
 #include <simpleble/Peripheral.h>
 
 #include "AdapterLinux.h"
@@ -9,10 +13,63 @@
 #include "BuilderBase.h"
 #include "CommonUtils.h"
 #include "LocalPeripheralLinux.h"
+#include "LoggingInternal.h"
 #include "PeripheralLinux.h"
+#include "ScanFilterMatcher.h"
 
 using namespace SimpleBLE;
 
+namespace {
+
+// Translates a scan filter into a BlueZ discovery filter, or nothing if it doesn't restrict discovery at all.
+std::optional<SimpleBluez::Adapter::DiscoveryFilter> to_discovery_filter(const ScanFilter& filter) {
+    SimpleBluez::Adapter::DiscoveryFilter discovery_filter;
+    for (const auto& uuid : filter.service_uuids) {
+        discovery_filter.UUIDs.push_back(BluetoothUUID128(uuid).to_string());
+    }
+
+    // BlueZ rejects filters with both thresholds, in which case the pathloss is checked on the host.
+    discovery_filter.RSSI = filter.rssi_threshold;
+    if (!filter.rssi_threshold) {
+        discovery_filter.Pathloss = filter.pathloss_threshold;
+    }
+
+    switch (filter.transport) {
+        case ScanFilter::Transport::AUTO:
+            discovery_filter.Transport = SimpleBluez::Adapter::DiscoveryFilter::TransportType::AUTO;
+            break;
+        case ScanFilter::Transport::BREDR:
+            discovery_filter.Transport = SimpleBluez::Adapter::DiscoveryFilter::TransportType::BREDR;
+            break;
+        case ScanFilter::Transport::LE:
+            discovery_filter.Transport = SimpleBluez::Adapter::DiscoveryFilter::TransportType::LE;
+            break;
+    }
+
+    discovery_filter.DuplicateData = filter.duplicate_data;
+    discovery_filter.Pattern = filter.pattern;
+
+    const bool restricts_discovery = !discovery_filter.UUIDs.empty() || discovery_filter.RSSI ||
+                                     discovery_filter.Pathloss || filter.transport != ScanFilter::Transport::AUTO ||
+                                     !discovery_filter.DuplicateData || !discovery_filter.Pattern.empty();
+    if (!restricts_discovery) {
+        return std::nullopt;
+    }
+    return discovery_filter;
+}
+
+BluetoothAddressType to_address_type(const std::string& address_type) {
+    if (address_type == "public") {
+        return BluetoothAddressType::PUBLIC;
+    } else if (address_type == "random") {
+        return BluetoothAddressType::RANDOM;
+    } else {
+        return BluetoothAddressType::UNSPECIFIED;
+    }
+}
+
+}  // namespace
+
 bool AdapterLinux::bluetooth_enabled() { return adapter_->powered(); }
 
 AdapterLinux::AdapterLinux(std::shared_ptr<SimpleBluez::Adapter> adapter) : adapter_(adapter) {
@@ -25,7 +82,12 @@ AdapterLinux::AdapterLinux(std::shared_ptr<SimpleBluez::Adapter> adapter) : adap
     });
     adapter_->set_on_device_updated([this](std::shared_ptr<SimpleBluez::Device> device) {
         const auto address = device->address();
-        if (_seen_addresses.insert(address).second) {
+        bool first_seen = false;
+        {
+            std::scoped_lock lock(seen_mutex_);
+            first_seen = _seen_addresses.insert(address).second;
+        }
+        if (first_seen) {
             // A device that first appears already connected, without us calling
             // Connect(), is an external central. Subscribe only then, so later
             // Connected changes on scan/outgoing devices are not treated as clients.
@@ -43,20 +105,65 @@ AdapterLinux::AdapterLinux(std::shared_ptr<SimpleBluez::Adapter> adapter) : adap
         if (!is_scanning_) {
             return;
         }
+        const auto received = std::chrono::steady_clock::now();
+
+        // The advertising data is checked in place, so that advertisers that don't match never get a peripheral.
+        std::shared_ptr<const ScanFilterMatcher> host_scan_matcher;
+        {
+            std::scoped_lock lock(host_scan_matcher_mutex_);
+            host_scan_matcher = host_scan_matcher_;
+        }
+        if (host_scan_matcher) {
+            const std::string name = device->name();
+            const bool accepted = device->advertising_data_matches(
+                [&](const SimpleBluez::Device1::AdvertisingData& data) {
+                    return host_scan_matcher->matches(ScanFilterMatcher::Advertisement{
+                        address, name, data.rssi, data.tx_power, data.manufacturer_data, data.service_data, data.uuids});
+                });
+            if (!accepted) {
+                return;
+            }
+        }
+
+        // Every update is reported as it arrives, including the ones that are coalesced below. BlueZ doesn't
+        // expose raw advertisements, so each report holds the state of the device merged from all of them.
+        if (_callback_on_advertisement) {
+            auto advertising_data = device->advertising_data();
+            advertising_data_t data;
+            data.mac_address = address;
+            data.address_type = to_address_type(device->address_type());
+            data.identifier = device->name();
+            data.connectable = !data.identifier.empty();
+            data.rssi = advertising_data.rssi;
+            data.tx_power = advertising_data.tx_power;
+            data.manufacturer_data = std::move(advertising_data.manufacturer_data);
+            data.service_data = std::move(advertising_data.service_data);
+            data.service_uuids = std::move(advertising_data.uuids);
+            _report_advertisement(std::move(data), received);
+        }
+
+        // Only forward updates that actually changed the contents of the device. BlueZ emits a
+        // PropertiesChanged signal for every received advertisement, most of which are duplicates, so they
+        // are dropped before touching the peripheral cache.
+        const uint64_t generation = device->generation();
+        {
+            std::scoped_lock lock(seen_mutex_);
+            auto seen = seen_generations_.find(address);
+            if (seen != seen_generations_.end() && seen->second.generation == generation) {
+                seen->second.heard = true;
+                return;
+            }
+        }
 
         std::shared_ptr<PeripheralLinux> peripheral;
         bool is_new_peripheral = false;
+        std::vector<CachedPeripheral> evicted;
 
         {
             std::scoped_lock lock(peripherals_mutex_);
-            if (peripherals_.count(address) == 0) {
-                // If the incoming peripheral has never been seen before, create and save a reference to it.
-                auto base_peripheral = std::make_shared<PeripheralLinux>(device, adapter_);
-                peripherals_.insert(std::make_pair(address, base_peripheral));
-            }
-
-            // Update the received advertising data.
-            peripheral = peripherals_.at(address);
+            // The peripheral is cached before evicting, so that the one being reported is never evicted.
+            peripheral = _cache_peripheral(device);
+            evicted = _evict_stale_peripherals();
 
             // Check if the device has been seen before, to forward the correct call to the user.
             is_new_peripheral = seen_peripherals_.count(address) == 0;
@@ -64,8 +171,13 @@ AdapterLinux::AdapterLinux(std::shared_ptr<SimpleBluez::Adapter> adapter) : adap
                 // Store it in our table of seen peripherals
                 seen_peripherals_.insert(std::make_pair(address, peripheral));
             }
+
+            std::scoped_lock seen_lock(seen_mutex_);
+            seen_generations_[address] = SeenGeneration{generation, false};
         }
 
+        _remove_evicted_peripherals(std::move(evicted));
+
         Peripheral public_peripheral = Factory::build(peripheral);
         if (is_new_peripheral) {
             SAFE_CALLBACK_CALL(_callback_on_scan_found, public_peripheral);
@@ -94,15 +206,26 @@ bool AdapterLinux::is_powered() { return adapter_->powered(); }
 
 void AdapterLinux::scan_start() {
     {
-        std::scoped_lock lock(peripherals_mutex_);
+        std::scoped_lock lock(peripherals_mutex_, seen_mutex_);
         seen_peripherals_.clear();
+        seen_generations_.clear();
+    }
+    _sweep_peripherals();
+
+    // Filtering in BlueZ keeps advertisers that don't match from ever reaching SimpleBLE. BlueZ drops the
+    // filter whenever discovery stops, so it's set on every scan, and reset if a scan is still ongoing.
+    auto discovery_filter = to_discovery_filter(scan_filter());
+    if (discovery_filter) {
+        adapter_->discovery_filter(*discovery_filter);
+        discovery_filter_set_ = true;
+    } else if (discovery_filter_set_) {
+        adapter_->discovery_filter(SimpleBluez::Adapter::DiscoveryFilter());
+        discovery_filter_set_ = false;
     }
 
     // Start scanning and notify the user.
     adapter_->discovery_start();
 
-    // TODO: Does a discovery filter need to be set?
-
     SAFE_CALLBACK_CALL(this->_callback_on_scan_start);
     is_scanning_ = true;
 }
@@ -111,6 +234,7 @@ void AdapterLinux::scan_stop() {
     adapter_->discovery_stop();
     is_scanning_ = false;
     SAFE_CALLBACK_CALL(this->_callback_on_scan_stop);
+    _sweep_peripherals();
 
     // Important: Bluez might continue scanning if another process is also requesting
     // scanning from the adapter. The use of the is_scanning_ flag is to prevent
@@ -125,7 +249,23 @@ void AdapterLinux::scan_for(int timeout_ms) {
 
 bool AdapterLinux::scan_is_active() { return is_scanning_ && adapter_->discovering(); }
 
+void AdapterLinux::set_scan_filter(ScanFilter filter) {
+    // BlueZ merges the discovery filters of all its clients and keeps reporting devices that were discovered
+    // before, so the criteria it applies are only a first pass and are checked again on the host. The
+    // transport is the exception, as it can't be told from the advertising data.
+    ScanFilter host_filter = filter;
+    host_filter.transport = ScanFilter::Transport::AUTO;
+    auto host_scan_matcher = std::make_shared<const ScanFilterMatcher>(std::move(host_filter));
+
+    AdapterBase::set_scan_filter(std::move(filter));
+
+    std::scoped_lock lock(host_scan_matcher_mutex_);
+    host_scan_matcher_ = host_scan_matcher->matches_all() ? nullptr : std::move(host_scan_matcher);
+}
+
 SharedPtrVector<PeripheralBase> AdapterLinux::scan_get_results() {
+    _sweep_peripherals();
+
     std::scoped_lock lock(peripherals_mutex_);
     return Util::values(seen_peripherals_);
 }
@@ -135,18 +275,11 @@ SharedPtrVector<PeripheralBase> AdapterLinux::get_paired_peripherals() {
 
     auto paired_list = adapter_->device_paired_get();
     for (auto& device : paired_list) {
-        auto address = device->address();
-
         // Reuse the cached wrapper for this device if one exists, as creating a
         // second wrapper around the same device would clear the existing wrapper's
         // callbacks once it gets destroyed.
         std::scoped_lock lock(peripherals_mutex_);
-        if (peripherals_.count(address) == 0) {
-            auto base_peripheral = std::make_shared<PeripheralLinux>(device, this->adapter_);
-            peripherals_.insert(std::make_pair(address, base_peripheral));
-        }
-
-        peripherals.push_back(peripherals_.at(address));
+        peripherals.push_back(_cache_peripheral(device));
     }
 
     return peripherals;
@@ -161,6 +294,86 @@ std::shared_ptr<Local::PeripheralBase> AdapterLinux::create_local_peripheral() {
     return peripheral;
 }
 
+Advanced::Linux::PeripheralCacheStats AdapterLinux::peripheral_cache_stats() {
+    _sweep_peripherals();
+
+    std::scoped_lock lock(peripherals_mutex_);
+    return {peripherals_.size(), seen_peripherals_.size(), peripherals_evicted_};
+}
+
+std::shared_ptr<PeripheralLinux> AdapterLinux::_cache_peripheral(const std::shared_ptr<SimpleBluez::Device>& device) {
+    const auto address = device->address();
+    const auto now = std::chrono::steady_clock::now();
+
+    if (auto* entry = peripherals_.find(address)) {
+        peripherals_.touch(address, now);
+        return entry->peripheral;
+    }
+
+    // If the incoming peripheral has never been seen before, create and save a reference to it.
+    CachedPeripheral entry{device, std::make_shared<PeripheralLinux>(device, adapter_)};
+    return peripherals_.insert(address, std::move(entry), now).peripheral;
+}
+
+bool AdapterLinux::_is_evictable(const BluetoothAddress& address, const CachedPeripheral& entry) {
+    // Any reference beyond the ones held by the adapter itself belongs to the user.
+    const long adapter_references = 1 + static_cast<long>(seen_peripherals_.count(address));
+    if (entry.peripheral.use_count() > adapter_references || entry.device->in_use()) {
+        return false;
+    }
+
+    // A peripheral that kept advertising since it was last seen gets marked as seen instead.
+    auto seen = seen_generations_.find(address);
+    return seen == seen_generations_.end() || !std::exchange(seen->second.heard, false);
+}
+
+std::vector<AdapterLinux::CachedPeripheral> AdapterLinux::_evict_stale_peripherals() {
+    std::scoped_lock lock(seen_mutex_);
+    auto stale = peripherals_.evict(
+        std::chrono::steady_clock::now(), Config::SimpleBluez::peripheral_cache_max_entries,
+        Config::SimpleBluez::peripheral_cache_ttl,
+        [this](const BluetoothAddress& address, const CachedPeripheral& entry) { return _is_evictable(address, entry); });
+
+    std::vector<CachedPeripheral> evicted;
+    for (auto& [address, entry] : stale) {
+        seen_peripherals_.erase(address);
+        seen_generations_.erase(address);
+        _seen_addresses.erase(address);
+        evicted.push_back(std::move(entry));
+        peripherals_evicted_++;
+    }
+    return evicted;
+}
+
+void AdapterLinux::_sweep_peripherals() {
+    std::vector<CachedPeripheral> evicted;
+    {
+        std::scoped_lock lock(peripherals_mutex_);
+        evicted = _evict_stale_peripherals();
+    }
+    _remove_evicted_peripherals(std::move(evicted));
+}
+
+void AdapterLinux::_remove_evicted_peripherals(std::vector<CachedPeripheral> evicted) {
+    for (const auto& entry : evicted) {
+        const std::string path = entry.device->path();
+
+        // NOTE: This runs from within the device update callback, so the removal can't wait for BlueZ to reply.
+        try {
+            adapter_->device_remove_async(path, [path](std::exception_ptr error) {
+                if (!error) return;
+                try {
+                    std::rethrow_exception(error);
+                } catch (const std::exception& e) {
+                    SIMPLEBLE_LOG_WARN(fmt::format("Failed to remove evicted device {}: {}", path, e.what()));
+                }
+            });
+        } catch (const std::exception& e) {
+            SIMPLEBLE_LOG_WARN(fmt::format("Failed to remove evicted device {}: {}", path, e.what()));
+        }
+    }
+}
+
 void AdapterLinux::_on_device_connected(std::shared_ptr<SimpleBluez::Device> device, bool connected) {
     const auto address = device->address();
 
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <simpleble/Advanced.h>
 #include <simpleble/Exceptions.h>
 #include <simpleble/Types.h>
 
 #include "../common/AdapterBase.h"
+#include "../common/LruCache.h"
 
 #include <kvn_safe_callback.hpp>
 
@@ -44,6 +46,7 @@ class AdapterLinux : public SimpleBLE::AdapterBase {
     virtual void scan_stop() override;
     virtual void scan_for(int timeout_ms) override;
     virtual bool scan_is_active() override;
+    virtual void set_scan_filter(ScanFilter filter) override;
     virtual std::vector<std::shared_ptr<PeripheralBase>> scan_get_results() override;
 
     virtual std::vector<std::shared_ptr<PeripheralBase>> get_paired_peripherals() override;
@@ -52,19 +55,48 @@ class AdapterLinux : public SimpleBLE::AdapterBase {
 
     virtual bool bluetooth_enabled() override;
 
+    Advanced::Linux::PeripheralCacheStats peripheral_cache_stats();
+
   private:
+    struct CachedPeripheral {
+        std::shared_ptr<SimpleBluez::Device> device;
+        std::shared_ptr<PeripheralLinux> peripheral;
+    };
+
     std::shared_ptr<SimpleBluez::Adapter> adapter_;
 
     std::atomic_bool is_scanning_{false};
-
-    std::map<BluetoothAddress, std::shared_ptr<PeripheralLinux>> peripherals_;
+    bool discovery_filter_set_ = false;
+    // Criteria of the scan filter that BlueZ can't apply, checked before caching any peripheral.
+    std::shared_ptr<const ScanFilterMatcher> host_scan_matcher_;
+    std::mutex host_scan_matcher_mutex_;
+
+    struct SeenGeneration {
+        uint64_t generation;
+        // Set when an update is dropped as a duplicate, as those don't mark the cached peripheral as seen.
+        bool heard;
+    };
+
+    LruCache<BluetoothAddress, CachedPeripheral> peripherals_;
+    uint64_t peripherals_evicted_ = 0;
     std::map<BluetoothAddress, std::shared_ptr<PeripheralLinux>> seen_peripherals_;
     std::mutex peripherals_mutex_;
 
+    // Checked on every device update, so they have their own lock, which is taken after peripherals_mutex_.
+    std::map<BluetoothAddress, SeenGeneration> seen_generations_;
     std::set<BluetoothAddress> _seen_addresses;
+    std::mutex seen_mutex_;
     std::vector<std::weak_ptr<Local::PeripheralLinux>> _local_peripherals;
     std::mutex _local_peripherals_mutex;
 
+    // The following functions must be called with peripherals_mutex_ held. Eviction takes seen_mutex_ itself.
+    std::shared_ptr<PeripheralLinux> _cache_peripheral(const std::shared_ptr<SimpleBluez::Device>& device);
+    bool _is_evictable(const BluetoothAddress& address, const CachedPeripheral& entry);
+    std::vector<CachedPeripheral> _evict_stale_peripherals();
+
+    void _remove_evicted_peripherals(std::vector<CachedPeripheral> evicted);
+    // Evicts stale peripherals outside of scan updates, so that the TTL holds even once advertisers go silent.
+    void _sweep_peripherals();
     void _on_device_connected(std::shared_ptr<SimpleBluez::Device> device, bool connected);
 };
 
@@ -26,6 +26,7 @@ BackendBluez::BackendBluez(buildToken) {
 
 BackendBluez::~BackendBluez() {
     async_thread_active = false;
+    bluez.wakeup();
     if (async_thread.joinable()) {
         async_thread.join();
     }
@@ -71,8 +72,8 @@ std::string BackendBluez::identifier() const noexcept { return "SimpleBluez"; }
 
 void BackendBluez::async_thread_function() {
     while (async_thread_active) {
-        SAFE_RUN({ bluez.run_async(); });
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        // Blocks until the bus has activity, the long timeout only acts as a safety net.
+        SAFE_RUN({ bluez.run_async_blocking(std::chrono::milliseconds(500)); });
     }
 }
 
@@ -0,0 +1,52 @@
+#include "BluezFlags.h"
+
+#include <array>
+#include <utility>
+
+namespace SimpleBLE {
+
+namespace {
+
+// Bluez reports extended properties individually, so there's no flag for EXTENDED_PROPERTIES itself.
+constexpr std::array<std::pair<const char*, CharacteristicProperties>, 9> BLUEZ_FLAGS = {{
+    {"broadcast", CharacteristicProperty::BROADCAST},
+    {"read", CharacteristicProperty::READ},
+    {"write-without-response", CharacteristicProperty::WRITE_COMMAND},
+    {"write", CharacteristicProperty::WRITE_REQUEST},
+    {"notify", CharacteristicProperty::NOTIFY},
+    {"indicate", CharacteristicProperty::INDICATE},
+    {"authenticated-signed-writes", CharacteristicProperty::AUTHENTICATED_SIGNED_WRITES},
+    {"reliable-write", CharacteristicProperty::RELIABLE_WRITE},
+    {"writable-auxiliaries", CharacteristicProperty::WRITABLE_AUXILIARIES},
+}};
+
+}  // namespace
+
+CharacteristicProperties properties_from_bluez_flags(const std::vector<std::string>& flags) {
+    CharacteristicProperties properties = CharacteristicProperty::NONE;
+    for (const auto& flag : flags) {
+        for (const auto& [name, property] : BLUEZ_FLAGS) {
+            if (flag == name) {
+                properties |= property;
+                break;
+            }
+        }
+    }
+
+    if (properties & (CharacteristicProperty::RELIABLE_WRITE | CharacteristicProperty::WRITABLE_AUXILIARIES)) {
+        properties |= CharacteristicProperty::EXTENDED_PROPERTIES;
+    }
+    return properties;
+}
+
+std::vector<std::string> bluez_flags_from_properties(CharacteristicProperties properties) {
+    std::vector<std::string> flags;
+    for (const auto& [name, property] : BLUEZ_FLAGS) {
+        if (properties & property) {
+            flags.emplace_back(name);
+        }
+    }
+    return flags;
+}
+
+}  // namespace SimpleBLE
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <simpleble/Types.h>
+
+#include <string>
+#include <vector>
+
+namespace SimpleBLE {
+
+// Conversions between the flag strings used by the Bluez GattCharacteristic1 interface and
+// CharacteristicProperties, so that flags only need to be parsed once per characteristic.
+CharacteristicProperties properties_from_bluez_flags(const std::vector<std::string>& flags);
+std::vector<std::string> bluez_flags_from_properties(CharacteristicProperties properties);
+
+}  // namespace SimpleBLE
@@ -1,11 +1,25 @@
 #include "LocalCharacteristicLinux.h"
 
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <utility>
 
+#include "BackendBluez.h"
+#include "BluezFlags.h"
 #include "CommonUtils.h"
 
 namespace SimpleBLE::Local {
 
+namespace {
+
+// How long notify() waits for room in the socket of a client before dropping the rest of the batch.
+constexpr int NOTIFY_SEND_TIMEOUT_MS = 1000;
+
+}  // namespace
+
 CharacteristicLinux::CharacteristicLinux(std::shared_ptr<SimpleBluez::Characteristic> characteristic,
                                          BluetoothUUID uuid, std::set<CharacteristicCapability> capabilities)
     : _characteristic(std::move(characteristic)), _uuid(std::move(uuid)), _capabilities(std::move(capabilities)) {
@@ -36,17 +50,20 @@ CharacteristicLinux::CharacteristicLinux(std::shared_ptr<SimpleBluez::Characteri
         });
 
     _characteristic->set_on_notify([this](bool subscribed) {
-        const bool was_subscribed = _subscribed.exchange(subscribed);
-        if (subscribed == was_subscribed) {
-            return;
-        }
-
-        if (subscribed) {
-            SAFE_CALLBACK_CALL(_callback_on_subscribed);
-        } else {
-            SAFE_CALLBACK_CALL(_callback_on_unsubscribed);
-        }
+        _notifying = subscribed;
+        _update_subscribed();
     });
+
+    // Exporting NotifyAcquired lets BlueZ hand each subscribing client a socket of its own, which
+    // notify() writes to directly instead of emitting every value over D-Bus.
+    if (_capabilities.count(CharacteristicCapability::NOTIFY) != 0 ||
+        _capabilities.count(CharacteristicCapability::INDICATE) != 0) {
+        _characteristic->set_on_acquire_notify(
+            [this](SimpleDBus::UnixSocket socket, SimpleBluez::Characteristic::ValueOptions options) {
+                _add_notify_client(std::move(socket), options.mtu.value_or(23));
+            });
+        _characteristic->enable_acquire_notify();
+    }
 }
 
 CharacteristicLinux::~CharacteristicLinux() {
@@ -58,6 +75,13 @@ CharacteristicLinux::~CharacteristicLinux() {
     _characteristic->clear_on_read_value();
     _characteristic->clear_on_write_value();
     _characteristic->clear_on_notify();
+    _characteristic->clear_on_acquire_notify();
+
+    std::scoped_lock lock(_notify_clients_mutex);
+    for (auto& [fd, client] : _notify_clients) {
+        BackendBluez::get()->bluez.unwatch_fd(fd);
+    }
+    _notify_clients.clear();
 }
 
 BluetoothUUID CharacteristicLinux::uuid() { return _uuid; }
@@ -66,7 +90,23 @@ std::set<CharacteristicCapability> CharacteristicLinux::capabilities() { return
 
 ByteArray CharacteristicLinux::value() { return _characteristic->value(); }
 
-void CharacteristicLinux::set_value(ByteArray value) { _characteristic->value(std::move(value)); }
+void CharacteristicLinux::set_value(ByteArray value) {
+    _send_to_notify_clients({value});
+    _characteristic->value(std::move(value), _notifying);
+}
+
+void CharacteristicLinux::notify(const std::vector<ByteArray>& values) {
+    _send_to_notify_clients(values);
+
+    // Emitting is only worth its D-Bus traffic if a client subscribed without acquiring a socket.
+    if (_notifying) {
+        for (const auto& value : values) {
+            _characteristic->value(value);
+        }
+    } else {
+        _characteristic->value(values.back(), false);
+    }
+}
 
 void CharacteristicLinux::set_callback_on_read(std::function<ByteArray()> on_read) {
     if (on_read) {
@@ -100,31 +140,135 @@ void CharacteristicLinux::set_callback_on_unsubscribed(std::function<void()> on_
     }
 }
 
+void CharacteristicLinux::_add_notify_client(SimpleDBus::UnixSocket socket, uint16_t mtu) {
+    auto client = std::make_shared<NotifyClient>();
+    client->socket = std::move(socket);
+    client->mtu = mtu;
+
+    const int fd = client->socket.fd();
+    {
+        std::scoped_lock lock(_notify_clients_mutex);
+        _notify_clients[fd] = client;
+    }
+
+    // Nothing but indication confirmations is ever read back, so the socket is only watched to find out
+    // when BlueZ hangs up.
+    // The handler can outlive this characteristic on the thread dispatching the connection, so it only holds on
+    // to it while running.
+    std::weak_ptr<CharacteristicLinux> weak_self = weak_from_this();
+    BackendBluez::get()->bluez.watch_fd(fd, [weak_self, client]() {
+        uint8_t buffer[16];
+        while (true) {
+            ssize_t size = client->socket.receive(buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (size > 0 || (size < 0 && errno == EINTR)) continue;
+            if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+
+            if (auto self = weak_self.lock()) {
+                self->_remove_notify_client(client);
+            }
+            return;
+        }
+    });
+
+    _update_subscribed();
+}
+
+void CharacteristicLinux::_remove_notify_client(const std::shared_ptr<NotifyClient>& client) {
+    const int fd = client->socket.fd();
+    {
+        std::scoped_lock lock(_notify_clients_mutex);
+        auto it = _notify_clients.find(fd);
+        if (it == _notify_clients.end() || it->second != client) return;
+        _notify_clients.erase(it);
+    }
+    BackendBluez::get()->bluez.unwatch_fd(fd);
+
+    _update_subscribed();
+}
+
+void CharacteristicLinux::_send_to_notify_clients(const std::vector<ByteArray>& values) {
+    std::vector<std::shared_ptr<NotifyClient>> clients;
+    {
+        std::scoped_lock lock(_notify_clients_mutex);
+        for (const auto& [fd, client] : _notify_clients) {
+            clients.push_back(client);
+        }
+    }
+
+    for (const auto& client : clients) {
+        if (!_send(*client, values)) {
+            _remove_notify_client(client);
+        }
+    }
+}
+
+void CharacteristicLinux::_update_subscribed() {
+    bool subscribed = _notifying;
+    if (!subscribed) {
+        std::scoped_lock lock(_notify_clients_mutex);
+        subscribed = !_notify_clients.empty();
+    }
+
+    const bool was_subscribed = _subscribed.exchange(subscribed);
+    if (subscribed == was_subscribed) {
+        return;
+    }
+
+    if (subscribed) {
+        SAFE_CALLBACK_CALL(_callback_on_subscribed);
+    } else {
+        SAFE_CALLBACK_CALL(_callback_on_unsubscribed);
+    }
+}
+
+bool CharacteristicLinux::_send(NotifyClient& client, const std::vector<ByteArray>& values) {
+    // Each packet of the socket is a single notification, which can't be longer than the ATT MTU of the
+    // client minus the 3 bytes of the header.
+    const size_t max_payload = client.mtu > 3 ? client.mtu - 3 : 0;
+
+    std::vector<iovec> packets(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        packets[i].iov_base = const_cast<uint8_t*>(values[i].data());
+        packets[i].iov_len = std::min(values[i].size(), max_payload);
+    }
+
+    ssize_t sent = client.socket.send_packets(packets, NOTIFY_SEND_TIMEOUT_MS);
+    if (sent < 0) {
+        return false;
+    }
+    if (static_cast<size_t>(sent) < packets.size()) {
+        // BlueZ couldn't keep up with the link for the whole timeout.
+        SIMPLEBLE_LOG_WARN(fmt::format("Dropped {} of {} notifications of {} to a client", packets.size() - sent,
+                                       packets.size(), _uuid));
+    }
+    return true;
+}
+
 std::vector<std::string> CharacteristicLinux::_flags_from_capabilities(
     const std::set<CharacteristicCapability>& capabilities) {
-    std::vector<std::string> flags;
+    CharacteristicProperties properties = CharacteristicProperty::NONE;
 
     for (const auto capability : capabilities) {
         switch (capability) {
             case CharacteristicCapability::READ:
-                flags.emplace_back("read");
+                properties |= CharacteristicProperty::READ;
                 break;
             case CharacteristicCapability::WRITE_REQUEST:
-                flags.emplace_back("write");
+                properties |= CharacteristicProperty::WRITE_REQUEST;
                 break;
             case CharacteristicCapability::WRITE_COMMAND:
-                flags.emplace_back("write-without-response");
+                properties |= CharacteristicProperty::WRITE_COMMAND;
                 break;
             case CharacteristicCapability::NOTIFY:
-                flags.emplace_back("notify");
+                properties |= CharacteristicProperty::NOTIFY;
                 break;
             case CharacteristicCapability::INDICATE:
-                flags.emplace_back("indicate");
+                properties |= CharacteristicProperty::INDICATE;
                 break;
         }
     }
 
-    return flags;
+    return bluez_flags_from_properties(properties);
 }
 
 }  // namespace SimpleBLE::Local
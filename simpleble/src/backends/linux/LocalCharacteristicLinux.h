@@ -1,8 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -14,7 +17,7 @@
 
 namespace SimpleBLE::Local {
 
-class CharacteristicLinux : public CharacteristicBase {
+class CharacteristicLinux : public CharacteristicBase, public std::enable_shared_from_this<CharacteristicLinux> {
   public:
     CharacteristicLinux(std::shared_ptr<SimpleBluez::Characteristic> characteristic, BluetoothUUID uuid,
                         std::set<CharacteristicCapability> capabilities);
@@ -25,6 +28,9 @@ class CharacteristicLinux : public CharacteristicBase {
 
     ByteArray value() override;
     void set_value(ByteArray value) override;
+    // Blocks while the socket of a client is full, for up to a second per call. Whatever is left
+    // of the batch by then is dropped for that client and logged as a warning.
+    void notify(const std::vector<ByteArray>& values) override;
 
     void set_callback_on_read(std::function<ByteArray()> on_read) override;
     void set_callback_on_write(std::function<void(ByteArray value)> on_write) override;
@@ -33,16 +39,33 @@ class CharacteristicLinux : public CharacteristicBase {
     void set_callback_on_unsubscribed(std::function<void()> on_unsubscribed) override;
 
   private:
+    // Client that acquired its own socket through AcquireNotify, which BlueZ closes once it unsubscribes.
+    struct NotifyClient {
+        SimpleDBus::UnixSocket socket;
+        uint16_t mtu = 23;
+    };
+
     std::shared_ptr<SimpleBluez::Characteristic> _characteristic;
     BluetoothUUID _uuid;
     std::set<CharacteristicCapability> _capabilities;
     std::atomic_bool _subscribed{false};
+    // Whether a client subscribed through StartNotify, and thus only sees values emitted over D-Bus.
+    std::atomic_bool _notifying{false};
+
+    std::mutex _notify_clients_mutex;
+    std::map<int, std::shared_ptr<NotifyClient>> _notify_clients;
 
     kvn::safe_callback<ByteArray()> _callback_on_read;
     kvn::safe_callback<void(ByteArray)> _callback_on_write;
     kvn::safe_callback<void()> _callback_on_subscribed;
     kvn::safe_callback<void()> _callback_on_unsubscribed;
 
+    void _add_notify_client(SimpleDBus::UnixSocket socket, uint16_t mtu);
+    void _remove_notify_client(const std::shared_ptr<NotifyClient>& client);
+    void _send_to_notify_clients(const std::vector<ByteArray>& values);
+    void _update_subscribed();
+
+    bool _send(NotifyClient& client, const std::vector<ByteArray>& values);
     static std::vector<std::string> _flags_from_capabilities(const std::set<CharacteristicCapability>& capabilities);
 };
 
@@ -1,5 +1,7 @@
 #include "PeripheralLinux.h"
 
+#include "AsyncExecutor.h"
+#include "BluezFlags.h"
 #include "BuildVec.h"
 #include "BuilderBase.h"
 #include "CharacteristicBase.h"
@@ -10,9 +12,11 @@
 #include <simpleble/Config.h>
 #include <simpleble/Descriptor.h>
 #include <simpleble/Exceptions.h>
+#include <simpleble/Metrics.h>
 #include <simpleble/Service.h>
 #include <simplebluez/Exceptions.h>
 #include <algorithm>
+#include <future>
 #include <thread>
 #include "CommonUtils.h"
 #include "LoggingInternal.h"
@@ -25,7 +29,14 @@ using namespace std::chrono_literals;
 
 PeripheralLinux::PeripheralLinux(std::shared_ptr<SimpleBluez::Device> device,
                                  std::shared_ptr<SimpleBluez::Adapter> adapter)
-    : device_(std::move(device)), adapter_(std::move(adapter)) {}
+    : device_(std::move(device)), adapter_(std::move(adapter)) {
+    // Services, characteristics and descriptors can be added or removed by BlueZ at any time, e.g. after a
+    // Service Changed indication, so the cached views of the GATT database are dropped whenever that happens.
+    device_->set_on_services_changed([this]() {
+        this->_clear_characteristic_cache();
+        this->invalidate_services_snapshot();
+    });
+}
 
 PeripheralLinux::~PeripheralLinux() {
     // Clear the callbacks to prevent any further events from being sent to the user.
@@ -35,6 +46,7 @@ PeripheralLinux::~PeripheralLinux() {
     device_->clear_on_connected();
     device_->clear_on_disconnected();
     device_->clear_on_services_resolved();
+    device_->clear_on_services_changed();
     _cleanup_characteristics(true);
 }
 
@@ -73,6 +85,8 @@ uint16_t PeripheralLinux::mtu() {
     return 0;
 }
 
+std::string PeripheralLinux::adapter_identifier() { return adapter_->identifier(); }
+
 void PeripheralLinux::connect() {
     if (is_connected()) {
         return;
@@ -83,12 +97,18 @@ void PeripheralLinux::connect() {
     device_->set_on_services_resolved([this]() { this->connection_cv_.notify_all(); });
 
     // Attempt to connect to the device.
-    for (size_t i = 0; i < 5; i++) {
+    size_t attempts = 0;
+    while (attempts < 5) {
+        attempts++;
         if (_attempt_connect()) {
             break;
         }
     }
 
+    if (Metrics::is_enabled()) {
+        Metrics::increment({"connect_attempts", adapter_identifier(), address()}, attempts);
+    }
+
     device_->clear_on_connected();
     device_->clear_on_services_resolved();
 
@@ -105,6 +125,9 @@ void PeripheralLinux::connect() {
         throw Exception::OperationFailed();
     }
 
+    invalidate_services_snapshot();
+    _build_characteristic_cache();
+
     SAFE_CALLBACK_CALL(this->callback_on_connected_);
 }
 
@@ -170,17 +193,9 @@ SharedPtrVector<ServiceBase> PeripheralLinux::available_services() {
                 descriptor_list.push_back(std::make_shared<DescriptorBase>(bluez_descriptor->uuid()));
             }
 
-            std::vector<std::string> flags = bluez_characteristic->flags();
-
-            bool can_read = std::find(flags.begin(), flags.end(), "read") != flags.end();
-            bool can_write_request = std::find(flags.begin(), flags.end(), "write") != flags.end();
-            bool can_write_command = std::find(flags.begin(), flags.end(), "write-without-response") != flags.end();
-            bool can_notify = std::find(flags.begin(), flags.end(), "notify") != flags.end();
-            bool can_indicate = std::find(flags.begin(), flags.end(), "indicate") != flags.end();
-
-            characteristic_list.push_back(
-                std::make_shared<CharacteristicBase>(bluez_characteristic->uuid(), descriptor_list, can_read,
-                                                     can_write_request, can_write_command, can_notify, can_indicate));
+            characteristic_list.push_back(std::make_shared<CharacteristicBase>(
+                bluez_characteristic->uuid(), descriptor_list,
+                properties_from_bluez_flags(bluez_characteristic->flags())));
         }
 
         service_list.push_back(std::make_shared<ServiceBase>(bluez_service->uuid(), characteristic_list));
@@ -191,13 +206,17 @@ SharedPtrVector<ServiceBase> PeripheralLinux::available_services() {
         // Emulate the battery service through the Battery1 interface.
         SharedPtrVector<DescriptorBase> descriptor_list;
         SharedPtrVector<CharacteristicBase> characteristic_list = {std::make_shared<CharacteristicBase>(
-            BATTERY_CHARACTERISTIC_UUID, descriptor_list, true, false, false, true, false)};
+            BATTERY_CHARACTERISTIC_UUID, descriptor_list, CharacteristicProperty::READ | CharacteristicProperty::NOTIFY)};
         service_list.push_back(std::make_shared<ServiceBase>(BATTERY_SERVICE_UUID, characteristic_list));
     }
 
     return service_list;
 }
 
+std::shared_ptr<const SharedPtrVector<ServiceBase>> PeripheralLinux::services_snapshot() {
+    return cached_services_snapshot();
+}
+
 SharedPtrVector<ServiceBase> PeripheralLinux::advertised_services() {
     SharedPtrVector<ServiceBase> service_list;
 
@@ -228,9 +247,8 @@ ByteArray PeripheralLinux::read(BluetoothUUID const& service, BluetoothUUID cons
     }
 
     // Otherwise, attempt to read the characteristic using default mechanisms
-    auto char_obj = _get_characteristic(service, characteristic);
-    std::vector<std::string> flags = char_obj->flags();
-    if (std::find(flags.begin(), flags.end(), "read") == flags.end()) {
+    auto [char_obj, properties] = _resolve_characteristic(service, characteristic);
+    if (!(properties & CharacteristicProperty::READ)) {
         throw Exception::OperationNotSupported("read", characteristic);
     }
     return char_obj->read();
@@ -240,9 +258,8 @@ void PeripheralLinux::write_request(BluetoothUUID const& service, BluetoothUUID
                                     ByteArray const& data) {
     // TODO: SimpleBluez::Characteristic::write_request() should also take ByteArray by const reference (but that's
     // another library)
-    auto char_obj = _get_characteristic(service, characteristic);
-    std::vector<std::string> flags = char_obj->flags();
-    if (std::find(flags.begin(), flags.end(), "write") == flags.end()) {
+    auto [char_obj, properties] = _resolve_characteristic(service, characteristic);
+    if (!(properties & CharacteristicProperty::WRITE_REQUEST)) {
         throw Exception::OperationNotSupported("write_request", characteristic);
     }
     char_obj->write_request(data);
@@ -252,14 +269,89 @@ void PeripheralLinux::write_command(BluetoothUUID const& service, BluetoothUUID
                                     ByteArray const& data) {
     // TODO: SimpleBluez::Characteristic::write_command() should also take ByteArray by const reference (but that's
     // another library)
-    auto char_obj = _get_characteristic(service, characteristic);
-    std::vector<std::string> flags = char_obj->flags();
-    if (std::find(flags.begin(), flags.end(), "write-without-response") == flags.end()) {
+    auto [char_obj, properties] = _resolve_characteristic(service, characteristic);
+    if (!(properties & CharacteristicProperty::WRITE_COMMAND)) {
         throw Exception::OperationNotSupported("write_command", characteristic);
     }
+
+    _acquire_write(char_obj, characteristic);
     char_obj->write_command(data);
 }
 
+std::future<ByteArray> PeripheralLinux::read_async(BluetoothUUID const& service, BluetoothUUID const& characteristic) {
+    // The emulated battery service is served from cached properties and doesn't block.
+    if (service == BATTERY_SERVICE_UUID && characteristic == BATTERY_CHARACTERISTIC_UUID &&
+        device_->has_battery_interface()) {
+        std::promise<ByteArray> promise;
+        promise.set_value(read(service, characteristic));
+        return promise.get_future();
+    }
+
+    auto [char_obj, properties] = _resolve_characteristic(service, characteristic);
+    if (!(properties & CharacteristicProperty::READ)) {
+        throw Exception::OperationNotSupported("read", characteristic);
+    }
+
+    auto promise = std::make_shared<std::promise<ByteArray>>();
+    char_obj->read_async([promise](SimpleBluez::ByteArray value, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(value));
+        }
+    });
+    return promise->get_future();
+}
+
+std::future<void> PeripheralLinux::write_request_async(BluetoothUUID const& service,
+                                                       BluetoothUUID const& characteristic, ByteArray const& data) {
+    auto [char_obj, properties] = _resolve_characteristic(service, characteristic);
+    if (!(properties & CharacteristicProperty::WRITE_REQUEST)) {
+        throw Exception::OperationNotSupported("write_request", characteristic);
+    }
+
+    auto promise = std::make_shared<std::promise<void>>();
+    char_obj->write_request_async(data, [promise](std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value();
+        }
+    });
+    return promise->get_future();
+}
+
+std::future<void> PeripheralLinux::write_command_async(BluetoothUUID const& service,
+                                                       BluetoothUUID const& characteristic, ByteArray const& data) {
+    auto [char_obj, properties] = _resolve_characteristic(service, characteristic);
+    if (!(properties & CharacteristicProperty::WRITE_COMMAND)) {
+        throw Exception::OperationNotSupported("write_command", characteristic);
+    }
+
+    _acquire_write(char_obj, characteristic);
+    auto promise = std::make_shared<std::promise<void>>();
+    char_obj->write_command_async(data, [promise](std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value();
+        }
+    });
+    return promise->get_future();
+}
+
+void PeripheralLinux::_acquire_write(std::shared_ptr<SimpleBluez::Characteristic> char_obj,
+                                     BluetoothUUID const& characteristic) {
+    // Write commands go over a socket acquired from BlueZ when it offers one, skipping the bus for every packet.
+    if (!char_obj->write_acquired() && char_obj->can_acquire_write()) {
+        try {
+            char_obj->acquire_write();
+        } catch (std::exception const& e) {
+            SIMPLEBLE_LOG_DEBUG(fmt::format("AcquireWrite not available for {}: {}", characteristic, e.what()));
+        }
+    }
+}
+
 void PeripheralLinux::notify(BluetoothUUID const& service, BluetoothUUID const& characteristic,
                              std::function<void(ByteArray payload)> callback) {
     // Check if the user is attempting to notify the battery service/characteristic and if so,
@@ -274,14 +366,42 @@ void PeripheralLinux::notify(BluetoothUUID const& service, BluetoothUUID const&
 
     // Otherwise, attempt to read the characteristic using default mechanisms
     // TODO: What to do if the characteristic is already being notified?
-    auto characteristic_object = _get_characteristic(service, characteristic);
-    std::vector<std::string> flags = characteristic_object->flags();
-    if (std::find(flags.begin(), flags.end(), "notify") == flags.end() &&
-        std::find(flags.begin(), flags.end(), "indicate") == flags.end()) {
+    auto [characteristic_object, properties] = _resolve_characteristic(service, characteristic);
+    if (!(properties & (CharacteristicProperty::NOTIFY | CharacteristicProperty::INDICATE))) {
         throw Exception::OperationNotSupported("notify", characteristic);
     }
-    characteristic_object->set_on_value_changed([callback](SimpleBluez::ByteArray new_value) { callback(new_value); });
-    characteristic_object->start_notify();
+
+    std::scoped_lock lock(notify_mutex_);
+    const std::string key = characteristic_object->path();
+
+    // Prefer a socket acquired from BlueZ, read from the event loop, over a PropertiesChanged signal per value.
+    characteristic_object->release_notify();
+    if (characteristic_object->can_acquire_notify()) {
+        // Recorded before acquiring, so that a hangup right after finds the subscription it belongs to.
+        auto token = notify_subscriptions_.subscribe(key, Subscriptions::Mode::ACQUIRED);
+        try {
+            // The hangup is reported from the thread dispatching the connection, which StartNotify must not block.
+            std::weak_ptr<PeripheralBase> weak_self = weak_from_this();
+            std::weak_ptr<SimpleBluez::Characteristic> weak_characteristic = characteristic_object;
+            characteristic_object->acquire_notify(
+                [callback](SimpleBluez::ByteArray new_value) { callback(std::move(new_value)); },
+                [weak_self, weak_characteristic, token, callback]() {
+                    AsyncExecutor::get().submit([weak_self, weak_characteristic, token, callback]() {
+                        auto self = std::static_pointer_cast<PeripheralLinux>(weak_self.lock());
+                        auto characteristic = weak_characteristic.lock();
+                        if (self && characteristic) {
+                            self->_fall_back_to_properties(characteristic, token, callback);
+                        }
+                    });
+                });
+            return;
+        } catch (std::exception const& e) {
+            notify_subscriptions_.unsubscribe(key);
+            SIMPLEBLE_LOG_DEBUG(fmt::format("AcquireNotify not available for {}: {}", characteristic, e.what()));
+        }
+    }
+
+    _subscribe_properties(characteristic_object, callback);
 }
 
 void PeripheralLinux::indicate(BluetoothUUID const& service, BluetoothUUID const& characteristic,
@@ -300,7 +420,15 @@ void PeripheralLinux::unsubscribe(BluetoothUUID const& service, BluetoothUUID co
     }
 
     // TODO: What to do if the characteristic is not being notified?
-    auto characteristic_object = _get_characteristic(service, characteristic);
+    auto characteristic_object = _resolve_characteristic(service, characteristic).characteristic;
+
+    std::scoped_lock lock(notify_mutex_);
+    auto mode = notify_subscriptions_.unsubscribe(characteristic_object->path());
+    characteristic_object->release_notify();
+    if (mode == Subscriptions::Mode::ACQUIRED) {
+        // Closing the acquired socket is all it takes for BlueZ to unsubscribe, even if BlueZ already hung it up.
+        return;
+    }
     characteristic_object->stop_notify();
 
     // Wait for the characteristic to stop notifying.
@@ -312,6 +440,37 @@ void PeripheralLinux::unsubscribe(BluetoothUUID const& service, BluetoothUUID co
     characteristic_object->clear_on_value_changed();
 }
 
+void PeripheralLinux::_subscribe_properties(std::shared_ptr<SimpleBluez::Characteristic> characteristic,
+                                            std::function<void(ByteArray payload)> callback) {
+    notify_subscriptions_.subscribe(characteristic->path(), Subscriptions::Mode::PROPERTIES);
+    characteristic->set_on_value_changed(
+        [callback](SimpleBluez::ByteArray new_value) { callback(std::move(new_value)); });
+    characteristic->start_notify();
+}
+
+void PeripheralLinux::_fall_back_to_properties(std::shared_ptr<SimpleBluez::Characteristic> characteristic,
+                                               Subscriptions::Token token,
+                                               std::function<void(ByteArray payload)> callback) {
+    std::scoped_lock lock(notify_mutex_);
+
+    // Nothing to do if the subscription was replaced or removed in the meantime, or if the hangup came
+    // with the connection going down.
+    if (!is_connected() || !notify_subscriptions_.fall_back(characteristic->path(), token)) {
+        return;
+    }
+
+    SIMPLEBLE_LOG_INFO(fmt::format("Acquired notify socket of {} closed, falling back to StartNotify",
+                                   characteristic->uuid()));
+    try {
+        characteristic->release_notify();
+        characteristic->set_on_value_changed(
+            [callback](SimpleBluez::ByteArray new_value) { callback(std::move(new_value)); });
+        characteristic->start_notify();
+    } catch (std::exception const& e) {
+        SIMPLEBLE_LOG_ERROR(fmt::format("Failed to fall back to StartNotify: {}", e.what()));
+    }
+}
+
 ByteArray PeripheralLinux::read(BluetoothUUID const& service, BluetoothUUID const& characteristic,
                                 BluetoothUUID const& descriptor) {
     return _get_descriptor(service, characteristic, descriptor)->read();
@@ -341,6 +500,11 @@ void PeripheralLinux::set_callback_on_disconnected(std::function<void()> on_disc
 // Private methods
 
 void PeripheralLinux::_cleanup_characteristics(bool stop_notifications) noexcept {
+    // The GATT database has to be resolved again on the next connection.
+    _clear_characteristic_cache();
+    invalidate_services_snapshot();
+    notify_subscriptions_.clear();
+
     // As this method can be called in multiple stages of a disconnection or object
     // destruction, the entire execution of this method is wrapped in a try-catch
     // block to prevent any exceptions from being thrown, as these will most certainly
@@ -356,6 +520,8 @@ void PeripheralLinux::_cleanup_characteristics(bool stop_notifications) noexcept
             for (auto bluez_characteristic : bluez_service->characteristics()) {
                 try {
                     bluez_characteristic->clear_on_value_changed();
+                    bluez_characteristic->release_notify();
+                    bluez_characteristic->release_write();
                 } catch (std::exception const& e) {
                     SIMPLEBLE_LOG_WARN(fmt::format("Exception during characteristic cleanup: {}", e.what()));
                 }
@@ -410,6 +576,53 @@ bool PeripheralLinux::_attempt_disconnect() {
                                       [this]() { return !is_connected(); });
 }
 
+PeripheralLinux::CharacteristicEntry PeripheralLinux::_resolve_characteristic(BluetoothUUID const& service_uuid,
+                                                                             BluetoothUUID const& characteristic_uuid) {
+    auto key = CharacteristicIndex<CharacteristicEntry>::key(service_uuid, characteristic_uuid);
+    if (key) {
+        auto entry = characteristic_cache_.find(*key);
+        if (entry && entry->characteristic->valid()) {
+            return *entry;
+        }
+    }
+
+    // Either the characteristic is unknown or its object was removed from Bluez (e.g. after a
+    // service change), so it's looked up the slow way, which also raises the appropriate error.
+    CharacteristicEntry entry;
+    entry.characteristic = _get_characteristic(service_uuid, characteristic_uuid);
+    entry.properties = properties_from_bluez_flags(entry.characteristic->flags());
+
+    if (key) {
+        characteristic_cache_.insert(*key, entry);
+    }
+    return entry;
+}
+
+void PeripheralLinux::_build_characteristic_cache() {
+    CharacteristicIndex<CharacteristicEntry>::Entries cache;
+    try {
+        for (auto bluez_service : device_->services()) {
+            for (auto bluez_characteristic : bluez_service->characteristics()) {
+                auto key = CharacteristicIndex<CharacteristicEntry>::key(bluez_service->uuid(),
+                                                                         bluez_characteristic->uuid());
+                if (!key) continue;
+
+                CharacteristicEntry entry;
+                entry.characteristic = bluez_characteristic;
+                entry.properties = properties_from_bluez_flags(bluez_characteristic->flags());
+                cache.emplace(*key, std::move(entry));
+            }
+        }
+    } catch (std::exception const& e) {
+        // Anything missing will be resolved on first use.
+        SIMPLEBLE_LOG_WARN(fmt::format("Failed to index characteristics: {}", e.what()));
+    }
+
+    characteristic_cache_.assign(std::move(cache));
+}
+
+void PeripheralLinux::_clear_characteristic_cache() noexcept { characteristic_cache_.clear(); }
+
 std::shared_ptr<SimpleBluez::Characteristic> PeripheralLinux::_get_characteristic(
     BluetoothUUID const& service_uuid, BluetoothUUID const& characteristic_uuid) {
     try {
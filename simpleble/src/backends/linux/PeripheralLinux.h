@@ -8,13 +8,20 @@
 #include <simplebluez/standard/Characteristic.h>
 #include <simplebluez/standard/Device.h>
 
+#include "../common/CharacteristicIndex.h"
+#include "../common/NotifySubscriptions.h"
 #include "../common/PeripheralBase.h"
 
 #include <kvn_safe_callback.hpp>
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace SimpleBLE {
 
@@ -32,6 +39,7 @@ class PeripheralLinux : public SimpleBLE::PeripheralBase {
 
     virtual int16_t tx_power() override;
     virtual uint16_t mtu() override;
+    virtual std::string adapter_identifier() override;
 
     virtual void connect() override;
     virtual void disconnect() override;
@@ -41,6 +49,7 @@ class PeripheralLinux : public SimpleBLE::PeripheralBase {
     virtual void unpair() override;
 
     virtual std::vector<std::shared_ptr<ServiceBase>> available_services() override;
+    virtual std::shared_ptr<const std::vector<std::shared_ptr<ServiceBase>>> services_snapshot() override;
     virtual std::vector<std::shared_ptr<ServiceBase>> advertised_services() override;
 
     virtual std::map<uint16_t, ByteArray> manufacturer_data() override;
@@ -55,6 +64,10 @@ class PeripheralLinux : public SimpleBLE::PeripheralBase {
 
     virtual ByteArray read(BluetoothUUID const& service, BluetoothUUID const& characteristic, BluetoothUUID const& descriptor) override;
     virtual void write(BluetoothUUID const& service, BluetoothUUID const& characteristic, BluetoothUUID const& descriptor, ByteArray const& data) override;
+
+    virtual std::future<ByteArray> read_async(BluetoothUUID const& service, BluetoothUUID const& characteristic) override;
+    virtual std::future<void> write_request_async(BluetoothUUID const& service, BluetoothUUID const& characteristic, ByteArray const& data) override;
+    virtual std::future<void> write_command_async(BluetoothUUID const& service, BluetoothUUID const& characteristic, ByteArray const& data) override;
     // clang-format on
 
     virtual void set_callback_on_connected(std::function<void()> on_connected) override;
@@ -75,6 +88,34 @@ class PeripheralLinux : public SimpleBLE::PeripheralBase {
     kvn::safe_callback<void()> callback_on_connected_;
     kvn::safe_callback<void()> callback_on_disconnected_;
 
+    // Characteristics resolved for the current connection, so that GATT operations don't have to walk
+    // the object tree and flag strings every time.
+    struct CharacteristicEntry {
+        std::shared_ptr<SimpleBluez::Characteristic> characteristic;
+        CharacteristicProperties properties = CharacteristicProperty::NONE;
+    };
+
+    CharacteristicIndex<CharacteristicEntry> characteristic_cache_;
+
+    // How each characteristic is subscribed to, indexed by its object path. Subscribing, unsubscribing and
+    // falling back from an acquired socket are serialized by notify_mutex_.
+    using Subscriptions = NotifySubscriptions<std::string>;
+    Subscriptions notify_subscriptions_;
+    std::mutex notify_mutex_;
+
+    void _subscribe_properties(std::shared_ptr<SimpleBluez::Characteristic> characteristic,
+                               std::function<void(ByteArray payload)> callback);
+    void _fall_back_to_properties(std::shared_ptr<SimpleBluez::Characteristic> characteristic,
+                                  Subscriptions::Token token, std::function<void(ByteArray payload)> callback);
+
+    // Acquires the write socket of the characteristic if BlueZ offers one and it isn't held yet.
+    void _acquire_write(std::shared_ptr<SimpleBluez::Characteristic> char_obj, BluetoothUUID const& characteristic);
+
+    CharacteristicEntry _resolve_characteristic(BluetoothUUID const& service_uuid,
+                                                BluetoothUUID const& characteristic_uuid);
+    void _build_characteristic_cache();
+    void _clear_characteristic_cache() noexcept;
+
     bool _attempt_connect();
     bool _attempt_disconnect();
     void _cleanup_characteristics(bool stop_notifications) noexcept;
@@ -129,6 +129,11 @@ SharedPtrVector<PeripheralBase> AdapterMac::retrieve_cached_peripherals(const st
 // Delegate methods passed for AdapterBaseMacOS
 
 void AdapterMac::delegate_did_discover_peripheral(void* opaque_peripheral, void* opaque_adapter, advertising_data_t advertising_data) {
+    // The scan filter is applied on the host, before any peripheral is created for the advertiser.
+    if (!_scan_filter_accepts(advertising_data)) {
+        return;
+    }
+
     bool is_new_peripheral = false;
     auto base_peripheral = get_or_create_peripheral(opaque_peripheral, opaque_adapter, advertising_data);
 
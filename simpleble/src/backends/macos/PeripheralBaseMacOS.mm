@@ -303,15 +303,12 @@ static SimpleBLE::ByteArray descriptorValueToByteArray(id value) {
                 descriptor_list.push_back(std::make_shared<SimpleBLE::DescriptorBase>(uuidToSimpleBLE(descriptor.UUID)));
             }
 
-            bool can_read = (characteristic.properties & CBCharacteristicPropertyRead) != 0;
-            bool can_write_request = (characteristic.properties & CBCharacteristicPropertyWrite) != 0;
-            bool can_write_command = (characteristic.properties & CBCharacteristicPropertyWriteWithoutResponse) != 0;
-            bool can_notify = (characteristic.properties & CBCharacteristicPropertyNotify) != 0;
-            bool can_indicate = (characteristic.properties & CBCharacteristicPropertyIndicate) != 0;
+            // The lower byte of CBCharacteristicProperties follows the Bluetooth specification, the bits above it
+            // only signal encryption requirements and aren't characteristic properties.
+            SimpleBLE::CharacteristicProperties properties = characteristic.properties & 0xFF;
 
             characteristic_list.push_back(std::make_shared<SimpleBLE::CharacteristicBase>(uuidToSimpleBLE(characteristic.UUID),
-                                                                                          descriptor_list, can_read, can_write_request,
-                                                                                          can_write_command, can_notify, can_indicate));
+                                                                                          descriptor_list, properties));
         }
         service_list.push_back(std::make_shared<SimpleBLE::ServiceBase>(uuidToSimpleBLE(service.UUID), characteristic_list));
     }
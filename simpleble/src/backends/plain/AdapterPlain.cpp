@@ -1,5 +1,6 @@
 #include <simpleble/Peripheral.h>
 
+#include "AdapterBaseTypes.h"
 #include "AdapterPlain.h"
 #include "BuilderBase.h"
 #include "CommonUtils.h"
@@ -33,7 +34,22 @@ void AdapterPlain::scan_start() {
     is_scanning_ = true;
     SAFE_CALLBACK_CALL(this->_callback_on_scan_start);
 
-    Peripheral peripheral = Factory::build(std::make_shared<PeripheralPlain>());
+    auto base_peripheral = std::make_shared<PeripheralPlain>();
+
+    advertising_data_t data{};
+    data.identifier = base_peripheral->identifier();
+    data.address_type = base_peripheral->address_type();
+    data.mac_address = base_peripheral->address();
+    data.connectable = base_peripheral->is_connectable();
+    data.rssi = base_peripheral->rssi();
+    data.tx_power = base_peripheral->tx_power();
+    data.manufacturer_data = base_peripheral->manufacturer_data();
+    if (!_scan_filter_accepts(data)) {
+        return;
+    }
+    _report_advertisement(data);
+
+    Peripheral peripheral = Factory::build(base_peripheral);
     SAFE_CALLBACK_CALL(this->_callback_on_scan_found, peripheral);
     SAFE_CALLBACK_CALL(this->_callback_on_scan_updated, peripheral);
 }
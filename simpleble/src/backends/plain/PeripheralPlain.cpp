@@ -44,7 +44,10 @@ uint16_t PeripheralPlain::mtu() {
     }
 }
 
+std::string PeripheralPlain::adapter_identifier() { return "Plain Adapter"; }
+
 void PeripheralPlain::connect() {
+    invalidate_services_snapshot();
     connected_ = true;
     paired_ = true;
     SAFE_CALLBACK_CALL(this->callback_on_connected_);
@@ -52,6 +55,7 @@ void PeripheralPlain::connect() {
 
 void PeripheralPlain::disconnect() {
     connected_ = false;
+    invalidate_services_snapshot();
     SAFE_CALLBACK_CALL(this->callback_on_disconnected_);
 }
 bool PeripheralPlain::is_connected() { return connected_; }
@@ -69,15 +73,20 @@ SharedPtrVector<ServiceBase> PeripheralPlain::available_services() {
     SharedPtrVector<DescriptorBase> battery_descriptors = {
         std::make_shared<DescriptorBase>(CLIENT_CONFIGURATION_DESCRIPTOR_UUID)};
     SharedPtrVector<CharacteristicBase> battery_characteristics = {std::make_shared<CharacteristicBase>(
-        BATTERY_CHARACTERISTIC_UUID, battery_descriptors, true, false, false, true, false)};
+        BATTERY_CHARACTERISTIC_UUID, battery_descriptors, CharacteristicProperty::READ | CharacteristicProperty::NOTIFY)};
     SharedPtrVector<CharacteristicBase> test_characteristics = {std::make_shared<CharacteristicBase>(
-        TEST_CHARACTERISTIC_UUID, SharedPtrVector<DescriptorBase>{}, true, true, true, false, false)};
+        TEST_CHARACTERISTIC_UUID, SharedPtrVector<DescriptorBase>{},
+        CharacteristicProperty::READ | CharacteristicProperty::WRITE_REQUEST | CharacteristicProperty::WRITE_COMMAND)};
 
     service_list.push_back(std::make_shared<ServiceBase>(BATTERY_SERVICE_UUID, battery_characteristics));
     service_list.push_back(std::make_shared<ServiceBase>(TEST_SERVICE_UUID, test_characteristics));
     return service_list;
 }
 
+std::shared_ptr<const SharedPtrVector<ServiceBase>> PeripheralPlain::services_snapshot() {
+    return cached_services_snapshot();
+}
+
 SharedPtrVector<ServiceBase> PeripheralPlain::advertised_services() { return {}; }
 
 std::map<uint16_t, ByteArray> PeripheralPlain::manufacturer_data() { return {{0x004C, "test"}}; }
@@ -28,6 +28,7 @@ class PeripheralPlain : public PeripheralBase {
     virtual int16_t rssi() override;
     virtual int16_t tx_power() override;
     virtual uint16_t mtu() override;
+    virtual std::string adapter_identifier() override;
 
     virtual void connect() override;
     virtual void disconnect() override;
@@ -37,6 +38,7 @@ class PeripheralPlain : public PeripheralBase {
     virtual void unpair() override;
 
     virtual std::vector<std::shared_ptr<ServiceBase>> available_services() override;
+    virtual std::shared_ptr<const std::vector<std::shared_ptr<ServiceBase>>> services_snapshot() override;
     virtual std::vector<std::shared_ptr<ServiceBase>> advertised_services() override;
 
     virtual std::map<uint16_t, ByteArray> manufacturer_data() override;
@@ -221,6 +221,11 @@ void AdapterWindows::_scan_stopped_callback() {
 }
 
 void AdapterWindows::_scan_received_callback(advertising_data_t data) {
+    // The scan filter is applied on the host, before any peripheral is created for the advertiser.
+    if (!_scan_filter_accepts(data)) {
+        return;
+    }
+
     if (this->peripherals_.count(data.mac_address) == 0) {
         // If the incoming peripheral has never been seen before, create and save a reference to it.
         auto base_peripheral = std::make_shared<PeripheralWindows>(data);
@@ -272,15 +272,9 @@ SharedPtrVector<ServiceBase> PeripheralWindows::available_services() {
                 return (uint32_t)characteristic.obj.CharacteristicProperties();
             });
 
-            bool can_read = (properties & (uint32_t)GattCharacteristicProperties::Read) != 0;
-            bool can_write_request = (properties & (uint32_t)GattCharacteristicProperties::Write) != 0;
-            bool can_write_command = (properties & (uint32_t)GattCharacteristicProperties::WriteWithoutResponse) != 0;
-            bool can_notify = (properties & (uint32_t)GattCharacteristicProperties::Notify) != 0;
-            bool can_indicate = (properties & (uint32_t)GattCharacteristicProperties::Indicate) != 0;
-
+            // GattCharacteristicProperties shares its bit layout with CharacteristicProperties.
             characteristic_list.push_back(
-                std::make_shared<CharacteristicBase>(characteristic_uuid, descriptor_list, can_read, can_write_request,
-                                                     can_write_command, can_notify, can_indicate));
+                std::make_shared<CharacteristicBase>(characteristic_uuid, descriptor_list, properties));
         }
         service_list.push_back(std::make_shared<ServiceBase>(service_uuid, characteristic_list));
     }
@@ -98,6 +98,10 @@ void Adapter::scan_for(int timeout_ms) {
 
 bool Adapter::scan_is_active() { return (*this)->scan_is_active(); }
 
+void Adapter::set_scan_filter(const ScanFilter& filter) { (*this)->set_scan_filter(filter); }
+
+ScanFilter Adapter::scan_filter() { return (*this)->scan_filter(); }
+
 std::vector<Peripheral> Adapter::scan_get_results() { return Factory::vector((*this)->scan_get_results()); }
 
 std::vector<Peripheral> Adapter::get_paired_peripherals() { return Factory::vector((*this)->get_paired_peripherals()); }
@@ -123,3 +127,12 @@ void Adapter::set_callback_on_scan_updated(std::function<void(Peripheral)> on_sc
 void Adapter::set_callback_on_scan_found(std::function<void(Peripheral)> on_scan_found) {
     (*this)->set_callback_on_scan_found(std::move(on_scan_found));
 }
+
+void Adapter::set_callback_on_scan_batch(std::function<void(std::vector<Peripheral>)> on_scan_batch,
+                                         std::chrono::milliseconds interval) {
+    (*this)->set_callback_on_scan_batch(std::move(on_scan_batch), interval);
+}
+
+void Adapter::set_callback_on_advertisement(std::function<void(const AdvertisementReport&)> on_advertisement) {
+    (*this)->set_callback_on_advertisement(std::move(on_advertisement));
+}
@@ -1,4 +1,5 @@
 #include "simpleble/Advanced.h"
+#include "simpleble/Exceptions.h"
 
 #if defined(_WIN32)
 namespace SimpleBLE::Advanced::Windows {}
@@ -51,6 +52,21 @@ void set_context(jobject context) { SimpleBLE::BackendAndroid::set_application_c
 #endif
 
 #if defined(__linux__) && !defined(__ANDROID__)
-namespace SimpleBLE::Advanced::Linux {}
+#if SIMPLEBLE_BACKEND_LINUX
+#include "BuilderBase.h"
+#include "backends/linux/AdapterLinux.h"
+#endif
+
+namespace SimpleBLE::Advanced::Linux {
+
+PeripheralCacheStats peripheral_cache_stats([[maybe_unused]] Adapter& adapter) {
+#if SIMPLEBLE_BACKEND_LINUX
+    return Factory::get_internal<AdapterLinux>(adapter).peripheral_cache_stats();
+#else
+    throw Exception::OperationNotSupported();
+#endif
+}
+
+}  // namespace SimpleBLE::Advanced::Linux
 
 #endif
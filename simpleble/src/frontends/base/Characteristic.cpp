@@ -10,31 +10,34 @@ BluetoothUUID Characteristic::uuid() { return (*this)->uuid(); }
 std::vector<Descriptor> Characteristic::descriptors() { return Factory::vector((*this)->descriptors()); }
 
 std::vector<std::string> Characteristic::capabilities() {
+    const CharacteristicProperties properties = (*this)->properties();
     std::vector<std::string> capabilities;
 
-    if (can_read()) {
+    if (properties & CharacteristicProperty::READ) {
         capabilities.push_back("read");
     }
 
-    if (can_write_request()) {
+    if (properties & CharacteristicProperty::WRITE_REQUEST) {
         capabilities.push_back("write_request");
     }
 
-    if (can_write_command()) {
+    if (properties & CharacteristicProperty::WRITE_COMMAND) {
         capabilities.push_back("write_command");
     }
 
-    if (can_notify()) {
+    if (properties & CharacteristicProperty::NOTIFY) {
         capabilities.push_back("notify");
     }
 
-    if (can_indicate()) {
+    if (properties & CharacteristicProperty::INDICATE) {
         capabilities.push_back("indicate");
     }
 
     return capabilities;
 }
 
+CharacteristicProperties Characteristic::properties() { return (*this)->properties(); }
+
 bool Characteristic::initialized() const { return internal_ != nullptr; }
 
 CharacteristicBase* Characteristic::operator->() {
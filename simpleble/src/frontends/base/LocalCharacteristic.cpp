@@ -29,6 +29,13 @@ ByteArray Characteristic::value() { return (*this)->value(); }
 
 void Characteristic::set_value(ByteArray value) { (*this)->set_value(std::move(value)); }
 
+void Characteristic::notify(ByteArray value) { (*this)->notify({std::move(value)}); }
+
+void Characteristic::notify(const std::vector<ByteArray>& values) {
+    if (values.empty()) return;
+    (*this)->notify(values);
+}
+
 void Characteristic::set_callback_on_read(std::function<ByteArray()> on_read) {
     (*this)->set_callback_on_read(std::move(on_read));
 }
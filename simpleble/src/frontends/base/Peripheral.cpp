@@ -1,11 +1,62 @@
 #include <simpleble/Peripheral.h>
 
 #include <simpleble/Exceptions.h>
+#include <simpleble/Metrics.h>
 #include "BuildVec.h"
 #include "PeripheralBase.h"
 
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
 using namespace SimpleBLE;
 
+namespace {
+
+// Runs an operation of the peripheral, recording its latency, or counting it as failed, when metrics are enabled.
+template <typename Operation>
+auto measure(PeripheralBase* peripheral, const char* operation, Operation&& run) -> decltype(run()) {
+    if (!Metrics::is_enabled()) return run();
+
+    try {
+        Metrics::Timer timer(peripheral->metrics_series(operation));
+        return run();
+    } catch (...) {
+        peripheral->metrics_series(std::string(operation) + "_failed").increment();
+        throw;
+    }
+}
+
+// Counts the payloads received by a subscription and times the callback of the user.
+std::function<void(ByteArray payload)> measure_callback(PeripheralBase* peripheral, const char* operation,
+                                                        std::function<void(ByteArray payload)> callback) {
+    if (!callback) return callback;
+
+    // The series is only created once a payload arrives with metrics enabled, and then reused by the subscription.
+    struct Subscription {
+        Metrics::Key key;
+        std::once_flag resolved;
+        std::optional<Metrics::Series> series;
+    };
+    auto subscription = std::make_shared<Subscription>();
+    subscription->key = {operation, peripheral->adapter_identifier(), peripheral->address()};
+
+    return [subscription, callback = std::move(callback)](ByteArray payload) {
+        if (!Metrics::is_enabled()) {
+            callback(std::move(payload));
+            return;
+        }
+
+        std::call_once(subscription->resolved, [&subscription] { subscription->series.emplace(subscription->key); });
+        subscription->series->increment();
+        Metrics::Timer timer(*subscription->series);
+        callback(std::move(payload));
+    };
+}
+
+}  // namespace
+
 bool Peripheral::initialized() const { return internal_ != nullptr; }
 
 PeripheralBase* Peripheral::operator->() {
@@ -34,9 +85,13 @@ int16_t Peripheral::tx_power() { return (*this)->tx_power(); }
 
 uint16_t Peripheral::mtu() { return (*this)->mtu(); }
 
-void Peripheral::connect() { return (*this)->connect(); }
+void Peripheral::connect() {
+    measure(operator->(), "connect", [this] { internal_->connect(); });
+}
 
-void Peripheral::disconnect() { return (*this)->disconnect(); }
+void Peripheral::disconnect() {
+    measure(operator->(), "disconnect", [this] { internal_->disconnect(); });
+}
 
 bool Peripheral::is_connected() { return (*this)->is_connected(); }
 
@@ -47,7 +102,23 @@ bool Peripheral::is_paired() { return (*this)->is_paired(); }
 void Peripheral::unpair() { return (*this)->unpair(); }
 
 std::vector<Service> Peripheral::services() {
-    return Factory::vector(is_connected() ? internal_->available_services() : internal_->advertised_services());
+    if (!is_connected()) return Factory::vector(internal_->advertised_services());
+
+    return Factory::vector(*internal_->services_snapshot());
+}
+
+size_t Peripheral::services_count() {
+    if (!is_connected()) return internal_->advertised_services().size();
+
+    return internal_->services_snapshot()->size();
+}
+
+Service Peripheral::service(size_t index) {
+    if (!is_connected()) return Factory::build(internal_->advertised_services().at(index));
+
+    // Holding on to the snapshot keeps the service alive even if the database is rebuilt meanwhile.
+    auto snapshot = internal_->services_snapshot();
+    return Factory::build(snapshot->at(index));
 }
 
 std::map<uint16_t, ByteArray> Peripheral::manufacturer_data() { return (*this)->manufacturer_data(); }
@@ -55,55 +126,110 @@ std::map<uint16_t, ByteArray> Peripheral::manufacturer_data() { return (*this)->
 ByteArray Peripheral::read(BluetoothUUID const& service, BluetoothUUID const& characteristic) {
     if (!is_connected()) throw Exception::NotConnected();
 
-    return internal_->read(service, characteristic);
+    return measure(internal_.get(), "read", [&] { return internal_->read(service, characteristic); });
 }
 
 void Peripheral::write_request(BluetoothUUID const& service, BluetoothUUID const& characteristic,
                                ByteArray const& data) {
     if (!is_connected()) throw Exception::NotConnected();
 
-    internal_->write_request(service, characteristic, data);
+    measure(internal_.get(), "write_request", [&] { internal_->write_request(service, characteristic, data); });
 }
 
 void Peripheral::write_command(BluetoothUUID const& service, BluetoothUUID const& characteristic,
                                ByteArray const& data) {
     if (!is_connected()) throw Exception::NotConnected();
 
-    internal_->write_command(service, characteristic, data);
+    measure(internal_.get(), "write_command", [&] { internal_->write_command(service, characteristic, data); });
 }
 
 void Peripheral::notify(BluetoothUUID const& service, BluetoothUUID const& characteristic,
                         std::function<void(ByteArray payload)> callback) {
+    notify(service, characteristic, std::move(callback), NotificationDelivery());
+}
+
+void Peripheral::indicate(BluetoothUUID const& service, BluetoothUUID const& characteristic,
+                          std::function<void(ByteArray payload)> callback) {
+    indicate(service, characteristic, std::move(callback), NotificationDelivery());
+}
+
+void Peripheral::notify(BluetoothUUID const& service, BluetoothUUID const& characteristic,
+                        std::function<void(ByteArray payload)> callback, const NotificationDelivery& delivery) {
     if (!is_connected()) throw Exception::NotConnected();
 
-    internal_->notify(service, characteristic, std::move(callback));
+    callback = measure_callback(internal_.get(), "notification", std::move(callback));
+    if (delivery.mode == NotificationDelivery::Mode::QUEUED) {
+        internal_->subscribe_queued(service, characteristic, std::move(callback), delivery,
+                                    [&](std::function<void(ByteArray payload)> queued_callback) {
+                                        internal_->notify(service, characteristic, std::move(queued_callback));
+                                    });
+    } else {
+        internal_->notify(service, characteristic, std::move(callback));
+        internal_->release_notification_queue(service, characteristic);
+    }
 }
 
 void Peripheral::indicate(BluetoothUUID const& service, BluetoothUUID const& characteristic,
-                          std::function<void(ByteArray payload)> callback) {
+                          std::function<void(ByteArray payload)> callback, const NotificationDelivery& delivery) {
     if (!is_connected()) throw Exception::NotConnected();
 
-    internal_->indicate(service, characteristic, std::move(callback));
+    callback = measure_callback(internal_.get(), "indication", std::move(callback));
+    if (delivery.mode == NotificationDelivery::Mode::QUEUED) {
+        internal_->subscribe_queued(service, characteristic, std::move(callback), delivery,
+                                    [&](std::function<void(ByteArray payload)> queued_callback) {
+                                        internal_->indicate(service, characteristic, std::move(queued_callback));
+                                    });
+    } else {
+        internal_->indicate(service, characteristic, std::move(callback));
+        internal_->release_notification_queue(service, characteristic);
+    }
 }
 
 void Peripheral::unsubscribe(BluetoothUUID const& service, BluetoothUUID const& characteristic) {
     if (!is_connected()) throw Exception::NotConnected();
 
     internal_->unsubscribe(service, characteristic);
+    internal_->release_notification_queue(service, characteristic);
+}
+
+NotificationStats Peripheral::notification_stats(BluetoothUUID const& service, BluetoothUUID const& characteristic) {
+    return internal_->notification_stats(service, characteristic);
 }
 
 ByteArray Peripheral::read(BluetoothUUID const& service, BluetoothUUID const& characteristic,
                            BluetoothUUID const& descriptor) {
     if (!is_connected()) throw Exception::NotConnected();
 
-    return internal_->read(service, characteristic, descriptor);
+    return measure(internal_.get(), "read_descriptor",
+                   [&] { return internal_->read(service, characteristic, descriptor); });
 }
 
 void Peripheral::write(BluetoothUUID const& service, BluetoothUUID const& characteristic,
                        BluetoothUUID const& descriptor, ByteArray const& data) {
     if (!is_connected()) throw Exception::NotConnected();
 
-    internal_->write(service, characteristic, descriptor, data);
+    measure(internal_.get(), "write_descriptor",
+            [&] { internal_->write(service, characteristic, descriptor, data); });
+}
+
+std::future<ByteArray> Peripheral::read_async(BluetoothUUID const& service, BluetoothUUID const& characteristic) {
+    if (!is_connected()) throw Exception::NotConnected();
+
+    return internal_->read_async(service, characteristic);
+}
+
+std::future<void> Peripheral::write_request_async(BluetoothUUID const& service, BluetoothUUID const& characteristic,
+                                                  ByteArray const& data) {
+    if (!is_connected()) throw Exception::NotConnected();
+
+    return internal_->write_request_async(service, characteristic, data);
+}
+
+std::future<void> Peripheral::write_command_async(BluetoothUUID const& service, BluetoothUUID const& characteristic,
+                                                  ByteArray const& data) {
+    if (!is_connected()) throw Exception::NotConnected();
+
+    return internal_->write_command_async(service, characteristic, data);
 }
 
 void Peripheral::set_callback_on_connected(std::function<void()> on_connected) {
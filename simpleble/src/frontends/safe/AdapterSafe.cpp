@@ -89,6 +89,23 @@ std::optional<std::vector<SPeripheral>> SAdapter::get_paired_peripherals() noexc
     return std::nullopt;
 }
 
+bool SAdapter::set_scan_filter(const ScanFilter& filter) noexcept {
+    try {
+        internal_.set_scan_filter(filter);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+std::optional<ScanFilter> SAdapter::scan_filter() noexcept {
+    try {
+        return internal_.scan_filter();
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
 bool SAdapter::set_callback_on_scan_start(std::function<void()> on_scan_start) noexcept {
     try {
         internal_.set_callback_on_scan_start(std::move(on_scan_start));
@@ -126,6 +143,39 @@ bool SAdapter::set_callback_on_scan_found(std::function<void(SPeripheral)> on_sc
     }
 }
 
+bool SAdapter::set_callback_on_scan_batch(std::function<void(std::vector<SPeripheral>)> on_scan_batch,
+                                          std::chrono::milliseconds interval) noexcept {
+    try {
+        if (!on_scan_batch) {
+            internal_.set_callback_on_scan_batch(nullptr, interval);
+            return true;
+        }
+
+        internal_.set_callback_on_scan_batch(
+            [on_scan_batch = std::move(on_scan_batch)](std::vector<SimpleBLE::Peripheral> peripherals) {
+                std::vector<SPeripheral> r;
+                r.reserve(peripherals.size());
+                for (auto& p : peripherals) {
+                    r.push_back(std::move(p));
+                }
+                on_scan_batch(std::move(r));
+            },
+            interval);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool SAdapter::set_callback_on_advertisement(std::function<void(const AdvertisementReport&)> on_advertisement) noexcept {
+    try {
+        internal_.set_callback_on_advertisement(std::move(on_advertisement));
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
 // NOTE: this should be the implementation once per-adapters are supported
 /*
 std::optional<bool> SAdapter::bluetooth_enabled() noexcept {
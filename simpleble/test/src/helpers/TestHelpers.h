@@ -0,0 +1,79 @@
+#pragma once
+
+#include <simpleble/Adapter.h>
+#include <simpleble/Peripheral.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// First adapter of the backend under test, or an uninitialized one if there is none.
+inline SimpleBLE::Adapter get_adapter() {
+    auto adapters = SimpleBLE::Adapter::get_adapters();
+    return adapters.empty() ? SimpleBLE::Adapter() : adapters.front();
+}
+
+// First peripheral found by a scan of the first adapter, or an uninitialized one if there is none.
+inline SimpleBLE::Peripheral get_peripheral() {
+    SimpleBLE::Adapter adapter = get_adapter();
+    if (!adapter.initialized()) return SimpleBLE::Peripheral();
+
+    adapter.scan_start();
+    adapter.scan_stop();
+
+    auto peripherals = adapter.scan_get_results();
+    return peripherals.empty() ? SimpleBLE::Peripheral() : peripherals.front();
+}
+
+inline SimpleBLE::Peripheral get_connected_peripheral() {
+    SimpleBLE::Peripheral peripheral = get_peripheral();
+    if (peripheral.initialized()) peripheral.connect();
+    return peripheral;
+}
+
+// Records what a callback receives, and can hold the thread delivering it inside the callback.
+template <typename Entry>
+struct Recorder {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Entry> entries;
+    // Thread that delivered the last entry.
+    std::thread::id thread_id;
+    bool held = false;
+    bool entered = false;
+
+    void record(Entry entry) {
+        std::unique_lock lock(mutex);
+        thread_id = std::this_thread::get_id();
+        entered = true;
+        cv.notify_all();
+        cv.wait(lock, [this] { return !held; });
+        entries.push_back(std::move(entry));
+        cv.notify_all();
+    }
+
+    void hold() {
+        std::scoped_lock lock(mutex);
+        held = true;
+    }
+
+    void release() {
+        std::scoped_lock lock(mutex);
+        held = false;
+        cv.notify_all();
+    }
+
+    bool wait_entered() {
+        std::unique_lock lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(2), [this] { return entered; });
+    }
+
+    bool wait_for_entries(size_t count) {
+        std::unique_lock lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(2), [&] { return entries.size() >= count; });
+    }
+};
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <simpleble/Adapter.h>
+
+#include <chrono>
+#include <vector>
+
+#include "helpers/TestHelpers.h"
+
+using namespace SimpleBLE;
+
+TEST(AdvertisementReport, ReportsEveryAdvertisement) {
+    Adapter adapter = get_adapter();
+    ASSERT_TRUE(adapter.initialized());
+
+    std::vector<AdvertisementReport> reports;
+    adapter.set_callback_on_advertisement([&reports](const AdvertisementReport& report) { reports.push_back(report); });
+
+    // Each scan of the plain backend receives a single advertisement of the same peripheral.
+    const auto start = std::chrono::steady_clock::now();
+    adapter.scan_start();
+    adapter.scan_start();
+    adapter.scan_start();
+    adapter.set_callback_on_advertisement(nullptr);
+
+    ASSERT_EQ(3, reports.size());
+    for (size_t i = 0; i < reports.size(); i++) {
+        EXPECT_EQ("11:22:33:44:55:66", reports[i].address);
+        EXPECT_EQ("Plain Peripheral", reports[i].identifier);
+        EXPECT_EQ(-60, reports[i].rssi);
+        EXPECT_EQ(5, reports[i].tx_power);
+        ASSERT_EQ(1, reports[i].manufacturer_data.count(0x004C));
+        EXPECT_EQ(ByteArray("test"), reports[i].manufacturer_data.at(0x004C));
+
+        EXPECT_LE(start, reports[i].timestamp);
+        if (i > 0) {
+            EXPECT_LE(reports[i - 1].timestamp, reports[i].timestamp);
+        }
+    }
+}
+
+TEST(AdvertisementReport, FollowsScanFilter) {
+    Adapter adapter = get_adapter();
+    ASSERT_TRUE(adapter.initialized());
+
+    size_t reports = 0;
+    adapter.set_callback_on_advertisement([&reports](const AdvertisementReport&) { reports++; });
+
+    ScanFilter filter;
+    filter.pattern = "Other";
+    adapter.set_scan_filter(filter);
+    adapter.scan_start();
+    EXPECT_EQ(0, reports);
+
+    adapter.set_scan_filter(ScanFilter());
+    adapter.scan_start();
+    EXPECT_EQ(1, reports);
+
+    adapter.set_callback_on_advertisement(nullptr);
+    adapter.scan_start();
+    EXPECT_EQ(1, reports);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "backends/common/CharacteristicIndex.h"
+
+using namespace SimpleBLE;
+
+namespace {
+
+using Index = CharacteristicIndex<int>;
+
+const BluetoothUUID BATTERY_SERVICE = "0000180f-0000-1000-8000-00805f9b34fb";
+const BluetoothUUID BATTERY_LEVEL = "00002a19-0000-1000-8000-00805f9b34fb";
+
+}  // namespace
+
+TEST(CharacteristicIndex, EverySpellingFindsTheSameEntry) {
+    Index index;
+    index.insert(*Index::key(BATTERY_SERVICE, BATTERY_LEVEL), 1);
+
+    EXPECT_EQ(index.find(*Index::key("180F", "2A19")), 1);
+    EXPECT_EQ(index.find(*Index::key("0000180F-0000-1000-8000-00805F9B34FB", "2a19")), 1);
+    EXPECT_FALSE(index.find(*Index::key(BATTERY_LEVEL, BATTERY_SERVICE)));
+}
+
+TEST(CharacteristicIndex, InsertReplacesEntry) {
+    Index index;
+    auto key = *Index::key(BATTERY_SERVICE, BATTERY_LEVEL);
+    index.insert(key, 1);
+    index.insert(key, 2);
+
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_EQ(index.find(key), 2);
+}
+
+TEST(CharacteristicIndex, AssignReplacesAllEntries) {
+    Index index;
+    index.insert(*Index::key(BATTERY_SERVICE, BATTERY_LEVEL), 1);
+
+    Index::Entries entries;
+    entries.emplace(*Index::key("1800", "2A00"), 2);
+    index.assign(std::move(entries));
+
+    EXPECT_EQ(index.size(), 1);
+    EXPECT_FALSE(index.find(*Index::key(BATTERY_SERVICE, BATTERY_LEVEL)));
+    EXPECT_EQ(index.find(*Index::key("1800", "2A00")), 2);
+}
+
+TEST(CharacteristicIndex, ClearRemovesAllEntries) {
+    Index index;
+    index.insert(*Index::key(BATTERY_SERVICE, BATTERY_LEVEL), 1);
+    index.clear();
+
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_FALSE(index.find(*Index::key(BATTERY_SERVICE, BATTERY_LEVEL)));
+}
+
+TEST(CharacteristicIndex, UnparseableUuidsHaveNoKey) {
+    EXPECT_FALSE(Index::key("not-a-uuid", BATTERY_LEVEL));
+    EXPECT_FALSE(Index::key(BATTERY_SERVICE, "2A1"));
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <simpleble/Peripheral.h>
+
+#include <string>
+#include <vector>
+
+#include "helpers/TestHelpers.h"
+
+using namespace SimpleBLE;
+
+namespace {
+
+Characteristic find_characteristic(Peripheral& peripheral, const BluetoothUUID& uuid) {
+    for (auto& service : peripheral.services()) {
+        for (auto& characteristic : service.characteristics()) {
+            if (characteristic.uuid() == uuid) return characteristic;
+        }
+    }
+    return Characteristic();
+}
+
+}  // namespace
+
+TEST(CharacteristicProperties, MatchCapabilities) {
+    Peripheral peripheral = get_connected_peripheral();
+    ASSERT_TRUE(peripheral.initialized());
+
+    Characteristic battery = find_characteristic(peripheral, "00002a19-0000-1000-8000-00805f9b34fb");
+    ASSERT_TRUE(battery.initialized());
+    EXPECT_EQ(CharacteristicProperty::READ | CharacteristicProperty::NOTIFY, battery.properties());
+    EXPECT_EQ(std::vector<std::string>({"read", "notify"}), battery.capabilities());
+    EXPECT_TRUE(battery.can_read());
+    EXPECT_TRUE(battery.can_notify());
+    EXPECT_FALSE(battery.can_write_request());
+    EXPECT_FALSE(battery.can_write_command());
+    EXPECT_FALSE(battery.can_indicate());
+
+    peripheral.disconnect();
+}
+
+TEST(CharacteristicProperties, FollowSpecificationLayout) {
+    // The backends pass the platform bitmasks through, which all follow the Bluetooth Core Specification.
+    static_assert(CharacteristicProperty::BROADCAST == 0x01);
+    static_assert(CharacteristicProperty::READ == 0x02);
+    static_assert(CharacteristicProperty::WRITE_COMMAND == 0x04);
+    static_assert(CharacteristicProperty::WRITE_REQUEST == 0x08);
+    static_assert(CharacteristicProperty::NOTIFY == 0x10);
+    static_assert(CharacteristicProperty::INDICATE == 0x20);
+    static_assert(CharacteristicProperty::AUTHENTICATED_SIGNED_WRITES == 0x40);
+    static_assert(CharacteristicProperty::EXTENDED_PROPERTIES == 0x80);
+    static_assert(CharacteristicProperty::RELIABLE_WRITE == 0x100);
+    static_assert(CharacteristicProperty::WRITABLE_AUXILIARIES == 0x200);
+}
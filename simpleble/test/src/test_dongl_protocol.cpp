@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "backends/dongl/serial/ProtocolBase.h"
+#include "backends/dongl/usb/UsbHelperImpl.h"
+#include "nanopb/pb_decode.h"
+#include "nanopb/pb_encode.h"
+
+using namespace SimpleBLE::Dongl;
+
+namespace {
+
+/**
+ * Stand-in for the USB link that answers every read command itself.
+ *
+ * Responses can either be sent immediately or held back, so that tests can
+ * control the order in which they reach the host.
+ */
+class LoopbackUsbHelper : public USB::UsbHelperImpl {
+  public:
+    LoopbackUsbHelper(bool immediate) : UsbHelperImpl("loopback"), _immediate(immediate) {}
+
+    void tx(const uint8_t* data, size_t length) override {
+        const size_t payload_length = data[1] | (data[2] << 8);
+        if (length != Serial::Wire::HEADER_SIZE + payload_length + Serial::Wire::TRAILER_SIZE) {
+            throw std::runtime_error("Unexpected frame length");
+        }
+
+        dongl_Command command = dongl_Command_init_zero;
+        pb_istream_t stream = pb_istream_from_buffer(data + 3, payload_length);
+        if (!pb_decode(&stream, dongl_Command_fields, &command)) {
+            throw std::runtime_error("Failed to decode command");
+        }
+
+        {
+            std::scoped_lock lock(_mutex);
+            _commands.push_back(command);
+        }
+
+        if (_immediate) {
+            _respond(command);
+        }
+    }
+
+    void set_rx_callback(std::function<void(const kvn::bytearray&)> callback) override {
+        _rx_callback.load(std::move(callback));
+    }
+
+    size_t commands_received() {
+        std::scoped_lock lock(_mutex);
+        return _commands.size();
+    }
+
+    void respond_in_order() {
+        std::vector<dongl_Command> commands;
+        {
+            std::scoped_lock lock(_mutex);
+            commands.swap(_commands);
+        }
+        for (const auto& command : commands) {
+            _respond(command);
+        }
+    }
+
+    // Sends a response to a command that was never sent, as a confused dongle would.
+    void respond_to_write(uint16_t conn_handle) {
+        dongl_D2H d2h = dongl_D2H_init_zero;
+        d2h.which_type = dongl_D2H_rsp_tag;
+        d2h.type.rsp.which_rsp = dongl_Response_simpleble_tag;
+        d2h.type.rsp.rsp.simpleble.which_rsp = simpleble_Response_write_tag;
+        d2h.type.rsp.rsp.simpleble.rsp.write.conn_handle = conn_handle;
+        _send(d2h);
+    }
+
+  private:
+    void _respond(const dongl_Command& command) {
+        const auto& read = command.cmd.simpleble.cmd.read;
+
+        dongl_D2H d2h = dongl_D2H_init_zero;
+        d2h.which_type = dongl_D2H_rsp_tag;
+        d2h.type.rsp.which_rsp = dongl_Response_simpleble_tag;
+        d2h.type.rsp.rsp.simpleble.which_rsp = simpleble_Response_read_tag;
+        d2h.type.rsp.rsp.simpleble.rsp.read.conn_handle = read.conn_handle;
+        d2h.type.rsp.rsp.simpleble.rsp.read.data.size = 2;
+        d2h.type.rsp.rsp.simpleble.rsp.read.data.bytes[0] = read.handle & 0xFF;
+        d2h.type.rsp.rsp.simpleble.rsp.read.data.bytes[1] = read.handle >> 8;
+        _send(d2h);
+    }
+
+    void _send(const dongl_D2H& d2h) {
+        uint8_t payload[dongl_D2H_size];
+        pb_ostream_t stream = pb_ostream_from_buffer(payload, sizeof(payload));
+        if (!pb_encode(&stream, dongl_D2H_fields, &d2h)) {
+            throw std::runtime_error("Failed to encode response");
+        }
+
+        const uint16_t crc = Serial::Wire::crc16(payload, stream.bytes_written);
+        std::vector<uint8_t> frame = {Serial::Wire::SYNC_BYTE, uint8_t(stream.bytes_written & 0xFF),
+                                      uint8_t(stream.bytes_written >> 8)};
+        frame.insert(frame.end(), payload, payload + stream.bytes_written);
+        frame.push_back(uint8_t(crc & 0xFF));
+        frame.push_back(uint8_t(crc >> 8));
+        _rx_callback(kvn::bytearray(frame));
+    }
+
+    bool _immediate;
+    std::mutex _mutex;
+    std::vector<dongl_Command> _commands;
+};
+
+std::unique_ptr<Serial::ProtocolBase> make_protocol(LoopbackUsbHelper*& loopback, bool immediate) {
+    auto impl = std::make_unique<LoopbackUsbHelper>(immediate);
+    loopback = impl.get();
+    auto usb_helper = std::make_unique<USB::UsbHelper>(std::move(impl));
+    return std::make_unique<Serial::ProtocolBase>(std::make_unique<Serial::Wire>(std::move(usb_helper)));
+}
+
+dongl_Command read_command(uint16_t conn_handle, uint16_t handle) {
+    dongl_Command command = dongl_Command_init_zero;
+    command.which_cmd = dongl_Command_simpleble_tag;
+    command.cmd.simpleble.which_cmd = simpleble_Command_read_tag;
+    command.cmd.simpleble.cmd.read.conn_handle = conn_handle;
+    command.cmd.simpleble.cmd.read.handle = handle;
+    return command;
+}
+
+uint16_t read_handle(const dongl_Response& response) {
+    const auto& data = response.rsp.simpleble.rsp.read.data;
+    return data.bytes[0] | (data.bytes[1] << 8);
+}
+
+}  // namespace
+
+TEST(DonglProtocol, ExchangeRoundTrip) {
+    LoopbackUsbHelper* loopback = nullptr;
+    auto protocol = make_protocol(loopback, true);
+
+    dongl_Response response = protocol->exchange(read_command(3, 0x1234));
+    EXPECT_EQ(3, response.rsp.simpleble.rsp.read.conn_handle);
+    EXPECT_EQ(0x1234, read_handle(response));
+}
+
+TEST(DonglProtocol, PipelinedResponsesInOrder) {
+    LoopbackUsbHelper* loopback = nullptr;
+    auto protocol = make_protocol(loopback, false);
+
+    constexpr uint16_t REQUEST_COUNT = Serial::ProtocolBase::MAX_PIPELINED_REQUESTS;
+    std::vector<std::future<dongl_Response>> responses;
+    for (uint16_t i = 0; i < REQUEST_COUNT; i++) {
+        responses.push_back(protocol->exchange_async(read_command(i, 0x100 + i)));
+    }
+
+    // All requests must be on the link before any response arrives.
+    EXPECT_EQ(REQUEST_COUNT, loopback->commands_received());
+    for (auto& response : responses) {
+        EXPECT_EQ(std::future_status::timeout, response.wait_for(std::chrono::milliseconds(0)));
+    }
+
+    loopback->respond_in_order();
+
+    for (uint16_t i = 0; i < REQUEST_COUNT; i++) {
+        ASSERT_EQ(std::future_status::ready, responses[i].wait_for(std::chrono::milliseconds(0)));
+        dongl_Response response = responses[i].get();
+        EXPECT_EQ(i, response.rsp.simpleble.rsp.read.conn_handle);
+        EXPECT_EQ(0x100 + i, read_handle(response));
+    }
+}
+
+TEST(DonglProtocol, CallbackGetsResponseOrTimeout) {
+    LoopbackUsbHelper* loopback = nullptr;
+    auto protocol = make_protocol(loopback, false);
+
+    std::promise<uint16_t> answered;
+    protocol->exchange_async(read_command(1, 0x0001),
+                             [&answered](const dongl_Response& response, std::exception_ptr error) {
+                                 answered.set_value(error ? 0 : read_handle(response));
+                             });
+    loopback->respond_in_order();
+    EXPECT_EQ(0x0001, answered.get_future().get());
+
+    std::promise<std::exception_ptr> expired;
+    protocol->exchange_async(read_command(2, 0x0002), [&expired](const dongl_Response&, std::exception_ptr error) {
+        expired.set_value(error);
+    });
+    auto error = expired.get_future();
+    ASSERT_EQ(std::future_status::ready, error.wait_for(Serial::ProtocolBase::RESPONSE_TIMEOUT * 2));
+    EXPECT_THROW(std::rethrow_exception(error.get()), std::runtime_error);
+}
+
+TEST(DonglProtocol, PipelineIsBounded) {
+    LoopbackUsbHelper* loopback = nullptr;
+    auto protocol = make_protocol(loopback, false);
+
+    constexpr uint16_t REQUEST_COUNT = Serial::ProtocolBase::MAX_PIPELINED_REQUESTS;
+    std::vector<std::future<dongl_Response>> responses;
+    for (uint16_t i = 0; i < REQUEST_COUNT; i++) {
+        responses.push_back(protocol->exchange_async(read_command(i, 0x100 + i)));
+    }
+
+    auto blocked = std::async(std::launch::async, [&protocol]() {
+        return protocol->exchange_async(read_command(REQUEST_COUNT, 0x100 + REQUEST_COUNT)).get();
+    });
+    EXPECT_EQ(std::future_status::timeout, blocked.wait_for(std::chrono::milliseconds(50)));
+    EXPECT_EQ(REQUEST_COUNT, loopback->commands_received());
+
+    // Once the responses are in, the waiting request goes out and can be answered in turn.
+    loopback->respond_in_order();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (loopback->commands_received() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    loopback->respond_in_order();
+    EXPECT_EQ(REQUEST_COUNT, blocked.get().rsp.simpleble.rsp.read.conn_handle);
+}
+
+TEST(DonglProtocol, ConcurrentCallersGetTheirOwnResponses) {
+    LoopbackUsbHelper* loopback = nullptr;
+    auto protocol = make_protocol(loopback, true);
+
+    constexpr uint16_t THREAD_COUNT = 4;
+    constexpr uint16_t EXCHANGE_COUNT = 100;
+    std::vector<std::future<bool>> callers;
+    for (uint16_t t = 0; t < THREAD_COUNT; t++) {
+        callers.push_back(std::async(std::launch::async, [&protocol, t]() {
+            for (uint16_t i = 0; i < EXCHANGE_COUNT; i++) {
+                dongl_Response response = protocol->exchange(read_command(t, i));
+                if (response.rsp.simpleble.rsp.read.conn_handle != t || read_handle(response) != i) return false;
+            }
+            return true;
+        }));
+    }
+
+    for (auto& caller : callers) {
+        EXPECT_TRUE(caller.get());
+    }
+}
+
+TEST(DonglProtocol, LateResponseIsDropped) {
+    LoopbackUsbHelper* loopback = nullptr;
+    auto protocol = make_protocol(loopback, false);
+
+    EXPECT_THROW(protocol->exchange(read_command(1, 0x0001)), std::runtime_error);
+
+    // The late response to the timed out request arrives first and must not complete the new one.
+    auto pending = protocol->exchange_async(read_command(2, 0x0002));
+    loopback->respond_in_order();
+    ASSERT_EQ(std::future_status::ready, pending.wait_for(std::chrono::milliseconds(0)));
+    EXPECT_EQ(2, pending.get().rsp.simpleble.rsp.read.conn_handle);
+}
+
+TEST(DonglProtocol, ResponseOfAnotherKindIsDropped) {
+    LoopbackUsbHelper* loopback = nullptr;
+    auto protocol = make_protocol(loopback, false);
+
+    auto pending = protocol->exchange_async(read_command(1, 0x0001));
+    loopback->respond_to_write(1);
+    EXPECT_EQ(std::future_status::timeout, pending.wait_for(std::chrono::milliseconds(0)));
+
+    loopback->respond_in_order();
+    ASSERT_EQ(std::future_status::ready, pending.wait_for(std::chrono::milliseconds(0)));
+    EXPECT_EQ(1, pending.get().rsp.simpleble.rsp.read.conn_handle);
+}
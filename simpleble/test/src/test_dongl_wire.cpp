@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "backends/dongl/serial/Wire.h"
+#include "backends/dongl/usb/UsbHelperImpl.h"
+
+using namespace SimpleBLE::Dongl;
+
+namespace {
+
+// Stand-in for the USB link that records everything sent through it.
+class CaptureUsbHelper : public USB::UsbHelperImpl {
+  public:
+    CaptureUsbHelper(std::vector<uint8_t>& output) : UsbHelperImpl("capture"), _output(output) {}
+
+    void tx(const uint8_t* data, size_t length) override { _output.insert(_output.end(), data, data + length); }
+
+    void set_rx_callback(std::function<void(const kvn::bytearray&)> callback) override {
+        _rx_callback.load(std::move(callback));
+    }
+
+  private:
+    std::vector<uint8_t>& _output;
+};
+
+struct WireHarness {
+    std::vector<uint8_t> sent;
+    std::vector<std::vector<uint8_t>> received;
+    std::vector<Serial::Wire::Error> errors;
+    Serial::Wire wire;
+
+    WireHarness() : wire(std::make_unique<USB::UsbHelper>(std::make_unique<CaptureUsbHelper>(sent))) {
+        wire.set_packet_callback(
+            [this](const uint8_t* data, size_t length) { received.emplace_back(data, data + length); });
+        wire.set_error_callback([this](Serial::Wire::Error error) { errors.push_back(error); });
+    }
+};
+
+// The bit by bit implementation the table driven one has to match.
+uint16_t crc16_reference(const uint8_t* data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x8005 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+std::vector<uint8_t> random_bytes(std::mt19937& rng, size_t length) {
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<uint8_t> data(length);
+    for (auto& byte : data) byte = dist(rng);
+    return data;
+}
+
+// Encodes the given payloads into a single stream, separated by noise without sync bytes.
+std::vector<uint8_t> encode_stream(const std::vector<std::vector<uint8_t>>& payloads) {
+    WireHarness encoder;
+    for (const auto& payload : payloads) {
+        encoder.wire.send_packet(payload);
+        encoder.sent.insert(encoder.sent.end(), {0x00, 0x55, 0xFF});
+    }
+    return encoder.sent;
+}
+
+}  // namespace
+
+TEST(DonglWire, Crc16MatchesReference) {
+    std::mt19937 rng(42);
+    for (size_t length : {0, 1, 2, 7, 8, 9, 63, 64, 571}) {
+        auto data = random_bytes(rng, length);
+        EXPECT_EQ(crc16_reference(data.data(), data.size()), Serial::Wire::crc16(data.data(), data.size()));
+    }
+}
+
+TEST(DonglWire, ParsesFramesSplitAtAnyOffset) {
+    std::mt19937 rng(7);
+    std::vector<std::vector<uint8_t>> payloads = {random_bytes(rng, 1), random_bytes(rng, 0), random_bytes(rng, 100),
+                                                  random_bytes(rng, Serial::Wire::MAX_PAYLOAD_SIZE)};
+    auto stream = encode_stream(payloads);
+
+    for (size_t split = 0; split <= stream.size(); split++) {
+        WireHarness harness;
+        harness.wire.process(stream.data(), split);
+        harness.wire.process(stream.data() + split, stream.size() - split);
+
+        ASSERT_EQ(payloads, harness.received) << "split at " << split;
+        ASSERT_TRUE(harness.errors.empty());
+    }
+}
+
+TEST(DonglWire, ParsesFramesByteByByte) {
+    std::mt19937 rng(11);
+    std::vector<std::vector<uint8_t>> payloads = {random_bytes(rng, 20), random_bytes(rng, 300)};
+    auto stream = encode_stream(payloads);
+
+    WireHarness harness;
+    for (uint8_t byte : stream) {
+        harness.wire.process(&byte, 1);
+    }
+
+    EXPECT_EQ(payloads, harness.received);
+}
+
+TEST(DonglWire, ReportsCorruptedFrames) {
+    auto stream = encode_stream({{0x01, 0x02, 0x03}, {0x04, 0x05}});
+    stream[4] ^= 0xFF;  // Corrupt the payload of the first frame.
+
+    WireHarness harness;
+    harness.wire.process(stream.data(), stream.size());
+
+    ASSERT_EQ(1, harness.errors.size());
+    EXPECT_EQ(Serial::Wire::Error::CRC_FAILURE, harness.errors[0]);
+    ASSERT_EQ(1, harness.received.size());
+    EXPECT_EQ(std::vector<uint8_t>({0x04, 0x05}), harness.received[0]);
+}
+
+TEST(DonglWire, EncodesPayloadInPlace) {
+    const std::vector<uint8_t> payload = {0x10, 0x20, 0x30, 0x40};
+
+    WireHarness reference;
+    reference.wire.send_packet(payload);
+
+    WireHarness harness;
+    harness.wire.send_packet_with([&payload](uint8_t* buffer, size_t capacity) {
+        EXPECT_EQ(Serial::Wire::MAX_PAYLOAD_SIZE, capacity);
+        std::copy(payload.begin(), payload.end(), buffer);
+        return payload.size();
+    });
+
+    EXPECT_EQ(reference.sent, harness.sent);
+    EXPECT_EQ(Serial::Wire::HEADER_SIZE + payload.size() + Serial::Wire::TRAILER_SIZE, harness.sent.size());
+}
+
+TEST(DonglWire, RejectsOversizedPayload) {
+    WireHarness harness;
+    std::vector<uint8_t> payload(Serial::Wire::MAX_PAYLOAD_SIZE + 1);
+    EXPECT_THROW(harness.wire.send_packet(payload), std::runtime_error);
+    EXPECT_THROW(harness.wire.send_packet_with([](uint8_t*, size_t capacity) { return capacity + 1; }),
+                 std::runtime_error);
+    EXPECT_TRUE(harness.sent.empty());
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LoggingInternal.h"
+#include "helpers/TestHelpers.h"
+
+using namespace SimpleBLE::Logging;
+
+namespace {
+
+struct Message {
+    Level level;
+    std::string message;
+    std::thread::id thread_id;
+};
+
+Callback log_callback(Recorder<Message>& recorder) {
+    return [&recorder](Level level, const std::string&, const std::string&, uint32_t, const std::string&,
+                       const std::string& message) { recorder.record({level, message, std::this_thread::get_id()}); };
+}
+
+// Restores the default configuration of the logger, which is shared by every test.
+class LoggingTest : public ::testing::Test {
+  protected:
+    void TearDown() override {
+        Logger::get()->set_async(false);
+        Logger::get()->set_level(Level::Info);
+        Logger::get()->log_default_stdout();
+    }
+};
+
+}  // namespace
+
+TEST_F(LoggingTest, MessagesAboveLevelAreNotFormatted) {
+    Recorder<Message> recorder;
+    Logger::get()->set_callback(log_callback(recorder));
+    Logger::get()->set_level(Level::Warn);
+
+    int formatted = 0;
+    auto message = [&formatted](const char* text) {
+        formatted++;
+        return std::string(text);
+    };
+
+    SIMPLEBLE_LOG_DEBUG(message("debug"));
+    SIMPLEBLE_LOG_INFO(message("info"));
+    SIMPLEBLE_LOG_WARN(message("warn"));
+    SIMPLEBLE_LOG_ERROR(message("error"));
+
+    EXPECT_EQ(2, formatted);
+    ASSERT_EQ(2, recorder.entries.size());
+    EXPECT_EQ(Level::Warn, recorder.entries[0].level);
+    EXPECT_EQ("error", recorder.entries[1].message);
+}
+
+TEST_F(LoggingTest, AsyncDeliversInOrderOnWriterThread) {
+    Recorder<Message> recorder;
+    Logger::get()->set_callback(log_callback(recorder));
+    Logger::get()->set_async(true, 64);
+    EXPECT_TRUE(Logger::get()->is_async());
+
+    const uint64_t dropped = Logger::get()->dropped();
+    constexpr int MESSAGE_COUNT = 32;
+    for (int i = 0; i < MESSAGE_COUNT; i++) {
+        Logger::get()->log(Level::Info, "Test", __FILE__, __LINE__, __func__, std::to_string(i));
+    }
+    Logger::get()->flush();
+
+    std::scoped_lock lock(recorder.mutex);
+    ASSERT_EQ(MESSAGE_COUNT, recorder.entries.size());
+    for (int i = 0; i < MESSAGE_COUNT; i++) {
+        EXPECT_EQ(std::to_string(i), recorder.entries[i].message);
+        EXPECT_NE(std::this_thread::get_id(), recorder.entries[i].thread_id);
+    }
+    EXPECT_EQ(dropped, Logger::get()->dropped());
+}
+
+TEST_F(LoggingTest, AsyncDropsWhenFullWithoutBlocking) {
+    Recorder<Message> recorder;
+    recorder.hold();
+    Logger::get()->set_callback(log_callback(recorder));
+    Logger::get()->set_async(true, 4);
+
+    const uint64_t dropped = Logger::get()->dropped();
+    Logger::get()->log(Level::Info, "Test", __FILE__, __LINE__, __func__, "0");
+    ASSERT_TRUE(recorder.wait_entered());
+
+    for (int i = 1; i <= 10; i++) {
+        Logger::get()->log(Level::Info, "Test", __FILE__, __LINE__, __func__, std::to_string(i));
+    }
+    EXPECT_EQ(dropped + 6, Logger::get()->dropped());
+
+    recorder.release();
+    Logger::get()->set_async(false);
+    EXPECT_FALSE(Logger::get()->is_async());
+
+    std::scoped_lock lock(recorder.mutex);
+    ASSERT_EQ(5, recorder.entries.size());
+    EXPECT_EQ("4", recorder.entries.back().message);
+}
+
+TEST_F(LoggingTest, StoppingAsyncLosesNoAcceptedMessage) {
+    Recorder<Message> recorder;
+    Logger::get()->set_callback(log_callback(recorder));
+    Logger::get()->set_async(true, 1 << 12);
+
+    // Every message is either delivered, by the sink or by the caller once the sink is gone, or counted as dropped.
+    const uint64_t dropped = Logger::get()->dropped();
+    constexpr int THREAD_COUNT = 4;
+    constexpr int MESSAGE_COUNT = 2000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([] {
+            for (int i = 0; i < MESSAGE_COUNT; i++) {
+                Logger::get()->log(Level::Info, "Test", __FILE__, __LINE__, __func__, std::to_string(i));
+            }
+        });
+    }
+    Logger::get()->set_async(false);
+    for (auto& thread : threads) thread.join();
+
+    std::scoped_lock lock(recorder.mutex);
+    EXPECT_EQ(THREAD_COUNT * MESSAGE_COUNT, recorder.entries.size() + (Logger::get()->dropped() - dropped));
+}
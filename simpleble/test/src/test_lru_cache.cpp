@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "backends/common/LruCache.h"
+
+using namespace SimpleBLE;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Cache = LruCache<std::string, int>;
+
+const Cache::Clock::time_point START;
+
+auto evictable = [](const std::string&, int) { return true; };
+
+std::vector<std::string> keys(const std::vector<std::pair<std::string, int>>& evicted) {
+    std::vector<std::string> result;
+    for (const auto& [key, value] : evicted) {
+        result.push_back(key);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(LruCache, InsertKeepsExistingValue) {
+    Cache cache;
+    cache.insert("a", 1, START);
+    EXPECT_EQ(cache.insert("a", 2, START + 1s), 1);
+
+    EXPECT_EQ(cache.size(), 1);
+    ASSERT_NE(cache.find("a"), nullptr);
+    EXPECT_EQ(*cache.find("a"), 1);
+    EXPECT_EQ(cache.find("b"), nullptr);
+}
+
+TEST(LruCache, CapacityEvictsLeastRecentlySeen) {
+    Cache cache;
+    cache.insert("a", 1, START);
+    cache.insert("b", 2, START + 1s);
+    cache.insert("c", 3, START + 2s);
+    cache.touch("a", START + 3s);
+
+    auto evicted = cache.evict(START + 3s, 2, 0s, evictable);
+    EXPECT_EQ(keys(evicted), std::vector<std::string>{"b"});
+    EXPECT_EQ(evicted.front().second, 2);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_NE(cache.find("a"), nullptr);
+    EXPECT_NE(cache.find("c"), nullptr);
+}
+
+TEST(LruCache, TtlEvictsExpiredEntries) {
+    Cache cache;
+    cache.insert("a", 1, START);
+    cache.insert("b", 2, START + 5s);
+    cache.insert("c", 3, START + 9s);
+
+    EXPECT_TRUE(cache.evict(START + 10s, 0, 10s, evictable).empty());
+
+    auto evicted = cache.evict(START + 16s, 0, 10s, evictable);
+    EXPECT_EQ(keys(evicted), (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(LruCache, TouchRefreshesTtl) {
+    Cache cache;
+    cache.insert("a", 1, START);
+    cache.touch("a", START + 8s);
+
+    EXPECT_TRUE(cache.evict(START + 12s, 0, 10s, evictable).empty());
+    EXPECT_EQ(keys(cache.evict(START + 19s, 0, 10s, evictable)), std::vector<std::string>{"a"});
+}
+
+TEST(LruCache, UnevictableEntriesAreKept) {
+    Cache cache;
+    cache.insert("a", 1, START);
+    cache.insert("b", 2, START + 1s);
+    cache.insert("c", 3, START + 2s);
+
+    auto pinned = [](const std::string& key, int) { return key != "a"; };
+    auto evicted = cache.evict(START + 2s, 1, 0s, pinned);
+    EXPECT_EQ(keys(evicted), (std::vector<std::string>{"b", "c"}));
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_NE(cache.find("a"), nullptr);
+
+    // Nothing can be evicted, so every entry is visited at most once.
+    cache.insert("d", 4, START + 3s);
+    auto nothing = [](const std::string&, int) { return false; };
+    EXPECT_TRUE(cache.evict(START + 3s, 1, 0s, nothing).empty());
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(LruCache, ZeroLimitsDisableEviction) {
+    Cache cache;
+    for (int i = 0; i < 100; i++) {
+        cache.insert(std::to_string(i), i, START);
+    }
+
+    EXPECT_TRUE(cache.evict(START + 24h, 0, 0s, evictable).empty());
+    EXPECT_EQ(cache.size(), 100);
+}
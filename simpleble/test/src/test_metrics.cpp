@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <simpleble/Adapter.h>
+#include <simpleble/Metrics.h>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#include "helpers/TestHelpers.h"
+
+using namespace SimpleBLE;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Metrics are global, so every test starts from an empty registry and leaves recording disabled.
+class MetricsTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        Metrics::reset();
+        Metrics::set_enabled(true);
+    }
+
+    void TearDown() override {
+        Metrics::set_tracing(false);
+        Metrics::set_enabled(false);
+        Metrics::reset();
+    }
+};
+
+const Metrics::Latency* find_latency(const Metrics::Snapshot& snapshot, const std::string& operation) {
+    auto it = std::find_if(snapshot.latencies.begin(), snapshot.latencies.end(), [&operation](const auto& latency) {
+        return latency.key.operation == operation;
+    });
+    return it == snapshot.latencies.end() ? nullptr : &*it;
+}
+
+}  // namespace
+
+TEST_F(MetricsTest, PercentilesAreWithinBucketResolution) {
+    const Metrics::Key key{"operation", "adapter", "peripheral"};
+    for (int i = 1; i <= 10000; i++) {
+        Metrics::record_latency(key, std::chrono::microseconds(i));
+    }
+
+    auto snapshot = Metrics::snapshot();
+    ASSERT_EQ(1, snapshot.latencies.size());
+    const Metrics::Latency& latency = snapshot.latencies.front();
+    EXPECT_EQ(key, latency.key);
+    EXPECT_EQ(10000, latency.count);
+    EXPECT_EQ(1us, latency.min);
+    EXPECT_EQ(10000us, latency.max);
+    EXPECT_EQ(std::chrono::nanoseconds(5000500), latency.mean());
+
+    for (double fraction : {0.5, 0.9, 0.99, 0.999}) {
+        const double expected = fraction * 10000e3;
+        const double actual = static_cast<double>(latency.percentile(fraction).count());
+        EXPECT_GE(actual, expected);
+        EXPECT_LE(actual, expected * (1 + 1.0 / 16));
+    }
+    EXPECT_EQ(latency.min, latency.percentile(0.0));
+    EXPECT_EQ(latency.max, latency.percentile(1.0));
+}
+
+TEST_F(MetricsTest, CountersAreKeyedAndReset) {
+    Metrics::increment({"connect_attempts", "hci0", "AA:BB:CC:DD:EE:FF"}, 3);
+    Metrics::increment({"connect_attempts", "hci0", "AA:BB:CC:DD:EE:FF"});
+    Metrics::increment({"connect_attempts", "hci1", "AA:BB:CC:DD:EE:FF"});
+
+    auto snapshot = Metrics::snapshot();
+    ASSERT_EQ(2, snapshot.counters.size());
+    EXPECT_EQ("hci0", snapshot.counters[0].key.adapter);
+    EXPECT_EQ(4, snapshot.counters[0].value);
+    EXPECT_EQ(1, snapshot.counters[1].value);
+
+    Metrics::reset();
+    EXPECT_TRUE(Metrics::snapshot().counters.empty());
+}
+
+TEST_F(MetricsTest, NothingIsRecordedWhenDisabled) {
+    Metrics::set_enabled(false);
+    Metrics::increment({"counter", "", ""});
+    { Metrics::Timer timer({"timer", "", ""}); }
+
+    auto snapshot = Metrics::snapshot();
+    EXPECT_TRUE(snapshot.counters.empty());
+    EXPECT_TRUE(snapshot.latencies.empty());
+}
+
+TEST_F(MetricsTest, PeripheralOperationsAreMeasured) {
+    Adapter adapter = get_adapter();
+    Peripheral peripheral = get_connected_peripheral();
+    ASSERT_TRUE(peripheral.initialized());
+    peripheral.read("0000180f-0000-1000-8000-00805f9b34fb", "00002a19-0000-1000-8000-00805f9b34fb");
+    peripheral.disconnect();
+
+    auto snapshot = Metrics::snapshot();
+    for (const char* operation : {"connect", "read", "disconnect"}) {
+        const Metrics::Latency* latency = find_latency(snapshot, operation);
+        ASSERT_NE(nullptr, latency) << operation;
+        EXPECT_EQ(1, latency->count);
+        EXPECT_EQ(adapter.identifier(), latency->key.adapter);
+        EXPECT_EQ(peripheral.address(), latency->key.peripheral);
+    }
+
+    EXPECT_NE(std::string::npos, Metrics::export_json().find(R"("operation": "connect")"));
+}
+
+TEST_F(MetricsTest, TraceEventsAreExported) {
+    Metrics::set_tracing(true, 1);
+    { Metrics::Timer timer({"first", "adapter", "peripheral"}); }
+    { Metrics::Timer timer({"second", "adapter", "peripheral"}); }
+
+    const std::string trace = Metrics::export_trace();
+    EXPECT_NE(std::string::npos, trace.find(R"("traceEvents": [{"name": "first", "cat": "simpleble", "ph": "X")"));
+    EXPECT_NE(std::string::npos, trace.find(R"("args": {"adapter": "adapter", "peripheral": "peripheral"})"));
+    EXPECT_EQ(std::string::npos, trace.find("second"));
+    // Events beyond the capacity are dropped, but still measured.
+    auto snapshot = Metrics::snapshot();
+    EXPECT_NE(nullptr, find_latency(snapshot, "second"));
+}
+
+TEST_F(MetricsTest, SeriesKeepRecordingAcrossReset) {
+    Metrics::Series series({"operation", "adapter", "peripheral"});
+    series.increment(2);
+    series.record_latency(5us);
+
+    Metrics::reset();
+    auto snapshot = Metrics::snapshot();
+    EXPECT_TRUE(snapshot.counters.empty());
+    EXPECT_TRUE(snapshot.latencies.empty());
+
+    series.increment();
+    series.record_latency(7us);
+    snapshot = Metrics::snapshot();
+    ASSERT_EQ(1, snapshot.counters.size());
+    EXPECT_EQ(series.key(), snapshot.counters.front().key);
+    EXPECT_EQ(1, snapshot.counters.front().value);
+    ASSERT_EQ(1, snapshot.latencies.size());
+    EXPECT_EQ(1, snapshot.latencies.front().count);
+    EXPECT_EQ(7us, snapshot.latencies.front().min);
+}
+
+TEST_F(MetricsTest, TimerSkipsFailedOperations) {
+    try {
+        Metrics::Timer timer({"operation", "", ""});
+        throw std::runtime_error("failed");
+    } catch (const std::runtime_error&) {
+    }
+
+    // A timer destroyed inside a handler belongs to an operation that did not fail.
+    try {
+        throw std::runtime_error("failed");
+    } catch (const std::runtime_error&) {
+        Metrics::Timer timer({"recovery", "", ""});
+    }
+
+    auto snapshot = Metrics::snapshot();
+    EXPECT_EQ(nullptr, find_latency(snapshot, "operation"));
+    EXPECT_NE(nullptr, find_latency(snapshot, "recovery"));
+}
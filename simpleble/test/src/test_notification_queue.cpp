@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <simpleble/Peripheral.h>
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "backends/common/NotificationQueue.h"
+#include "helpers/TestHelpers.h"
+
+using namespace SimpleBLE;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Receiver = Recorder<std::string>;
+
+std::shared_ptr<NotificationQueue> make_queue(Receiver& receiver, size_t capacity,
+                                              NotificationDelivery::OverflowPolicy overflow) {
+    NotificationDelivery delivery;
+    delivery.mode = NotificationDelivery::Mode::QUEUED;
+    delivery.capacity = capacity;
+    delivery.overflow = overflow;
+    return std::make_shared<NotificationQueue>([&receiver](ByteArray payload) { receiver.record(payload); }, delivery);
+}
+
+// Pushes a first payload and waits until the worker is held inside its callback, leaving the ring empty.
+void occupy_worker(Receiver& receiver, NotificationQueue& queue) {
+    receiver.hold();
+    queue.push(ByteArray("0"));
+    ASSERT_TRUE(receiver.wait_entered());
+}
+
+}  // namespace
+
+TEST(NotificationQueue, DeliversInOrderOffProducerThread) {
+    Receiver receiver;
+    auto queue = make_queue(receiver, 16, NotificationDelivery::OverflowPolicy::BLOCK);
+
+    constexpr size_t PAYLOAD_COUNT = 1000;
+    for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        queue->push(ByteArray(std::to_string(i)));
+    }
+    ASSERT_TRUE(receiver.wait_for_entries(PAYLOAD_COUNT));
+
+    std::scoped_lock lock(receiver.mutex);
+    for (size_t i = 0; i < PAYLOAD_COUNT; i++) {
+        EXPECT_EQ(std::to_string(i), receiver.entries[i]);
+    }
+    EXPECT_NE(std::this_thread::get_id(), receiver.thread_id);
+
+    auto stats = queue->stats();
+    EXPECT_EQ(16, stats.capacity);
+    EXPECT_EQ(PAYLOAD_COUNT, stats.delivered);
+    EXPECT_EQ(0, stats.dropped);
+    EXPECT_LE(stats.high_water_mark, 16);
+}
+
+TEST(NotificationQueue, DropNewest) {
+    Receiver receiver;
+    auto queue = make_queue(receiver, 3, NotificationDelivery::OverflowPolicy::DROP_NEWEST);
+    occupy_worker(receiver, *queue);
+
+    for (int i = 1; i <= 6; i++) {
+        queue->push(ByteArray(std::to_string(i)));
+    }
+    auto stats = queue->stats();
+    EXPECT_EQ(4, stats.capacity);
+    EXPECT_EQ(4, stats.queued);
+    EXPECT_EQ(4, stats.high_water_mark);
+    EXPECT_EQ(2, stats.dropped);
+
+    receiver.release();
+    ASSERT_TRUE(receiver.wait_for_entries(5));
+    std::scoped_lock lock(receiver.mutex);
+    EXPECT_EQ(std::vector<std::string>({"0", "1", "2", "3", "4"}), receiver.entries);
+}
+
+TEST(NotificationQueue, OverwriteOldest) {
+    Receiver receiver;
+    auto queue = make_queue(receiver, 4, NotificationDelivery::OverflowPolicy::OVERWRITE_OLDEST);
+    occupy_worker(receiver, *queue);
+
+    for (int i = 1; i <= 6; i++) {
+        queue->push(ByteArray(std::to_string(i)));
+    }
+    EXPECT_EQ(2, queue->stats().dropped);
+
+    receiver.release();
+    ASSERT_TRUE(receiver.wait_for_entries(5));
+    std::scoped_lock lock(receiver.mutex);
+    EXPECT_EQ(std::vector<std::string>({"0", "3", "4", "5", "6"}), receiver.entries);
+}
+
+TEST(NotificationQueue, BlockWaitsForRoom) {
+    Receiver receiver;
+    auto queue = make_queue(receiver, 2, NotificationDelivery::OverflowPolicy::BLOCK);
+    occupy_worker(receiver, *queue);
+
+    queue->push(ByteArray("1"));
+    queue->push(ByteArray("2"));
+    auto blocked = std::async(std::launch::async, [&queue] { queue->push(ByteArray("3")); });
+    EXPECT_EQ(std::future_status::timeout, blocked.wait_for(50ms));
+
+    receiver.release();
+    EXPECT_EQ(std::future_status::ready, blocked.wait_for(2s));
+    ASSERT_TRUE(receiver.wait_for_entries(4));
+
+    std::scoped_lock lock(receiver.mutex);
+    EXPECT_EQ(std::vector<std::string>({"0", "1", "2", "3"}), receiver.entries);
+    EXPECT_EQ(0, queue->stats().dropped);
+}
+
+TEST(NotificationQueue, CloseDiscardsPendingAndReleasesProducer) {
+    Receiver receiver;
+    auto queue = make_queue(receiver, 1, NotificationDelivery::OverflowPolicy::BLOCK);
+    EXPECT_EQ(2, queue->stats().capacity);
+    occupy_worker(receiver, *queue);
+
+    queue->push(ByteArray("1"));
+    queue->push(ByteArray("1"));
+    auto blocked = std::async(std::launch::async, [&queue] { queue->push(ByteArray("2")); });
+    EXPECT_EQ(std::future_status::timeout, blocked.wait_for(50ms));
+
+    // The producer is released right away, but closing waits for the callback in progress.
+    auto closing = std::async(std::launch::async, [&queue] { queue->close(); });
+    EXPECT_EQ(std::future_status::ready, blocked.wait_for(2s));
+    EXPECT_EQ(std::future_status::timeout, closing.wait_for(50ms));
+
+    receiver.release();
+    EXPECT_EQ(std::future_status::ready, closing.wait_for(2s));
+    queue->push(ByteArray("3"));
+
+    std::scoped_lock lock(receiver.mutex);
+    EXPECT_EQ(std::vector<std::string>({"0"}), receiver.entries);
+}
+
+TEST(NotificationQueue, CloseFromCallback) {
+    NotificationDelivery delivery;
+    delivery.mode = NotificationDelivery::Mode::QUEUED;
+
+    std::promise<void> closed;
+    std::shared_ptr<NotificationQueue> queue;
+    queue = std::make_shared<NotificationQueue>(
+        [&](ByteArray) {
+            queue->close();
+            closed.set_value();
+        },
+        delivery);
+
+    queue->push(ByteArray("0"));
+    EXPECT_EQ(std::future_status::ready, closed.get_future().wait_for(2s));
+    queue->push(ByteArray("1"));
+    EXPECT_EQ(1, queue->stats().delivered);
+}
+
+TEST(NotificationQueue, QueuedSubscriptionStats) {
+    Peripheral peripheral = get_connected_peripheral();
+    ASSERT_TRUE(peripheral.initialized());
+
+    NotificationDelivery delivery;
+    delivery.mode = NotificationDelivery::Mode::QUEUED;
+    delivery.capacity = 5;
+    peripheral.notify("0000180f-0000-1000-8000-00805f9b34fb", "00002a19-0000-1000-8000-00805f9b34fb",
+                      [](ByteArray) {}, delivery);
+    EXPECT_EQ(8, peripheral.notification_stats("0000180f-0000-1000-8000-00805f9b34fb",
+                                               "00002a19-0000-1000-8000-00805f9b34fb")
+                     .capacity);
+
+    peripheral.unsubscribe("0000180f-0000-1000-8000-00805f9b34fb", "00002a19-0000-1000-8000-00805f9b34fb");
+    EXPECT_EQ(0, peripheral.notification_stats("0000180f-0000-1000-8000-00805f9b34fb",
+                                               "00002a19-0000-1000-8000-00805f9b34fb")
+                     .capacity);
+    peripheral.disconnect();
+}
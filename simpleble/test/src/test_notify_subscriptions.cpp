@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "backends/common/NotifySubscriptions.h"
+
+#include <string>
+
+using namespace SimpleBLE;
+
+namespace {
+
+using Subscriptions = NotifySubscriptions<std::string>;
+using Mode = Subscriptions::Mode;
+
+const std::string CHARACTERISTIC = "/org/bluez/hci0/dev_00/service0001/char0002";
+
+}  // namespace
+
+TEST(NotifySubscriptions, UnsubscribeReportsHowTheSubscriptionWasMade) {
+    Subscriptions subscriptions;
+    subscriptions.subscribe(CHARACTERISTIC, Mode::PROPERTIES);
+
+    EXPECT_EQ(subscriptions.unsubscribe(CHARACTERISTIC), Mode::PROPERTIES);
+    EXPECT_FALSE(subscriptions.unsubscribe(CHARACTERISTIC));
+}
+
+TEST(NotifySubscriptions, HangupFallsBackToProperties) {
+    Subscriptions subscriptions;
+    auto token = subscriptions.subscribe(CHARACTERISTIC, Mode::ACQUIRED);
+
+    EXPECT_TRUE(subscriptions.fall_back(CHARACTERISTIC, token));
+    EXPECT_EQ(subscriptions.mode(CHARACTERISTIC), Mode::PROPERTIES);
+
+    // The subscription that fell back has to be stopped through properties, not by releasing the dead socket.
+    EXPECT_EQ(subscriptions.unsubscribe(CHARACTERISTIC), Mode::PROPERTIES);
+}
+
+TEST(NotifySubscriptions, FallBackOnlyOnce) {
+    Subscriptions subscriptions;
+    auto token = subscriptions.subscribe(CHARACTERISTIC, Mode::ACQUIRED);
+
+    EXPECT_TRUE(subscriptions.fall_back(CHARACTERISTIC, token));
+    EXPECT_FALSE(subscriptions.fall_back(CHARACTERISTIC, token));
+}
+
+TEST(NotifySubscriptions, StaleHangupIsIgnored) {
+    Subscriptions subscriptions;
+    auto first = subscriptions.subscribe(CHARACTERISTIC, Mode::ACQUIRED);
+    auto second = subscriptions.subscribe(CHARACTERISTIC, Mode::ACQUIRED);
+
+    EXPECT_FALSE(subscriptions.fall_back(CHARACTERISTIC, first));
+    EXPECT_EQ(subscriptions.mode(CHARACTERISTIC), Mode::ACQUIRED);
+    EXPECT_TRUE(subscriptions.fall_back(CHARACTERISTIC, second));
+}
+
+TEST(NotifySubscriptions, HangupAfterUnsubscribeIsIgnored) {
+    Subscriptions subscriptions;
+    auto token = subscriptions.subscribe(CHARACTERISTIC, Mode::ACQUIRED);
+    EXPECT_EQ(subscriptions.unsubscribe(CHARACTERISTIC), Mode::ACQUIRED);
+
+    EXPECT_FALSE(subscriptions.fall_back(CHARACTERISTIC, token));
+    EXPECT_FALSE(subscriptions.mode(CHARACTERISTIC));
+}
+
+TEST(NotifySubscriptions, ClearRemovesAllSubscriptions) {
+    Subscriptions subscriptions;
+    auto token = subscriptions.subscribe(CHARACTERISTIC, Mode::ACQUIRED);
+    subscriptions.clear();
+
+    EXPECT_FALSE(subscriptions.fall_back(CHARACTERISTIC, token));
+    EXPECT_FALSE(subscriptions.unsubscribe(CHARACTERISTIC));
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include <simpleble/Exceptions.h>
+#include <simpleble/Peripheral.h>
+
+#include <chrono>
+#include <future>
+#include <vector>
+
+#include "helpers/TestHelpers.h"
+
+using namespace SimpleBLE;
+using namespace std::chrono_literals;
+
+TEST(PeripheralAsync, RequiresConnection) {
+    Peripheral peripheral = get_peripheral();
+    ASSERT_TRUE(peripheral.initialized());
+    peripheral.disconnect();
+
+    EXPECT_THROW(peripheral.read_async("0000180f-0000-1000-8000-00805f9b34fb", "00002a19-0000-1000-8000-00805f9b34fb"),
+                 Exception::NotConnected);
+}
+
+TEST(PeripheralAsync, ManyOperationsInFlight) {
+    Peripheral peripheral = get_peripheral();
+    ASSERT_TRUE(peripheral.initialized());
+    peripheral.connect();
+
+    const BluetoothUUID service = "0000180f-0000-1000-8000-00805f9b34fb";
+    const BluetoothUUID characteristic = "00002a19-0000-1000-8000-00805f9b34fb";
+
+    std::vector<std::future<ByteArray>> reads;
+    std::vector<std::future<void>> writes;
+    for (int i = 0; i < 16; i++) {
+        reads.push_back(peripheral.read_async(service, characteristic));
+        writes.push_back(peripheral.write_request_async(service, characteristic, ByteArray("\x01", 1)));
+        writes.push_back(peripheral.write_command_async(service, characteristic, ByteArray("\x02", 1)));
+    }
+
+    for (auto& read : reads) {
+        ASSERT_EQ(std::future_status::ready, read.wait_for(2s));
+        EXPECT_NO_THROW(read.get());
+    }
+    for (auto& write : writes) {
+        ASSERT_EQ(std::future_status::ready, write.wait_for(2s));
+        EXPECT_NO_THROW(write.get());
+    }
+
+    peripheral.disconnect();
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <simpleble/Adapter.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "helpers/TestHelpers.h"
+
+using namespace SimpleBLE;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct BatchCollector {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::vector<Peripheral>> batches;
+    std::thread::id thread_id;
+
+    void operator()(std::vector<Peripheral> batch) {
+        std::scoped_lock lock(mutex);
+        thread_id = std::this_thread::get_id();
+        batches.push_back(std::move(batch));
+        cv.notify_all();
+    }
+
+    bool wait_for_batches(size_t count, std::chrono::milliseconds timeout) {
+        std::unique_lock lock(mutex);
+        return cv.wait_for(lock, timeout, [&] { return batches.size() >= count; });
+    }
+};
+
+}  // namespace
+
+TEST(ScanBatch, CoalescesUpdatesPerPeripheral) {
+    Adapter adapter = get_adapter();
+    ASSERT_TRUE(adapter.initialized());
+
+    BatchCollector collector;
+    adapter.set_callback_on_scan_batch([&collector](std::vector<Peripheral> batch) { collector(std::move(batch)); },
+                                       100ms);
+
+    // Each scan of the plain backend reports a new peripheral as both found and updated.
+    adapter.scan_start();
+    adapter.scan_start();
+    adapter.scan_start();
+
+    ASSERT_TRUE(collector.wait_for_batches(1, 2s));
+    adapter.set_callback_on_scan_batch(nullptr, 100ms);
+
+    std::scoped_lock lock(collector.mutex);
+    ASSERT_EQ(1, collector.batches.size());
+    EXPECT_EQ(3, collector.batches[0].size());
+    EXPECT_NE(std::this_thread::get_id(), collector.thread_id);
+}
+
+TEST(ScanBatch, CombinesWithRegularCallbacks) {
+    Adapter adapter = get_adapter();
+    ASSERT_TRUE(adapter.initialized());
+
+    size_t found = 0;
+    adapter.set_callback_on_scan_found([&found](Peripheral) { found++; });
+
+    BatchCollector collector;
+    adapter.set_callback_on_scan_batch([&collector](std::vector<Peripheral> batch) { collector(std::move(batch)); },
+                                       10ms);
+    adapter.scan_start();
+
+    ASSERT_TRUE(collector.wait_for_batches(1, 2s));
+    adapter.set_callback_on_scan_batch(nullptr, 10ms);
+    adapter.set_callback_on_scan_found(nullptr);
+
+    EXPECT_EQ(1, found);
+}
+
+TEST(ScanBatch, DisabledBatchingDeliversNothing) {
+    Adapter adapter = get_adapter();
+    ASSERT_TRUE(adapter.initialized());
+
+    BatchCollector collector;
+    adapter.set_callback_on_scan_batch([&collector](std::vector<Peripheral> batch) { collector(std::move(batch)); },
+                                       10ms);
+    adapter.set_callback_on_scan_batch(nullptr, 10ms);
+    adapter.scan_start();
+
+    EXPECT_FALSE(collector.wait_for_batches(1, 100ms));
+}
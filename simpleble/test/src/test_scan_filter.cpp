@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+
+#include <simpleble/Adapter.h>
+
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "backends/common/ScanFilterMatcher.h"
+#include "helpers/TestHelpers.h"
+
+using namespace SimpleBLE;
+
+namespace {
+
+advertising_data_t advertisement() {
+    advertising_data_t data{};
+    data.identifier = "Thermometer";
+    data.mac_address = "AA:BB:CC:DD:EE:FF";
+    data.rssi = -70;
+    data.tx_power = 0;
+    data.service_data["0000180f-0000-1000-8000-00805f9b34fb"] = ByteArray();
+    return data;
+}
+
+// The byte by byte implementation the word-wise manufacturer data masks have to match.
+bool manufacturer_data_reference(const ScanFilter& filter, const advertising_data_t& data) {
+    for (const auto& expected : filter.manufacturer_data) {
+        auto it = data.manufacturer_data.find(expected.company_id);
+        if (it == data.manufacturer_data.end() || it->second.size() < expected.data.size()) continue;
+
+        bool matches = true;
+        for (size_t i = 0; i < expected.data.size() && matches; i++) {
+            const uint8_t mask = expected.mask.empty() ? 0xFF : expected.mask[i];
+            matches = (it->second[i] & mask) == (expected.data[i] & mask);
+        }
+        if (matches) return true;
+    }
+    return false;
+}
+
+std::vector<advertising_data_t> random_advertisers(std::mt19937& rng, size_t count, const ByteArray& prefix) {
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<size_t> length(prefix.size(), 27);
+
+    std::vector<advertising_data_t> advertisers;
+    for (size_t i = 0; i < count; i++) {
+        advertising_data_t data = advertisement();
+        char address[18];
+        std::snprintf(address, sizeof(address), "C0:FF:EE:%02X:%02X:%02X", unsigned(i >> 16) & 0xFF,
+                      unsigned(i >> 8) & 0xFF, unsigned(i) & 0xFF);
+        data.mac_address = address;
+        data.identifier = "Sensor " + std::to_string(i);
+
+        std::vector<uint8_t> payload(length(rng));
+        for (auto& value : payload) value = byte(rng);
+        // A quarter of the advertisers carry the prefix, the others differ in its last byte at least.
+        for (size_t j = 0; j < prefix.size(); j++) payload[j] = prefix[j];
+        if (i % 4 != 0) payload[prefix.size() - 1] ^= 0x80;
+        data.manufacturer_data[i % 2 == 0 ? 0x0059 : 0x004C] = ByteArray(payload);
+        advertisers.push_back(std::move(data));
+    }
+    return advertisers;
+}
+
+}  // namespace
+
+TEST(ScanFilter, DefaultFilterMatchesEverything) {
+    ScanFilterMatcher matcher{ScanFilter()};
+    EXPECT_TRUE(matcher.matches_all());
+    EXPECT_TRUE(matcher.matches(advertisement()));
+    EXPECT_TRUE(matcher.matches(advertising_data_t{}));
+}
+
+TEST(ScanFilter, ServiceUuids) {
+    ScanFilter filter;
+    filter.service_uuids = {"180a", "180F"};
+    ScanFilterMatcher matcher(filter);
+    EXPECT_FALSE(matcher.matches_all());
+    EXPECT_TRUE(matcher.matches(advertisement()));
+
+    filter.service_uuids = {"0000180a-0000-1000-8000-00805f9b34fb"};
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(advertisement()));
+
+    filter.service_uuids = {"not-a-uuid"};
+    EXPECT_THROW(ScanFilterMatcher{filter}, std::invalid_argument);
+}
+
+TEST(ScanFilter, AdvertisedServiceUuids) {
+    ScanFilter filter;
+    filter.service_uuids = {"180a"};
+    ScanFilterMatcher matcher(filter);
+
+    advertising_data_t data = advertisement();
+    EXPECT_FALSE(matcher.matches(data));
+
+    // Services listed in the advertisement match without any service data.
+    data.service_uuids = {"0000180a-0000-1000-8000-00805f9b34fb"};
+    EXPECT_TRUE(matcher.matches(data));
+
+    data.service_data.clear();
+    EXPECT_TRUE(matcher.matches(data));
+}
+
+TEST(ScanFilter, SignalThresholds) {
+    ScanFilter filter;
+    filter.rssi_threshold = -70;
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(advertisement()));
+    filter.rssi_threshold = -69;
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(advertisement()));
+
+    filter = ScanFilter();
+    filter.pathloss_threshold = 70;
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(advertisement()));
+    filter.pathloss_threshold = 69;
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(advertisement()));
+
+    // Without a TX power the pathloss is unknown.
+    auto data = advertisement();
+    data.tx_power = std::numeric_limits<int16_t>::min();
+    filter.pathloss_threshold = 200;
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(data));
+}
+
+TEST(ScanFilter, Pattern) {
+    ScanFilter filter;
+    filter.pattern = "aa:bb";
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(advertisement()));
+    filter.pattern = "Thermo";
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(advertisement()));
+    filter.pattern = "thermo";
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(advertisement()));
+    filter.pattern = "AA:BB:CC:DD:EE:FF:00";
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(advertisement()));
+}
+
+TEST(ScanFilter, TransportOnlyRestrictsBrEdr) {
+    ScanFilter filter;
+    filter.transport = ScanFilter::Transport::LE;
+    filter.duplicate_data = false;
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches_all());
+
+    filter.transport = ScanFilter::Transport::BREDR;
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(advertisement()));
+}
+
+TEST(ScanFilter, ManufacturerData) {
+    auto data = advertisement();
+    data.manufacturer_data[0x0059] = ByteArray({0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A});
+
+    ScanFilter filter;
+    filter.manufacturer_data = {{0x0059, ByteArray({0x01, 0x02, 0x03}), ByteArray()}};
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches_all());
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(data));
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(advertisement()));
+
+    // Prefixes spanning more than a word, compared under a mask.
+    filter.manufacturer_data = {{0x0059, ByteArray({0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0xF9}),
+                                 ByteArray({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F})}};
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(data));
+    filter.manufacturer_data[0].mask = ByteArray({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF});
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(data));
+
+    // Payloads shorter than the prefix or from another company never match.
+    const ByteArray zeros(std::vector<uint8_t>(11, 0x00));
+    filter.manufacturer_data = {{0x0059, zeros, zeros}, {0x004C, ByteArray({0x01}), ByteArray()}};
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(data));
+    filter.manufacturer_data.push_back({0x0059, ByteArray(), ByteArray()});
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(data));
+
+    filter.manufacturer_data = {{0x0059, ByteArray({0x01, 0x02}), ByteArray({0xFF})}};
+    EXPECT_THROW(ScanFilterMatcher{filter}, std::invalid_argument);
+}
+
+TEST(ScanFilter, NameRegex) {
+    ScanFilter filter;
+    filter.name_regex = "^Therm.*er$";
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(advertisement()));
+    filter.name_regex = "mom";
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(advertisement()));
+    filter.name_regex = "^therm";
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(advertisement()));
+
+    filter.name_regex = "(unbalanced";
+    EXPECT_THROW(ScanFilterMatcher{filter}, std::invalid_argument);
+}
+
+TEST(ScanFilter, AddressAllowList) {
+    ScanFilter filter;
+    filter.addresses = {"11:22:33:44:55:66", "aa:bb:cc:dd:ee:ff"};
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(advertisement()));
+    filter.addresses = {"11:22:33:44:55:66"};
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(advertisement()));
+
+    // Addresses that aren't MAC addresses, such as the ones used on Apple platforms, are compared as strings.
+    auto data = advertisement();
+    data.mac_address = "6F1A2B3C-4D5E-6F70-8192-A3B4C5D6E7F8";
+    filter.addresses = {"6f1a2b3c-4d5e-6f70-8192-a3b4c5d6e7f8"};
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(data));
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(advertisement()));
+}
+
+TEST(ScanFilter, BeaconTypes) {
+    auto ibeacon = advertisement();
+    std::vector<uint8_t> ibeacon_payload(23, 0x00);
+    ibeacon_payload[0] = 0x02;
+    ibeacon_payload[1] = 0x15;
+    ibeacon.manufacturer_data[0x004C] = ByteArray(ibeacon_payload);
+
+    auto eddystone = advertisement();
+    eddystone.service_data["feaa"] = ByteArray({0x10, 0xEB, 0x03});
+
+    ScanFilter filter;
+    filter.beacon_types = {ScanFilter::BeaconType::IBEACON};
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(ibeacon));
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(eddystone));
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(advertisement()));
+
+    filter.beacon_types = {ScanFilter::BeaconType::EDDYSTONE_UID, ScanFilter::BeaconType::EDDYSTONE_URL};
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(ibeacon));
+    EXPECT_TRUE(ScanFilterMatcher(filter).matches(eddystone));
+    filter.beacon_types = {ScanFilter::BeaconType::EDDYSTONE_TLM};
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(eddystone));
+
+    // Truncated iBeacon frames are not reported.
+    ibeacon_payload.resize(22);
+    ibeacon.manufacturer_data[0x004C] = ByteArray(ibeacon_payload);
+    filter.beacon_types = {ScanFilter::BeaconType::IBEACON};
+    EXPECT_FALSE(ScanFilterMatcher(filter).matches(ibeacon));
+}
+
+TEST(ScanFilter, AppliedBeforeScanCallbacks) {
+    Adapter adapter = get_adapter();
+    ASSERT_TRUE(adapter.initialized());
+
+    size_t found = 0;
+    adapter.set_callback_on_scan_found([&found](Peripheral) { found++; });
+
+    ScanFilter filter;
+    filter.pattern = "Other";
+    adapter.set_scan_filter(filter);
+    EXPECT_EQ("Other", adapter.scan_filter().pattern);
+    adapter.scan_start();
+    EXPECT_EQ(0, found);
+
+    filter.pattern = "Plain";
+    adapter.set_scan_filter(filter);
+    adapter.scan_start();
+    EXPECT_EQ(1, found);
+
+    adapter.set_scan_filter(ScanFilter());
+    adapter.scan_start();
+    EXPECT_EQ(2, found);
+
+    adapter.set_callback_on_scan_found(nullptr);
+}
+
+// The word-wise manufacturer data masks have to agree with a byte by byte comparison on every payload length.
+TEST(ScanFilter, ManufacturerDataMatchesReference) {
+    const ByteArray prefix({0x4E, 0x6F, 0x72, 0x64, 0x69, 0x63, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05});
+    std::mt19937 rng(13);
+    const auto advertisers = random_advertisers(rng, 1000, prefix);
+
+    ScanFilter filter;
+    filter.manufacturer_data = {{0x0059, prefix, ByteArray()}};
+    const ScanFilterMatcher matcher(filter);
+
+    size_t matched = 0;
+    for (const auto& data : advertisers) {
+        EXPECT_EQ(manufacturer_data_reference(filter, data), matcher.matches(data)) << data.mac_address;
+        matched += matcher.matches(data) ? 1 : 0;
+    }
+    EXPECT_EQ(advertisers.size() / 4, matched);
+}
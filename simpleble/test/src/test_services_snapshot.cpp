@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <simpleble/Peripheral.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "backends/common/ServiceBase.h"
+#include "builders/BuilderBase.h"
+#include "helpers/TestHelpers.h"
+
+using namespace SimpleBLE;
+
+namespace {
+
+const ServiceBase* internal(Service& service) { return &Factory::get_internal<ServiceBase>(service); }
+
+}  // namespace
+
+TEST(ServicesSnapshot, SharedBetweenCalls) {
+    Peripheral peripheral = get_peripheral();
+    ASSERT_TRUE(peripheral.initialized());
+    peripheral.connect();
+
+    auto first = peripheral.services();
+    auto second = peripheral.services();
+    ASSERT_EQ(2, first.size());
+    ASSERT_EQ(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); i++) {
+        EXPECT_EQ(internal(first[i]), internal(second[i]));
+    }
+
+    peripheral.disconnect();
+}
+
+TEST(ServicesSnapshot, IndexAccessors) {
+    Peripheral peripheral = get_peripheral();
+    ASSERT_TRUE(peripheral.initialized());
+    peripheral.connect();
+
+    auto services = peripheral.services();
+    ASSERT_EQ(services.size(), peripheral.services_count());
+    for (size_t i = 0; i < services.size(); i++) {
+        Service service = peripheral.service(i);
+        EXPECT_EQ(services[i].uuid(), service.uuid());
+        EXPECT_EQ(internal(services[i]), internal(service));
+    }
+    EXPECT_THROW(peripheral.service(services.size()), std::out_of_range);
+
+    peripheral.disconnect();
+}
+
+TEST(ServicesSnapshot, RebuiltOnReconnection) {
+    Peripheral peripheral = get_peripheral();
+    ASSERT_TRUE(peripheral.initialized());
+
+    peripheral.connect();
+    Service before = peripheral.service(0);
+    peripheral.disconnect();
+    EXPECT_EQ(0, peripheral.services_count());
+
+    peripheral.connect();
+    Service after = peripheral.service(0);
+    EXPECT_EQ(before.uuid(), after.uuid());
+    EXPECT_NE(internal(before), internal(after));
+
+    peripheral.disconnect();
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <simpleble/Types.h>
+
+#include <stdexcept>
+#include <unordered_set>
+
+using namespace SimpleBLE;
+
+namespace {
+
+constexpr BluetoothUUID128 BATTERY_SERVICE("0000180f-0000-1000-8000-00805f9b34fb");
+static_assert(BATTERY_SERVICE == BluetoothUUID128::from_uuid16(0x180F));
+static_assert(BATTERY_SERVICE.uuid16() == 0x180F);
+static_assert(BluetoothUUID128("180F") == BATTERY_SERVICE);
+static_assert(BluetoothUUID128().is_nil());
+
+}  // namespace
+
+TEST(BluetoothUUID128, RoundTripsThroughStrings) {
+    const BluetoothUUID uuid = "6e400001-b5a3-f393-e0a9-e50e24dcca9e";
+    BluetoothUUID128 value(uuid);
+
+    EXPECT_EQ(uuid, value.to_string());
+    EXPECT_EQ(value, BluetoothUUID128(value.to_string()));
+    EXPECT_EQ(0x6E, value.bytes()[0]);
+    EXPECT_EQ(0x9E, value.bytes()[15]);
+    EXPECT_FALSE(value.is_sig());
+    EXPECT_FALSE(value.uuid16().has_value());
+    EXPECT_FALSE(value.uuid32().has_value());
+}
+
+TEST(BluetoothUUID128, ParsingIsCaseInsensitive) {
+    EXPECT_EQ(BluetoothUUID128("0000180F-0000-1000-8000-00805F9B34FB"), BATTERY_SERVICE);
+    EXPECT_EQ("0000180f-0000-1000-8000-00805f9b34fb", BluetoothUUID128("0000180F-0000-1000-8000-00805F9B34FB").to_string());
+}
+
+TEST(BluetoothUUID128, ShortForms) {
+    EXPECT_EQ("00002a19-0000-1000-8000-00805f9b34fb", BluetoothUUID128::from_uuid16(0x2A19).to_string());
+    EXPECT_EQ("12345678-0000-1000-8000-00805f9b34fb", BluetoothUUID128::from_uuid32(0x12345678).to_string());
+    EXPECT_EQ(BluetoothUUID128::from_uuid32(0x12345678), BluetoothUUID128("12345678"));
+    EXPECT_EQ(0x12345678u, BluetoothUUID128("12345678").uuid32());
+    EXPECT_FALSE(BluetoothUUID128("12345678").uuid16().has_value());
+}
+
+TEST(BluetoothUUID128, RejectsInvalidStrings) {
+    EXPECT_FALSE(BluetoothUUID128::parse("").has_value());
+    EXPECT_FALSE(BluetoothUUID128::parse("180").has_value());
+    EXPECT_FALSE(BluetoothUUID128::parse("0000180f+0000-1000-8000-00805f9b34fb").has_value());
+    EXPECT_FALSE(BluetoothUUID128::parse("0000180g-0000-1000-8000-00805f9b34fb").has_value());
+    EXPECT_THROW(BluetoothUUID128("not a uuid"), std::invalid_argument);
+}
+
+TEST(BluetoothUUID128, Hashing) {
+    std::unordered_set<BluetoothUUID128> uuids;
+    for (uint16_t i = 0; i < 0x2000; i++) {
+        uuids.insert(BluetoothUUID128::from_uuid16(i));
+    }
+    uuids.insert(BluetoothUUID128("0000180f-0000-1000-8000-00805f9b34fb"));
+
+    EXPECT_EQ(0x2000, uuids.size());
+    EXPECT_EQ(1, uuids.count(BATTERY_SERVICE));
+}
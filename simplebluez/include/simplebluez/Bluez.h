@@ -6,6 +6,8 @@
 #include <simplebluez/standard/Agent.h>
 #include <simplebluez/standard/BluezRoot.h>
 #include <simplebluez/standard/CustomRoot.h>
+#include <chrono>
+#include <functional>
 #include <vector>
 
 namespace SimpleBluez {
@@ -24,6 +26,14 @@ class Bluez {
     void init();
     void run_async();
 
+    // Waits up to `timeout` for bus activity before dispatching. Use wakeup() to interrupt the wait.
+    void run_async_blocking(std::chrono::milliseconds timeout);
+    void wakeup();
+
+    // Services a socket (e.g. one handed out by AcquireNotify) from the thread running run_async_blocking().
+    void watch_fd(int fd, std::function<void()> handler);
+    void unwatch_fd(int fd);
+
     std::shared_ptr<CustomRoot> root_custom();
     std::shared_ptr<BluezRoot> root_bluez();
 
@@ -3,6 +3,8 @@
 #include <simpledbus/advanced/Interface.h>
 #include <simpledbus/advanced/InterfaceRegistry.h>
 
+#include <exception>
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
@@ -29,6 +31,7 @@ class Adapter1 : public SimpleDBus::Interface {
 
     // ----- METHODS -----
     void RemoveDevice(std::string device_path);
+    void RemoveDeviceAsync(std::string device_path, std::function<void(std::exception_ptr error)> callback);
     void StartDiscovery();
     void StopDiscovery();
     void SetDiscoveryFilter(DiscoveryFilter filter);
@@ -3,6 +3,10 @@
 #include <simpledbus/advanced/Interface.h>
 #include <simpledbus/advanced/InterfaceRegistry.h>
 
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <string>
 
 #include "simplebluez/Types.h"
@@ -11,6 +15,16 @@ namespace SimpleBluez {
 
 class Device1 : public SimpleDBus::Interface {
   public:
+    // Flat copy of the advertising related properties, decoded straight from the incoming
+    // PropertiesChanged signals so that scan consumers don't need to go through the Holder conversions.
+    struct AdvertisingData {
+        int16_t rssi = 0;
+        int16_t tx_power = 0;
+        std::map<uint16_t, ByteArray> manufacturer_data;
+        std::map<std::string, ByteArray> service_data;
+        std::vector<std::string> uuids;
+    };
+
     Device1(std::shared_ptr<SimpleDBus::Connection> conn, std::shared_ptr<SimpleDBus::Proxy> proxy);
     virtual ~Device1();
 
@@ -37,7 +51,27 @@ class Device1 : public SimpleDBus::Interface {
     Property<bool>& Connected = property<bool>("Connected");
     Property<bool>& ServicesResolved = property<bool>("ServicesResolved");
 
+    // ----- ADVERTISING DATA -----
+    AdvertisingData advertising_data() const;
+    // Evaluates the predicate on the advertising data in place, without copying it.
+    bool advertising_data_matches(const std::function<bool(const AdvertisingData&)>& predicate) const;
+
+    // Incremented every time a property update actually changes the contents of the interface.
+    uint64_t generation() const;
+
+    // ----- HANDLES -----
+    void load(SimpleDBus::Holder options) override;
+    void handle_properties_changed(SimpleDBus::Holder changed_properties,
+                                   SimpleDBus::Holder invalidated_properties) override;
+
   private:
+    mutable std::mutex _advertising_mutex;
+    AdvertisingData _advertising_data;
+    std::atomic_uint64_t _generation{0};
+
+    bool _advertising_update(const std::string& name, const SimpleDBus::Holder& value);
+    bool _advertising_invalidate(const std::string& name);
+
     static const SimpleDBus::AutoRegisterInterface<Device1> registry;
 };
 
@@ -6,9 +6,12 @@
 
 #include <simplebluez/Types.h>
 
+#include <exception>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 
 namespace SimpleBluez {
 
@@ -34,12 +37,22 @@ class GattCharacteristic1 : public SimpleDBus::Interface {
     void WriteValue(const ByteArray& value, WriteType type);
     ByteArray ReadValue();
 
+    // Non-blocking variants, completed from the thread dispatching the connection.
+    void ReadValueAsync(std::function<void(ByteArray value, std::exception_ptr error)> callback);
+    void WriteValueAsync(const ByteArray& value, WriteType type,
+                         std::function<void(std::exception_ptr error)> callback);
+
+    // Client-side socket transport, returning the socket handed out by BlueZ along with the negotiated MTU.
+    std::pair<SimpleDBus::UnixSocket, uint16_t> AcquireNotify();
+    std::pair<SimpleDBus::UnixSocket, uint16_t> AcquireWrite();
+
     // ----- PROPERTIES -----
     Property<std::string>& UUID = property<std::string>("UUID");
     Property<SimpleDBus::ObjectPath>& Service = property<SimpleDBus::ObjectPath>("Service");
     Property<ByteArray>& Value = property<ByteArray>("Value");
     Property<bool>& Notifying = property<bool>("Notifying");
     Property<bool>& NotifyAcquired = property<bool>("NotifyAcquired");
+    Property<bool>& WriteAcquired = property<bool>("WriteAcquired");
     Property<std::vector<std::string>>& Flags = property<std::vector<std::string>>("Flags", {"read", "write", "notify"});
     // For local GATT server objects, this property is not a per-device negotiated MTU.
     // Use ValueOptions::mtu from server-side ReadValue/WriteValue callbacks instead.
@@ -61,6 +74,10 @@ class GattCharacteristic1 : public SimpleDBus::Interface {
     void message_handle(SimpleDBus::Message& msg) override;
 
   private:
+    SimpleDBus::Message _create_read_value_call();
+    SimpleDBus::Message _create_write_value_call(const ByteArray& value, WriteType type);
+    std::pair<SimpleDBus::UnixSocket, uint16_t> _acquire(const std::string& method);
+
     ValueOptions _parse_value_options(const SimpleDBus::Holder& options);
 
     static const SimpleDBus::AutoRegisterInterface<GattCharacteristic1> registry;
@@ -34,6 +34,8 @@ class Adapter : public SimpleDBus::Proxy {
     std::shared_ptr<Device> device_get(const std::string& path);
     void device_remove(const std::string& path);
     void device_remove(const std::shared_ptr<Device>& device);
+    // Safe to call from within callbacks, as it doesn't wait for BlueZ to reply.
+    void device_remove_async(const std::string& path, std::function<void(std::exception_ptr error)> callback);
     std::vector<std::shared_ptr<Device>> device_paired_get();
     std::vector<std::shared_ptr<Device>> device_bonded_get();
 
@@ -5,6 +5,11 @@
 #include <simplebluez/interfaces/GattCharacteristic1.h>
 #include <simplebluez/Types.h>
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
 namespace SimpleBluez {
 
 class Characteristic : public SimpleDBus::Proxy {
@@ -23,11 +28,36 @@ class Characteristic : public SimpleDBus::Proxy {
     ByteArray read();
     void write_request(ByteArray value);
     void write_command(ByteArray value);
+
+    // Non-blocking variants. The callback receives the error that the blocking call would have thrown, if any.
+    void read_async(std::function<void(ByteArray value, std::exception_ptr error)> callback);
+    void write_request_async(const ByteArray& value, std::function<void(std::exception_ptr error)> callback);
+    void write_command_async(const ByteArray& value, std::function<void(std::exception_ptr error)> callback);
+
     void start_notify();
     void stop_notify();
     void enable_acquire_notify();
     void disable_acquire_notify();
 
+    // ----- ACQUIRED SOCKETS -----
+    // Client-side AcquireNotify/AcquireWrite, which carry notifications and write commands over a socket
+    // handed out by BlueZ instead of the bus. Only offered by BlueZ for some characteristics.
+    bool can_acquire_notify();
+    bool can_acquire_write();
+
+    // Packets read from the socket are delivered from the thread dispatching the connection. If BlueZ hangs up
+    // the socket, on_closed is called from that same thread and no more packets will be delivered.
+    void acquire_notify(std::function<void(ByteArray value)> callback, std::function<void()> on_closed = nullptr);
+    void release_notify();
+    bool notify_acquired();
+
+    // While a write socket is held, write_command() and write_command_async() send through it and fall back
+    // to the bus if they can't.
+    // Once BlueZ refuses it, can_acquire_write() reports false until release_write() is called.
+    void acquire_write();
+    void release_write();
+    bool write_acquired();
+
     // ----- PROPERTIES -----
     std::vector<std::shared_ptr<Descriptor>> descriptors();
 
@@ -38,7 +68,8 @@ class Characteristic : public SimpleDBus::Proxy {
     void service(const std::string& service);
     
     ByteArray value();
-    void value(ByteArray value);
+    // Without emitting, the new value is only served to subsequent reads and not notified to subscribers.
+    void value(ByteArray value, bool emit = true);
     
     bool notifying();
 
@@ -71,6 +102,21 @@ class Characteristic : public SimpleDBus::Proxy {
     void on_registration() override;
 
   private:
+    struct AcquiredSocket {
+        SimpleDBus::UnixSocket socket;
+        uint16_t mtu = 0;
+        // Set once BlueZ hangs up, e.g. on disconnection.
+        std::atomic_bool closed{false};
+    };
+
+    std::mutex _acquired_mutex;
+    std::shared_ptr<AcquiredSocket> _acquired_notify;
+    std::shared_ptr<AcquiredSocket> _acquired_write;
+    std::atomic_bool _acquire_write_refused{false};
+
+    // Sends a write command through the acquired write socket, returns false if it has to go over the bus.
+    bool _send_acquired(const ByteArray& value);
+
     std::shared_ptr<SimpleDBus::Proxy> path_create(const std::string& path) override;
 
     std::shared_ptr<SimpleDBus::Interfaces::Properties> properties();
@@ -34,11 +34,20 @@ class Device : public SimpleDBus::Proxy {
     std::map<uint16_t, ByteArray> manufacturer_data();
     std::map<std::string, ByteArray> service_data();
 
+    // Snapshot of the advertising data as last reported by BlueZ, without querying the bus.
+    Device1::AdvertisingData advertising_data();
+    // Evaluates the predicate on the advertising data as last reported by BlueZ, without copying it.
+    bool advertising_data_matches(const std::function<bool(const Device1::AdvertisingData&)>& predicate);
+    // Incremented every time the contents of the device actually change.
+    uint64_t generation();
+
     bool paired();
     bool bonded();
     bool connected();
     bool outgoing();
     bool services_resolved();
+    // Whether the device is connected, paired or bonded as last reported by BlueZ, without querying the bus.
+    bool in_use();
 
     // ----- METHODS -----
     void connect();
@@ -51,6 +60,9 @@ class Device : public SimpleDBus::Proxy {
     void clear_on_connected();
     void set_on_services_resolved(std::function<void()> callback);
     void clear_on_services_resolved();
+    // Called when GATT objects of the device are added or removed, or when ServicesResolved changes.
+    void set_on_services_changed(std::function<void()> callback);
+    void clear_on_services_changed();
     void set_on_disconnected(std::function<void()> callback);
     void clear_on_disconnected();
     void set_on_connected_changed(std::function<void(bool connected)> callback);
@@ -66,6 +78,7 @@ class Device : public SimpleDBus::Proxy {
 
   private:
     std::shared_ptr<SimpleDBus::Proxy> path_create(const std::string& path) override;
+    void on_descendants_changed() override;
 
     std::shared_ptr<Device1> device1();
     std::shared_ptr<Battery1> battery1();
@@ -73,6 +86,8 @@ class Device : public SimpleDBus::Proxy {
     kvn::safe_callback<void()> _callback_on_connected;
     kvn::safe_callback<void()> _callback_on_disconnected;
     kvn::safe_callback<void(bool connected)> _callback_on_connected_changed;
+    kvn::safe_callback<void()> _callback_on_services_resolved;
+    kvn::safe_callback<void()> _callback_on_services_changed;
     std::atomic_bool _outgoing{false};
 };
 
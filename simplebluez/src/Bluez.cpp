@@ -26,6 +26,14 @@ void Bluez::init() {
 
 void Bluez::run_async() { _conn->read_write_dispatch(); }
 
+void Bluez::run_async_blocking(std::chrono::milliseconds timeout) { _conn->read_write_dispatch_blocking(timeout); }
+
+void Bluez::wakeup() { _conn->wakeup(); }
+
+void Bluez::watch_fd(int fd, std::function<void()> handler) { _conn->watch_fd(fd, std::move(handler)); }
+
+void Bluez::unwatch_fd(int fd) { _conn->unwatch_fd(fd); }
+
 std::shared_ptr<CustomRoot> Bluez::root_custom() { return _custom_root; }
 
 std::shared_ptr<BluezRoot> Bluez::root_bluez() { return _bluez_root; }
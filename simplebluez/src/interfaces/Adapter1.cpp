@@ -101,3 +101,11 @@ void Adapter1::RemoveDevice(std::string device_path) {
     msg.append_argument(SimpleDBus::Holder::create<SimpleDBus::ObjectPath>(device_path), "o");
     _conn->send_with_reply(msg);
 }
+
+void Adapter1::RemoveDeviceAsync(std::string device_path, std::function<void(std::exception_ptr error)> callback) {
+    auto msg = create_method_call("RemoveDevice");
+    msg.append_argument(SimpleDBus::Holder::create<SimpleDBus::ObjectPath>(device_path), "o");
+    _conn->send_with_reply_async(msg, [callback = std::move(callback)](SimpleDBus::Message, std::exception_ptr error) {
+        callback(error);
+    });
+}
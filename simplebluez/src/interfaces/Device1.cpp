@@ -2,6 +2,38 @@
 
 using namespace SimpleBluez;
 
+namespace {
+
+bool is_advertising_property(const std::string& name) {
+    return name == "RSSI" || name == "TxPower" || name == "ManufacturerData" || name == "ServiceData" ||
+           name == "UUIDs";
+}
+
+ByteArray to_byte_array(const SimpleDBus::Holder& value) {
+    if (value.is_byte_array()) {
+        return ByteArray(value.byte_array_data(), value.byte_array_size());
+    }
+    return value.get<ByteArray>();
+}
+
+template <typename K>
+std::map<K, ByteArray> to_byte_array_map(const SimpleDBus::Holder& value) {
+    std::map<K, ByteArray> result;
+    for (const auto& [key, data] : value.dict_ref()) {
+        result.emplace(key.template get<K>(), to_byte_array(data));
+    }
+    return result;
+}
+
+template <typename T>
+bool replace_if_different(T& current, T&& value) {
+    if (current == value) return false;
+    current = std::move(value);
+    return true;
+}
+
+}  // namespace
+
 const SimpleDBus::AutoRegisterInterface<Device1> Device1::registry{
     "org.bluez.Device1",
     // clang-format off
@@ -37,4 +69,97 @@ void Device1::Pair() {
 void Device1::CancelPairing() {
     auto msg = create_method_call("CancelPairing");
     _conn->send_with_reply(msg);
-}
\ No newline at end of file
+}
+
+Device1::AdvertisingData Device1::advertising_data() const {
+    std::scoped_lock lock(_advertising_mutex);
+    return _advertising_data;
+}
+
+bool Device1::advertising_data_matches(const std::function<bool(const AdvertisingData&)>& predicate) const {
+    std::scoped_lock lock(_advertising_mutex);
+    return predicate(_advertising_data);
+}
+
+uint64_t Device1::generation() const { return _generation; }
+
+void Device1::load(SimpleDBus::Holder options) {
+    SimpleDBus::Interface::load(options);
+
+    std::scoped_lock lock(_advertising_mutex);
+    for (const auto& [key, value] : options.dict_ref()) {
+        if (key.type() != SimpleDBus::Holder::STRING) continue;
+        _advertising_update(key.string_ref(), value);
+    }
+    _generation++;
+}
+
+void Device1::handle_properties_changed(SimpleDBus::Holder changed_properties,
+                                        SimpleDBus::Holder invalidated_properties) {
+    bool changed = false;
+
+    // Advertising properties are compared against the decoded copy, which is much cheaper than
+    // comparing Holders. Unchanged values are left out of the update, so they skip their callbacks entirely.
+    SimpleDBus::Holder updated_properties = SimpleDBus::Holder::create<std::map<std::string, SimpleDBus::Holder>>();
+    for (const auto& [key, value] : changed_properties.dict_ref()) {
+        if (key.type() != SimpleDBus::Holder::STRING) continue;
+
+        auto property = _properties.find(key.string_ref());
+        if (property == _properties.end()) continue;
+
+        if (is_advertising_property(key.string_ref())) {
+            std::scoped_lock lock(_advertising_mutex);
+            if (!_advertising_update(key.string_ref(), value) && property->second->valid()) continue;
+            changed = true;
+        } else {
+            // Other properties keep notifying on every update, but only count as a change if the value differs.
+            changed |= !property->second->valid() || *property->second != value;
+        }
+
+        updated_properties.dict_append(key, value);
+    }
+
+    for (const auto& removed_option : invalidated_properties.get<std::vector<std::string>>()) {
+        auto property = _properties.find(removed_option);
+        if (property == _properties.end()) continue;
+
+        std::scoped_lock lock(_advertising_mutex);
+        changed |= _advertising_invalidate(removed_option) || property->second->valid();
+    }
+
+    SimpleDBus::Interface::handle_properties_changed(updated_properties, invalidated_properties);
+
+    if (changed) {
+        _generation++;
+    }
+}
+
+bool Device1::_advertising_update(const std::string& name, const SimpleDBus::Holder& value) {
+    if (name == "RSSI") {
+        return replace_if_different(_advertising_data.rssi, value.get<int16_t>());
+    } else if (name == "TxPower") {
+        return replace_if_different(_advertising_data.tx_power, value.get<int16_t>());
+    } else if (name == "ManufacturerData") {
+        return replace_if_different(_advertising_data.manufacturer_data, to_byte_array_map<uint16_t>(value));
+    } else if (name == "ServiceData") {
+        return replace_if_different(_advertising_data.service_data, to_byte_array_map<std::string>(value));
+    } else if (name == "UUIDs") {
+        return replace_if_different(_advertising_data.uuids, value.get<std::vector<std::string>>());
+    }
+    return false;
+}
+
+bool Device1::_advertising_invalidate(const std::string& name) {
+    if (name == "RSSI") {
+        return replace_if_different(_advertising_data.rssi, int16_t(0));
+    } else if (name == "TxPower") {
+        return replace_if_different(_advertising_data.tx_power, int16_t(0));
+    } else if (name == "ManufacturerData") {
+        return replace_if_different(_advertising_data.manufacturer_data, std::map<uint16_t, ByteArray>());
+    } else if (name == "ServiceData") {
+        return replace_if_different(_advertising_data.service_data, std::map<std::string, ByteArray>());
+    } else if (name == "UUIDs") {
+        return replace_if_different(_advertising_data.uuids, std::vector<std::string>());
+    }
+    return false;
+}
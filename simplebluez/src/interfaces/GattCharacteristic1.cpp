@@ -1,5 +1,7 @@
 #include "simplebluez/interfaces/GattCharacteristic1.h"
 
+#include <simpledbus/base/Exceptions.h>
+
 #include <exception>
 #include <map>
 #include <utility>
@@ -35,10 +37,65 @@ void GattCharacteristic1::StopNotify() {
 }
 
 void GattCharacteristic1::WriteValue(const ByteArray& value, WriteType type) {
-    SimpleDBus::Holder value_data = SimpleDBus::Holder::create<std::vector<SimpleDBus::Holder>>();
-    for (size_t i = 0; i < value.size(); i++) {
-        value_data.array_append(SimpleDBus::Holder::create<uint8_t>(value[i]));
-    }
+    auto msg = _create_write_value_call(value, type);
+    _conn->send_with_reply(msg);
+}
+
+ByteArray GattCharacteristic1::ReadValue() {
+    auto msg = _create_read_value_call();
+
+    SimpleDBus::Message reply_msg = _conn->send_with_reply(msg);
+    SimpleDBus::Holder value = reply_msg.extract();
+
+    Value.set(value);
+    return Value();
+}
+
+void GattCharacteristic1::ReadValueAsync(std::function<void(ByteArray value, std::exception_ptr error)> callback) {
+    auto msg = _create_read_value_call();
+
+    // NOTE: The reply might arrive after this interface is gone, so the cached Value is left untouched.
+    _conn->send_with_reply_async(
+        msg, [callback = std::move(callback)](SimpleDBus::Message reply, std::exception_ptr error) {
+            if (error) {
+                callback(ByteArray(), error);
+                return;
+            }
+
+            ByteArray value;
+            try {
+                value = reply.extract().get<ByteArray>();
+            } catch (...) {
+                callback(ByteArray(), std::current_exception());
+                return;
+            }
+            callback(std::move(value), nullptr);
+        });
+}
+
+void GattCharacteristic1::WriteValueAsync(const ByteArray& value, WriteType type,
+                                          std::function<void(std::exception_ptr error)> callback) {
+    auto msg = _create_write_value_call(value, type);
+    _conn->send_with_reply_async(msg, [callback = std::move(callback)](SimpleDBus::Message, std::exception_ptr error) {
+        callback(error);
+    });
+}
+
+std::pair<SimpleDBus::UnixSocket, uint16_t> GattCharacteristic1::AcquireNotify() { return _acquire("AcquireNotify"); }
+
+std::pair<SimpleDBus::UnixSocket, uint16_t> GattCharacteristic1::AcquireWrite() { return _acquire("AcquireWrite"); }
+
+SimpleDBus::Message GattCharacteristic1::_create_read_value_call() {
+    auto msg = create_method_call("ReadValue");
+
+    // NOTE: ReadValue requires an additional argument, which currently is not supported
+    SimpleDBus::Holder options = SimpleDBus::Holder::create<std::map<std::string, SimpleDBus::Holder>>();
+    msg.append_argument(options, "a{sv}");
+    return msg;
+}
+
+SimpleDBus::Message GattCharacteristic1::_create_write_value_call(const ByteArray& value, WriteType type) {
+    SimpleDBus::Holder value_data = SimpleDBus::Holder::create_byte_array(value.data(), value.size());
 
     SimpleDBus::Holder options = SimpleDBus::Holder::create<std::map<std::string, SimpleDBus::Holder>>();
     if (type == WriteType::REQUEST) {
@@ -52,21 +109,27 @@ void GattCharacteristic1::WriteValue(const ByteArray& value, WriteType type) {
     auto msg = create_method_call("WriteValue");
     msg.append_argument(value_data, "ay");
     msg.append_argument(options, "a{sv}");
-    _conn->send_with_reply(msg);
+    return msg;
 }
 
-ByteArray GattCharacteristic1::ReadValue() {
-    auto msg = create_method_call("ReadValue");
+std::pair<SimpleDBus::UnixSocket, uint16_t> GattCharacteristic1::_acquire(const std::string& method) {
+    auto msg = create_method_call(method);
 
-    // NOTE: ReadValue requires an additional argument, which currently is not supported
+    // NOTE: The options are only meaningful for local characteristics, BlueZ doesn't expect any from clients.
     SimpleDBus::Holder options = SimpleDBus::Holder::create<std::map<std::string, SimpleDBus::Holder>>();
     msg.append_argument(options, "a{sv}");
 
-    SimpleDBus::Message reply_msg = _conn->send_with_reply(msg);
-    SimpleDBus::Holder value = reply_msg.extract();
+    SimpleDBus::Message reply = _conn->send_with_reply(msg);
 
-    Value.set(value);
-    return Value();
+    // The descriptor extracted by libdbus is a duplicate owned by the caller.
+    int fd = -1;
+    uint16_t mtu = 0;
+    DBusMessage* reply_raw = reply;
+    if (!dbus_message_get_args(reply_raw, nullptr, DBUS_TYPE_UNIX_FD, &fd, DBUS_TYPE_UINT16, &mtu, DBUS_TYPE_INVALID)) {
+        throw SimpleDBus::Exception::SendFailed("org.bluez.Error.Failed", "Unexpected " + method + " reply",
+                                                msg.to_string());
+    }
+    return {SimpleDBus::UnixSocket(fd), mtu};
 }
 
 void GattCharacteristic1::enable_acquire_notify() {
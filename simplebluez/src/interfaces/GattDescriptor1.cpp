@@ -20,10 +20,7 @@ GattDescriptor1::GattDescriptor1(std::shared_ptr<SimpleDBus::Connection> conn, s
 GattDescriptor1::~GattDescriptor1() = default;
 
 void GattDescriptor1::WriteValue(const ByteArray& value) {
-    SimpleDBus::Holder value_data = SimpleDBus::Holder::create<std::vector<SimpleDBus::Holder>>();
-    for (size_t i = 0; i < value.size(); i++) {
-        value_data.array_append(SimpleDBus::Holder::create<uint8_t>(value[i]));
-    }
+    SimpleDBus::Holder value_data = SimpleDBus::Holder::create_byte_array(value.data(), value.size());
 
     SimpleDBus::Holder options = SimpleDBus::Holder::create<std::map<std::string, SimpleDBus::Holder>>();
 
@@ -86,6 +86,10 @@ void Adapter::device_remove(const std::string& path) { adapter1()->RemoveDevice(
 
 void Adapter::device_remove(const std::shared_ptr<Device>& device) { adapter1()->RemoveDevice(device->path()); }
 
+void Adapter::device_remove_async(const std::string& path, std::function<void(std::exception_ptr error)> callback) {
+    adapter1()->RemoveDeviceAsync(path, std::move(callback));
+}
+
 std::vector<std::shared_ptr<Device>> Adapter::device_paired_get() {
     // Traverse all child paths and return only those that are paired.
     std::vector<std::shared_ptr<Device>> paired_devices;
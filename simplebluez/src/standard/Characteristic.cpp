@@ -3,6 +3,11 @@
 #include <simplebluez/standard/Descriptor.h>
 #include "simplebluez/Types.h"
 
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <tuple>
 #include <utility>
 
 using namespace SimpleBluez;
@@ -22,7 +27,10 @@ void Characteristic::on_registration() {
     _interfaces.emplace(std::make_pair("org.freedesktop.DBus.Properties", properties));
 }
 
-Characteristic::~Characteristic() {}
+Characteristic::~Characteristic() {
+    release_notify();
+    release_write();
+}
 
 std::shared_ptr<SimpleDBus::Proxy> Characteristic::path_create(const std::string& path) {
     return Proxy::create<Descriptor>(_conn, _bus_name, path);
@@ -48,7 +56,10 @@ std::string Characteristic::service() { return gattcharacteristic1()->Service; }
 void Characteristic::service(const std::string& service) { gattcharacteristic1()->Service.set(service); }
 
 ByteArray Characteristic::value() { return gattcharacteristic1()->Value; }
-void Characteristic::value(ByteArray value) { gattcharacteristic1()->Value.set(value).emit(); }
+void Characteristic::value(ByteArray value, bool emit) {
+    auto& property = gattcharacteristic1()->Value.set(value);
+    if (emit) property.emit();
+}
 
 std::vector<std::string> Characteristic::flags() { return gattcharacteristic1()->Flags; }
 void Characteristic::flags(std::vector<std::string> flags) { gattcharacteristic1()->Flags(flags); }
@@ -62,9 +73,53 @@ void Characteristic::write_request(ByteArray value) {
 }
 
 void Characteristic::write_command(ByteArray value) {
+    if (_send_acquired(value)) return;
+
     gattcharacteristic1()->WriteValue(value, GattCharacteristic1::WriteType::COMMAND);
 }
 
+bool Characteristic::_send_acquired(const ByteArray& value) {
+    std::shared_ptr<AcquiredSocket> acquired;
+    {
+        std::scoped_lock lock(_acquired_mutex);
+        acquired = _acquired_write;
+    }
+
+    // Packets that don't fit in a single ATT write (MTU minus the 3 byte header) are left to BlueZ to reject.
+    if (acquired && !acquired->closed && value.size() + 3 <= acquired->mtu) {
+        ssize_t sent = acquired->socket.send(value.data(), value.size());
+        if (sent == static_cast<ssize_t>(value.size())) {
+            return true;
+        }
+
+        // The socket is gone (usually because the link was renegotiated), so the bus takes over from here.
+        acquired->closed = true;
+        std::scoped_lock lock(_acquired_mutex);
+        if (_acquired_write == acquired) _acquired_write.reset();
+    }
+    return false;
+}
+
+void Characteristic::read_async(std::function<void(ByteArray value, std::exception_ptr error)> callback) {
+    gattcharacteristic1()->ReadValueAsync(std::move(callback));
+}
+
+void Characteristic::write_request_async(const ByteArray& value,
+                                         std::function<void(std::exception_ptr error)> callback) {
+    gattcharacteristic1()->WriteValueAsync(value, GattCharacteristic1::WriteType::REQUEST, std::move(callback));
+}
+
+void Characteristic::write_command_async(const ByteArray& value,
+                                         std::function<void(std::exception_ptr error)> callback) {
+    // A write command has no reply, so once it is in the socket it is complete.
+    if (_send_acquired(value)) {
+        callback(nullptr);
+        return;
+    }
+
+    gattcharacteristic1()->WriteValueAsync(value, GattCharacteristic1::WriteType::COMMAND, std::move(callback));
+}
+
 void Characteristic::start_notify() { gattcharacteristic1()->StartNotify(); }
 
 void Characteristic::stop_notify() {
@@ -76,6 +131,102 @@ void Characteristic::enable_acquire_notify() { gattcharacteristic1()->enable_acq
 
 void Characteristic::disable_acquire_notify() { gattcharacteristic1()->disable_acquire_notify(); }
 
+bool Characteristic::can_acquire_notify() { return gattcharacteristic1()->NotifyAcquired.valid(); }
+
+bool Characteristic::can_acquire_write() {
+    return !_acquire_write_refused && gattcharacteristic1()->WriteAcquired.valid();
+}
+
+void Characteristic::acquire_notify(std::function<void(ByteArray value)> callback, std::function<void()> on_closed) {
+    auto [socket, mtu] = gattcharacteristic1()->AcquireNotify();
+
+    auto acquired = std::make_shared<AcquiredSocket>();
+    acquired->socket = std::move(socket);
+    acquired->mtu = mtu;
+
+    // Each read returns a single notification, the buffer only needs to fit the largest attribute value.
+    const size_t buffer_size = std::max<size_t>(mtu, 512);
+    const int fd = acquired->socket.fd();
+    auto conn = _conn;
+
+    // The handler keeps the socket alive, so that releasing it from another thread can't pull it from under a read.
+    conn->watch_fd(fd, [conn, fd, acquired, buffer_size, callback = std::move(callback),
+                        on_closed = std::move(on_closed)]() {
+        ByteArray buffer(buffer_size);
+        while (true) {
+            ssize_t size = acquired->socket.receive(buffer.data(), buffer.size(), MSG_DONTWAIT);
+            if (size > 0) {
+                callback(ByteArray(buffer.data(), static_cast<size_t>(size)));
+            } else if (size < 0 && errno == EINTR) {
+                continue;
+            } else {
+                if (size == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    acquired->closed = true;
+                    conn->unwatch_fd(fd);
+                    if (on_closed) on_closed();
+                }
+                return;
+            }
+        }
+    });
+
+    std::shared_ptr<AcquiredSocket> previous;
+    {
+        std::scoped_lock lock(_acquired_mutex);
+        previous = std::exchange(_acquired_notify, acquired);
+    }
+    if (previous && previous->socket.valid()) {
+        _conn->unwatch_fd(previous->socket.fd());
+    }
+}
+
+void Characteristic::release_notify() {
+    std::shared_ptr<AcquiredSocket> acquired;
+    {
+        std::scoped_lock lock(_acquired_mutex);
+        acquired = std::move(_acquired_notify);
+    }
+
+    // Closing the socket, once the last handler in flight is done with it, is what makes BlueZ unsubscribe.
+    if (acquired && acquired->socket.valid()) {
+        _conn->unwatch_fd(acquired->socket.fd());
+    }
+}
+
+bool Characteristic::notify_acquired() {
+    std::scoped_lock lock(_acquired_mutex);
+    return _acquired_notify && !_acquired_notify->closed;
+}
+
+void Characteristic::acquire_write() {
+    SimpleDBus::UnixSocket socket;
+    uint16_t mtu = 0;
+    try {
+        std::tie(socket, mtu) = gattcharacteristic1()->AcquireWrite();
+    } catch (...) {
+        _acquire_write_refused = true;
+        throw;
+    }
+
+    auto acquired = std::make_shared<AcquiredSocket>();
+    acquired->socket = std::move(socket);
+    acquired->mtu = mtu;
+
+    std::scoped_lock lock(_acquired_mutex);
+    _acquired_write = std::move(acquired);
+}
+
+void Characteristic::release_write() {
+    std::scoped_lock lock(_acquired_mutex);
+    _acquired_write.reset();
+    _acquire_write_refused = false;
+}
+
+bool Characteristic::write_acquired() {
+    std::scoped_lock lock(_acquired_mutex);
+    return _acquired_write && !_acquired_write->closed;
+}
+
 std::shared_ptr<Descriptor> Characteristic::descriptor_add(const std::string& name) {
     const std::string descriptor_path = _path + "/descriptor_" + name;
     auto descriptor = Proxy::create<Descriptor>(_conn, _bus_name, descriptor_path);
@@ -15,7 +15,10 @@ Device::~Device() {
     _callback_on_connected.unload();
     _callback_on_disconnected.unload();
     _callback_on_connected_changed.unload();
+    _callback_on_services_resolved.unload();
+    _callback_on_services_changed.unload();
     device1()->Connected.on_changed.unload();
+    device1()->ServicesResolved.on_changed.unload();
 }
 
 void Device::on_registration() {
@@ -29,6 +32,12 @@ void Device::on_registration() {
         }
         _callback_on_connected_changed(connected);
     });
+    device1->ServicesResolved.on_changed.load([this](bool services_resolved) {
+        if (services_resolved) {
+            _callback_on_services_resolved();
+        }
+        _callback_on_services_changed();
+    });
     _interfaces.emplace(std::make_pair("org.bluez.Device1", device1));
 
     auto properties = std::make_shared<SimpleDBus::Interfaces::Properties>(_conn, shared_from_this());
@@ -45,6 +54,8 @@ std::shared_ptr<SimpleDBus::Proxy> Device::path_create(const std::string& path)
     }
 }
 
+void Device::on_descendants_changed() { _callback_on_services_changed(); }
+
 std::shared_ptr<Device1> Device::device1() {
     return std::dynamic_pointer_cast<Device1>(interface_get("org.bluez.Device1"));
 }
@@ -103,6 +114,14 @@ std::map<uint16_t, ByteArray> Device::manufacturer_data() { return device1()->Ma
 
 std::map<std::string, ByteArray> Device::service_data() { return device1()->ServiceData.refresh(); }
 
+Device1::AdvertisingData Device::advertising_data() { return device1()->advertising_data(); }
+
+bool Device::advertising_data_matches(const std::function<bool(const Device1::AdvertisingData&)>& predicate) {
+    return device1()->advertising_data_matches(predicate);
+}
+
+uint64_t Device::generation() { return device1()->generation(); }
+
 bool Device::paired() { return valid() && device1()->Paired.refresh(); }
 
 bool Device::bonded() { return valid() && device1()->Bonded.refresh(); }
@@ -121,6 +140,16 @@ bool Device::services_resolved() {
     return services_resolved.valid() && services_resolved.get();
 }
 
+bool Device::in_use() {
+    if (!valid()) return false;
+
+    auto device1 = this->device1();
+    for (auto* property : {&device1->Connected, &device1->Paired, &device1->Bonded}) {
+        if (property->valid() && property->get()) return true;
+    }
+    return false;
+}
+
 void Device::set_on_connected(std::function<void()> callback) { _callback_on_connected.load(std::move(callback)); }
 
 void Device::clear_on_connected() { _callback_on_connected.unload(); }
@@ -138,14 +167,16 @@ void Device::set_on_connected_changed(std::function<void(bool connected)> callba
 void Device::clear_on_connected_changed() { _callback_on_connected_changed.unload(); }
 
 void Device::set_on_services_resolved(std::function<void()> callback) {
-    device1()->ServicesResolved.on_changed.load([callback](bool services_resolved) {
-        if (services_resolved) {
-            callback();
-        }
-    });
+    _callback_on_services_resolved.load(std::move(callback));
+}
+
+void Device::clear_on_services_resolved() { _callback_on_services_resolved.unload(); }
+
+void Device::set_on_services_changed(std::function<void()> callback) {
+    _callback_on_services_changed.load(std::move(callback));
 }
 
-void Device::clear_on_services_resolved() { device1()->ServicesResolved.on_changed.unload(); }
+void Device::clear_on_services_changed() { _callback_on_services_changed.unload(); }
 
 bool Device::has_battery_interface() { return interface_exists("org.bluez.Battery1"); }
 
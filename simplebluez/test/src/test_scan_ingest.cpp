@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <simplebluez/standard/Adapter.h>
+#include <simplebluez/standard/Device.h>
+#include <simpledbus/base/Message.h>
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace SimpleBluez;
+using namespace SimpleDBus;
+
+namespace {
+
+const std::string ADAPTER_PATH = "/org/bluez/hci0";
+
+std::string device_path(size_t index) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "/dev_00_00_00_00_%02zX_%02zX", (index >> 8) & 0xFF, index & 0xFF);
+    return ADAPTER_PATH + buffer;
+}
+
+Holder device_interfaces(const std::string& address) {
+    return Holder::create(std::map<std::string, Holder>{
+        {"org.bluez.Device1", Holder::create(std::map<std::string, Holder>{{"Address", Holder::create(address)},
+                                                                          {"RSSI", Holder::create<int16_t>(-90)}})}});
+}
+
+// Builds a PropertiesChanged signal equivalent to the ones BlueZ emits for every received advertisement.
+Message advertisement_signal(const std::string& path, int16_t rssi, uint8_t payload) {
+    Message msg = Message::create_signal(path, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    msg.append_argument(Holder::create<std::string>("org.bluez.Device1"), "s");
+
+    Holder manufacturer_data = Holder::create<std::map<uint16_t, Holder>>();
+    manufacturer_data.dict_append(Holder::UINT16, uint16_t(0x004C),
+                                  Holder::create(std::vector<uint8_t>{0x02, 0x15, payload, payload, payload}));
+
+    Holder service_data = Holder::create<std::map<std::string, Holder>>();
+    service_data.dict_append(Holder::STRING, std::string("0000feaa-0000-1000-8000-00805f9b34fb"),
+                             Holder::create(std::vector<uint8_t>{0x10, payload}));
+
+    Holder changed = Holder::create<std::map<std::string, Holder>>();
+    changed.dict_append(Holder::STRING, std::string("RSSI"), Holder::create<int16_t>(rssi));
+    changed.dict_append(Holder::STRING, std::string("ManufacturerData"), manufacturer_data);
+    changed.dict_append(Holder::STRING, std::string("ServiceData"), service_data);
+    msg.append_argument(changed, "a{sv}");
+    msg.append_argument(Holder::create<std::vector<Holder>>(), "as");
+    return msg;
+}
+
+}  // namespace
+
+TEST(ScanIngest, DecodesAdvertisingData) {
+    auto adapter = Proxy::create<Adapter>(nullptr, "", ADAPTER_PATH);
+    adapter->path_add(device_path(0), device_interfaces("00:00:00:00:00:00"));
+    auto device = adapter->device_get(device_path(0));
+
+    Message msg = advertisement_signal(device_path(0), -42, 0xAB);
+    device->message_handle(msg);
+
+    auto data = device->advertising_data();
+    EXPECT_EQ(-42, data.rssi);
+    ASSERT_EQ(1, data.manufacturer_data.count(0x004C));
+    EXPECT_EQ(ByteArray({0x02, 0x15, 0xAB, 0xAB, 0xAB}), data.manufacturer_data[0x004C]);
+    ASSERT_EQ(1, data.service_data.count("0000feaa-0000-1000-8000-00805f9b34fb"));
+    EXPECT_EQ(ByteArray({0x10, 0xAB}), data.service_data["0000feaa-0000-1000-8000-00805f9b34fb"]);
+
+    // The regular properties must be kept in sync.
+    EXPECT_EQ(-42, device->rssi());
+}
+
+TEST(ScanIngest, GenerationOnlyChangesWithContent) {
+    auto adapter = Proxy::create<Adapter>(nullptr, "", ADAPTER_PATH);
+    adapter->path_add(device_path(0), device_interfaces("00:00:00:00:00:00"));
+    auto device = adapter->device_get(device_path(0));
+
+    Message first = advertisement_signal(device_path(0), -42, 0x01);
+    device->message_handle(first);
+    const uint64_t generation = device->generation();
+
+    Message duplicate = advertisement_signal(device_path(0), -42, 0x01);
+    device->message_handle(duplicate);
+    EXPECT_EQ(generation, device->generation());
+
+    Message payload_changed = advertisement_signal(device_path(0), -42, 0x02);
+    device->message_handle(payload_changed);
+    EXPECT_NE(generation, device->generation());
+
+    Message rssi_changed = advertisement_signal(device_path(0), -43, 0x02);
+    const uint64_t before_rssi = device->generation();
+    device->message_handle(rssi_changed);
+    EXPECT_NE(before_rssi, device->generation());
+}
+
+// Synthetic advertisement storm: many devices, most signals being duplicates, as seen in dense environments.
+TEST(ScanIngest, DuplicateSignalsKeepGeneration) {
+    constexpr size_t DEVICE_COUNT = 300;
+    constexpr size_t ROUNDS = 20;
+
+    auto adapter = Proxy::create<Adapter>(nullptr, "", ADAPTER_PATH);
+    for (size_t i = 0; i < DEVICE_COUNT; i++) {
+        adapter->path_add(device_path(i), device_interfaces(std::to_string(i)));
+    }
+
+    size_t updates = 0;
+    adapter->set_on_device_updated([&updates](std::shared_ptr<Device>) { updates++; });
+
+    std::vector<Message> signals;
+    signals.reserve(DEVICE_COUNT * ROUNDS);
+    for (size_t round = 0; round < ROUNDS; round++) {
+        for (size_t i = 0; i < DEVICE_COUNT; i++) {
+            // Only every fourth round carries new content.
+            signals.push_back(advertisement_signal(device_path(i), -60, uint8_t(round / 4)));
+        }
+    }
+
+    for (auto& msg : signals) {
+        adapter->path_get(msg.get_path())->message_handle(msg);
+    }
+
+    EXPECT_EQ(signals.size(), updates);
+
+    // Initial load, first advertisement and one change every fourth round.
+    for (size_t i = 0; i < DEVICE_COUNT; i++) {
+        EXPECT_EQ(2 + ROUNDS / 4 - 1, adapter->device_get(device_path(i))->generation());
+    }
+}
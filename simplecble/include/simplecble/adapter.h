@@ -167,6 +167,8 @@ SIMPLECBLE_EXPORT size_t simpleble_adapter_scan_get_results_count(simpleble_adap
  *
  * @note The user is responsible for freeing the returned peripheral object
  *       by calling `simpleble_peripheral_release_handle`.
+ * @note Every call fetches all scan results, use `simpleble_adapter_scan_get_results_snapshot`
+ *       to iterate over them.
  *
  * @param handle
  * @param index
@@ -175,6 +177,72 @@ SIMPLECBLE_EXPORT size_t simpleble_adapter_scan_get_results_count(simpleble_adap
 SIMPLECBLE_EXPORT simpleble_peripheral_t simpleble_adapter_scan_get_results_handle(simpleble_adapter_t handle,
                                                                                   size_t index);
 
+/**
+ * @brief Captures the current scan results, so that they can be iterated over
+ *        without fetching the whole list for every index.
+ *
+ * @note The user is responsible for freeing the returned snapshot
+ *       by calling `simpleble_adapter_scan_snapshot_release_handle`.
+ *
+ * @param handle
+ * @return simpleble_adapter_scan_snapshot_t
+ */
+SIMPLECBLE_EXPORT simpleble_adapter_scan_snapshot_t simpleble_adapter_scan_get_results_snapshot(
+    simpleble_adapter_t handle);
+
+/**
+ * @brief Captures the current list of paired peripherals.
+ *
+ * @note The user is responsible for freeing the returned snapshot
+ *       by calling `simpleble_adapter_scan_snapshot_release_handle`.
+ *
+ * @param handle
+ * @return simpleble_adapter_scan_snapshot_t
+ */
+SIMPLECBLE_EXPORT simpleble_adapter_scan_snapshot_t simpleble_adapter_get_paired_peripherals_snapshot(
+    simpleble_adapter_t handle);
+
+/**
+ * @brief Captures the current list of connected peripherals.
+ *
+ * @note The user is responsible for freeing the returned snapshot
+ *       by calling `simpleble_adapter_scan_snapshot_release_handle`.
+ *
+ * @param handle
+ * @return simpleble_adapter_scan_snapshot_t
+ */
+SIMPLECBLE_EXPORT simpleble_adapter_scan_snapshot_t simpleble_adapter_get_connected_peripherals_snapshot(
+    simpleble_adapter_t handle);
+
+/**
+ * @brief Releases all memory consumed by a snapshot. Peripheral handles
+ *        obtained from it remain valid.
+ *
+ * @param snapshot
+ */
+SIMPLECBLE_EXPORT void simpleble_adapter_scan_snapshot_release_handle(simpleble_adapter_scan_snapshot_t snapshot);
+
+/**
+ * @brief
+ *
+ * @param snapshot
+ * @return size_t
+ */
+SIMPLECBLE_EXPORT size_t simpleble_adapter_scan_snapshot_count(simpleble_adapter_scan_snapshot_t snapshot);
+
+/**
+ * @brief
+ *
+ * @note The user is responsible for freeing the returned peripheral object
+ *       by calling `simpleble_peripheral_release_handle`.
+ *
+ * @param snapshot
+ * @param index
+ * @return simpleble_peripheral_t
+ */
+SIMPLECBLE_EXPORT simpleble_peripheral_t simpleble_adapter_scan_snapshot_get_handle(
+    simpleble_adapter_scan_snapshot_t snapshot, size_t index);
+
 /**
  * @brief
  *
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include <simplecble/export.h>
@@ -32,6 +33,10 @@ SIMPLECBLE_EXPORT int64_t simpleble_config_simplebluez_get_connection_timeout_ms
 SIMPLECBLE_EXPORT void simpleble_config_simplebluez_set_connection_timeout_ms(int64_t timeout_ms);
 SIMPLECBLE_EXPORT int64_t simpleble_config_simplebluez_get_disconnection_timeout_ms(void);
 SIMPLECBLE_EXPORT void simpleble_config_simplebluez_set_disconnection_timeout_ms(int64_t timeout_ms);
+SIMPLECBLE_EXPORT size_t simpleble_config_simplebluez_get_peripheral_cache_max_entries(void);
+SIMPLECBLE_EXPORT void simpleble_config_simplebluez_set_peripheral_cache_max_entries(size_t max_entries);
+SIMPLECBLE_EXPORT int64_t simpleble_config_simplebluez_get_peripheral_cache_ttl_ms(void);
+SIMPLECBLE_EXPORT void simpleble_config_simplebluez_set_peripheral_cache_ttl_ms(int64_t ttl_ms);
 
 SIMPLECBLE_EXPORT void simpleble_config_winrt_reset(void);
 
@@ -37,6 +37,8 @@ SIMPLECBLE_EXPORT bool simpleble_logging_has_callback(void);
 SIMPLECBLE_EXPORT void simpleble_logging_log_default_stdout(void);
 SIMPLECBLE_EXPORT void simpleble_logging_log_default_file(void);
 SIMPLECBLE_EXPORT void simpleble_logging_log_default_file_path(const char* path);
+SIMPLECBLE_EXPORT void simpleble_logging_set_async(bool enabled);
+SIMPLECBLE_EXPORT void simpleble_logging_flush(void);
 
 #ifdef __cplusplus
 }
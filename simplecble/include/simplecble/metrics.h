@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <simplecble/export.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Enables or disables the recording of counters and latencies of SimpleBLE operations.
+ *
+ * @param enabled
+ */
+SIMPLECBLE_EXPORT void simpleble_metrics_set_enabled(bool enabled);
+SIMPLECBLE_EXPORT bool simpleble_metrics_is_enabled(void);
+
+/**
+ * @brief Clears every counter, latency and trace event recorded so far.
+ */
+SIMPLECBLE_EXPORT void simpleble_metrics_reset(void);
+
+/**
+ * @brief Returns the recorded counters and latencies as a JSON document.
+ *
+ * @note The user is responsible for freeing the returned value by calling `simpleble_free`.
+ *
+ * @return char*
+ */
+SIMPLECBLE_EXPORT char* simpleble_metrics_export_json(void);
+
+/**
+ * @brief Records timed operations as trace events, keeping up to `capacity` of them.
+ *
+ * @param enabled
+ * @param capacity
+ */
+SIMPLECBLE_EXPORT void simpleble_metrics_set_tracing(bool enabled, size_t capacity);
+
+/**
+ * @brief Returns the trace events in the Chrome trace event format, which Perfetto can open.
+ *
+ * @note The user is responsible for freeing the returned value by calling `simpleble_free`.
+ *
+ * @return char*
+ */
+SIMPLECBLE_EXPORT char* simpleble_metrics_export_trace(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,6 +4,7 @@
 #include <simplecble/adapter.h>
 #include <simplecble/config.h>
 #include <simplecble/logging.h>
+#include <simplecble/metrics.h>
 #include <simplecble/peripheral.h>
 #include <simplecble/utils.h>
 
@@ -22,6 +22,20 @@ typedef struct {
     simpleble_uuid_t uuid;
 } simpleble_descriptor_t;
 
+// Bits of simpleble_characteristic_t::properties, as defined by the Bluetooth specification.
+typedef enum {
+    SIMPLEBLE_CHARACTERISTIC_PROPERTY_BROADCAST = 1 << 0,
+    SIMPLEBLE_CHARACTERISTIC_PROPERTY_READ = 1 << 1,
+    SIMPLEBLE_CHARACTERISTIC_PROPERTY_WRITE_COMMAND = 1 << 2,
+    SIMPLEBLE_CHARACTERISTIC_PROPERTY_WRITE_REQUEST = 1 << 3,
+    SIMPLEBLE_CHARACTERISTIC_PROPERTY_NOTIFY = 1 << 4,
+    SIMPLEBLE_CHARACTERISTIC_PROPERTY_INDICATE = 1 << 5,
+    SIMPLEBLE_CHARACTERISTIC_PROPERTY_AUTHENTICATED_SIGNED_WRITES = 1 << 6,
+    SIMPLEBLE_CHARACTERISTIC_PROPERTY_EXTENDED_PROPERTIES = 1 << 7,
+    SIMPLEBLE_CHARACTERISTIC_PROPERTY_RELIABLE_WRITE = 1 << 8,
+    SIMPLEBLE_CHARACTERISTIC_PROPERTY_WRITABLE_AUXILIARIES = 1 << 9,
+} simpleble_characteristic_property_t;
+
 typedef struct {
     simpleble_uuid_t uuid;
     bool can_read;
@@ -31,6 +45,7 @@ typedef struct {
     bool can_indicate;
     size_t descriptor_count;
     simpleble_descriptor_t descriptors[SIMPLEBLE_DESCRIPTOR_MAX_COUNT];
+    uint32_t properties;  // Bitmask of simpleble_characteristic_property_t values.
 } simpleble_characteristic_t;
 
 typedef struct {
@@ -61,6 +76,7 @@ typedef struct {
 
 typedef void* simpleble_adapter_t;
 typedef void* simpleble_peripheral_t;
+typedef void* simpleble_adapter_scan_snapshot_t;
 
 typedef enum {
     SIMPLEBLE_OS_WINDOWS = 0,
@@ -263,6 +263,85 @@ simpleble_peripheral_t simpleble_adapter_scan_get_results_handle(simpleble_adapt
     }
 }
 
+simpleble_adapter_scan_snapshot_t simpleble_adapter_scan_get_results_snapshot(simpleble_adapter_t handle) {
+    if (handle == nullptr) {
+        return nullptr;
+    }
+
+    SimpleBLE::Adapter* adapter = (SimpleBLE::Adapter*)handle;
+    try {
+        auto* snapshot = new std::vector<SimpleBLE::Peripheral>(adapter->scan_get_results());
+        return (simpleble_adapter_scan_snapshot_t)snapshot;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+simpleble_adapter_scan_snapshot_t simpleble_adapter_get_paired_peripherals_snapshot(simpleble_adapter_t handle) {
+    if (handle == nullptr) {
+        return nullptr;
+    }
+
+    SimpleBLE::Adapter* adapter = (SimpleBLE::Adapter*)handle;
+    try {
+        auto* snapshot = new std::vector<SimpleBLE::Peripheral>(adapter->get_paired_peripherals());
+        return (simpleble_adapter_scan_snapshot_t)snapshot;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+simpleble_adapter_scan_snapshot_t simpleble_adapter_get_connected_peripherals_snapshot(simpleble_adapter_t handle) {
+    if (handle == nullptr) {
+        return nullptr;
+    }
+
+    SimpleBLE::Adapter* adapter = (SimpleBLE::Adapter*)handle;
+    try {
+        auto* snapshot = new std::vector<SimpleBLE::Peripheral>(adapter->get_connected_peripherals());
+        return (simpleble_adapter_scan_snapshot_t)snapshot;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void simpleble_adapter_scan_snapshot_release_handle(simpleble_adapter_scan_snapshot_t snapshot) {
+    if (snapshot == nullptr) {
+        return;
+    }
+
+    auto* peripherals = (std::vector<SimpleBLE::Peripheral>*)snapshot;
+    delete peripherals;
+}
+
+size_t simpleble_adapter_scan_snapshot_count(simpleble_adapter_scan_snapshot_t snapshot) {
+    if (snapshot == nullptr) {
+        return 0;
+    }
+
+    auto* peripherals = (std::vector<SimpleBLE::Peripheral>*)snapshot;
+    return peripherals->size();
+}
+
+simpleble_peripheral_t simpleble_adapter_scan_snapshot_get_handle(simpleble_adapter_scan_snapshot_t snapshot,
+                                                                  size_t index) {
+    if (snapshot == nullptr) {
+        return nullptr;
+    }
+
+    auto* peripherals = (std::vector<SimpleBLE::Peripheral>*)snapshot;
+    if (index >= peripherals->size()) {
+        return nullptr;
+    }
+
+    try {
+        SimpleBLE::Peripheral* peripheral_handle = new SimpleBLE::Peripheral((*peripherals)[index]);
+        return (simpleble_peripheral_t)peripheral_handle;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
 size_t simpleble_adapter_get_paired_peripherals_count(simpleble_adapter_t handle) {
     if (handle == nullptr) {
         return 0;
@@ -36,6 +36,24 @@ void simpleble_config_simplebluez_set_disconnection_timeout_ms(int64_t timeout_m
     SimpleBLE::Config::SimpleBluez::disconnection_timeout = std::chrono::milliseconds(timeout_ms);
 }
 
+size_t simpleble_config_simplebluez_get_peripheral_cache_max_entries(void) {
+    return SimpleBLE::Config::SimpleBluez::peripheral_cache_max_entries;
+}
+
+void simpleble_config_simplebluez_set_peripheral_cache_max_entries(size_t max_entries) {
+    SimpleBLE::Config::SimpleBluez::peripheral_cache_max_entries = max_entries;
+}
+
+int64_t simpleble_config_simplebluez_get_peripheral_cache_ttl_ms(void) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               SimpleBLE::Config::SimpleBluez::peripheral_cache_ttl)
+        .count();
+}
+
+void simpleble_config_simplebluez_set_peripheral_cache_ttl_ms(int64_t ttl_ms) {
+    SimpleBLE::Config::SimpleBluez::peripheral_cache_ttl = std::chrono::milliseconds(ttl_ms);
+}
+
 void simpleble_config_winrt_reset(void) { SimpleBLE::Config::WinRT::reset(); }
 
 bool simpleble_config_winrt_get_experimental_use_own_mta_apartment(void) {
@@ -41,3 +41,7 @@ void simpleble_logging_log_default_file_path(const char* path) {
 
     SimpleBLE::Logging::Logger::get()->log_default_file(path);
 }
+
+void simpleble_logging_set_async(bool enabled) { SimpleBLE::Logging::Logger::get()->set_async(enabled); }
+
+void simpleble_logging_flush(void) { SimpleBLE::Logging::Logger::get()->flush(); }
@@ -0,0 +1,47 @@
+#include <simplecble/metrics.h>
+
+#include <simpleble/Metrics.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+char* copy_string(const std::string& value) {
+    char* c_value = static_cast<char*>(std::malloc(value.size() + 1));
+    if (c_value == nullptr) {
+        return nullptr;
+    }
+
+    std::strcpy(c_value, value.c_str());
+    return c_value;
+}
+
+}  // namespace
+
+void simpleble_metrics_set_enabled(bool enabled) { SimpleBLE::Metrics::set_enabled(enabled); }
+
+bool simpleble_metrics_is_enabled(void) { return SimpleBLE::Metrics::is_enabled(); }
+
+void simpleble_metrics_reset(void) { SimpleBLE::Metrics::reset(); }
+
+char* simpleble_metrics_export_json(void) {
+    try {
+        return copy_string(SimpleBLE::Metrics::export_json());
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void simpleble_metrics_set_tracing(bool enabled, size_t capacity) {
+    SimpleBLE::Metrics::set_tracing(enabled, capacity);
+}
+
+char* simpleble_metrics_export_trace(void) {
+    try {
+        return copy_string(SimpleBLE::Metrics::export_trace());
+    } catch (...) {
+        return nullptr;
+    }
+}
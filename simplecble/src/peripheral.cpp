@@ -214,7 +214,7 @@ size_t simpleble_peripheral_services_count(simpleble_peripheral_t handle) {
 
     SimpleBLE::Peripheral* peripheral = (SimpleBLE::Peripheral*)handle;
     try {
-        return peripheral->services().size();
+        return peripheral->services_count();
     } catch (...) {
         return 0;
     }
@@ -230,43 +230,44 @@ simpleble_err_t simpleble_peripheral_services_get(simpleble_peripheral_t handle,
 
     SimpleBLE::Peripheral* peripheral = (SimpleBLE::Peripheral*)handle;
     try {
-        auto peripheral_services = peripheral->services();
-
-        if (index >= peripheral_services.size()) {
-            return SIMPLEBLE_FAILURE;
-        }
-
-        SimpleBLE::Service service = peripheral_services[index];
+        // Out of range indices are rejected by the std::out_of_range exception caught below.
+        SimpleBLE::Service service = peripheral->service(index);
 
         memcpy(services->uuid.value, service.uuid().c_str(), SIMPLEBLE_UUID_STR_LEN);
 
-        const size_t copy_len = std::min(service.data().size(), sizeof(services->data));
-        services->data_length = service.data().size();
-        memcpy(services->data, service.data().data(), copy_len);
+        const SimpleBLE::ByteArray data = service.data();
+        const size_t copy_len = std::min(data.size(), sizeof(services->data));
+        services->data_length = data.size();
+        memcpy(services->data, data.data(), copy_len);
 
-        services->characteristic_count = service.characteristics().size();
+        const std::vector<SimpleBLE::Characteristic> characteristics = service.characteristics();
+        services->characteristic_count = characteristics.size();
         if (services->characteristic_count > SIMPLEBLE_CHARACTERISTIC_MAX_COUNT) {
             services->characteristic_count = SIMPLEBLE_CHARACTERISTIC_MAX_COUNT;
         }
 
         for (size_t i = 0; i < services->characteristic_count; i++) {
-            SimpleBLE::Characteristic characteristic = service.characteristics()[i];
+            SimpleBLE::Characteristic characteristic = characteristics[i];
 
-            services->characteristics[i].can_read = characteristic.can_read();
-            services->characteristics[i].can_write_request = characteristic.can_write_request();
-            services->characteristics[i].can_write_command = characteristic.can_write_command();
-            services->characteristics[i].can_notify = characteristic.can_notify();
-            services->characteristics[i].can_indicate = characteristic.can_indicate();
+            const SimpleBLE::CharacteristicProperties properties = characteristic.properties();
+            services->characteristics[i].properties = properties;
+            services->characteristics[i].can_read = properties & SimpleBLE::CharacteristicProperty::READ;
+            services->characteristics[i].can_write_request = properties & SimpleBLE::CharacteristicProperty::WRITE_REQUEST;
+            services->characteristics[i].can_write_command = properties & SimpleBLE::CharacteristicProperty::WRITE_COMMAND;
+            services->characteristics[i].can_notify = properties & SimpleBLE::CharacteristicProperty::NOTIFY;
+            services->characteristics[i].can_indicate = properties & SimpleBLE::CharacteristicProperty::INDICATE;
 
             memcpy(services->characteristics[i].uuid.value, characteristic.uuid().c_str(), SIMPLEBLE_UUID_STR_LEN);
-            services->characteristics[i].descriptor_count = characteristic.descriptors().size();
+
+            const std::vector<SimpleBLE::Descriptor> descriptors = characteristic.descriptors();
+            services->characteristics[i].descriptor_count = descriptors.size();
 
             if (services->characteristics[i].descriptor_count > SIMPLEBLE_DESCRIPTOR_MAX_COUNT) {
                 services->characteristics[i].descriptor_count = SIMPLEBLE_DESCRIPTOR_MAX_COUNT;
             }
 
             for (size_t j = 0; j < services->characteristics[i].descriptor_count; j++) {
-                SimpleBLE::Descriptor descriptor = characteristic.descriptors()[j];
+                SimpleBLE::Descriptor descriptor = descriptors[j];
 
                 memcpy(services->characteristics[i].descriptors[j].uuid.value, descriptor.uuid().c_str(),
                        SIMPLEBLE_UUID_STR_LEN);
@@ -23,10 +23,18 @@ TEST(ConfigTest, SimpleBluezConfigCanBeSetFromC) {
     simpleble_config_simplebluez_set_use_system_bus(false);
     simpleble_config_simplebluez_set_connection_timeout_ms(1234);
     simpleble_config_simplebluez_set_disconnection_timeout_ms(5678);
+    simpleble_config_simplebluez_set_peripheral_cache_max_entries(256);
+    simpleble_config_simplebluez_set_peripheral_cache_ttl_ms(30000);
 
     EXPECT_FALSE(simpleble_config_simplebluez_get_use_system_bus());
     EXPECT_EQ(simpleble_config_simplebluez_get_connection_timeout_ms(), 1234);
     EXPECT_EQ(simpleble_config_simplebluez_get_disconnection_timeout_ms(), 5678);
+    EXPECT_EQ(simpleble_config_simplebluez_get_peripheral_cache_max_entries(), 256);
+    EXPECT_EQ(simpleble_config_simplebluez_get_peripheral_cache_ttl_ms(), 30000);
+
+    simpleble_config_simplebluez_reset();
+    EXPECT_EQ(simpleble_config_simplebluez_get_peripheral_cache_max_entries(), 0);
+    EXPECT_EQ(simpleble_config_simplebluez_get_peripheral_cache_ttl_ms(), 0);
 
     simpleble_config_simplebluez_reset();
 }
@@ -0,0 +1,19 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "simplecble/metrics.h"
+#include "simplecble/simplecble.h"
+
+TEST(MetricsTest, ExportsJsonFromC) {
+    simpleble_metrics_set_enabled(true);
+    EXPECT_TRUE(simpleble_metrics_is_enabled());
+
+    char* json = simpleble_metrics_export_json();
+    ASSERT_NE(json, nullptr);
+    EXPECT_EQ(std::string(json), R"({"counters": [], "latencies": []})");
+    simpleble_free(json);
+
+    simpleble_metrics_set_enabled(false);
+    simpleble_metrics_reset();
+}
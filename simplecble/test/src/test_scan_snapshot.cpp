@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "simplecble/adapter.h"
+#include "simplecble/peripheral.h"
+#include "simplecble/simplecble.h"
+
+#include <string>
+
+TEST(ScanSnapshot, MatchesIndexedResults) {
+    simpleble_adapter_t adapter = simpleble_adapter_get_handle(0);
+    ASSERT_NE(nullptr, adapter);
+
+    simpleble_adapter_scan_start(adapter);
+    simpleble_adapter_scan_stop(adapter);
+
+    simpleble_adapter_scan_snapshot_t snapshot = simpleble_adapter_scan_get_results_snapshot(adapter);
+    ASSERT_NE(nullptr, snapshot);
+
+    const size_t count = simpleble_adapter_scan_snapshot_count(snapshot);
+    ASSERT_EQ(simpleble_adapter_scan_get_results_count(adapter), count);
+    ASSERT_GT(count, 0);
+
+    for (size_t i = 0; i < count; i++) {
+        simpleble_peripheral_t from_snapshot = simpleble_adapter_scan_snapshot_get_handle(snapshot, i);
+        simpleble_peripheral_t from_adapter = simpleble_adapter_scan_get_results_handle(adapter, i);
+        ASSERT_NE(nullptr, from_snapshot);
+        ASSERT_NE(nullptr, from_adapter);
+
+        char* snapshot_address = simpleble_peripheral_address(from_snapshot);
+        char* adapter_address = simpleble_peripheral_address(from_adapter);
+        EXPECT_EQ(std::string(adapter_address), std::string(snapshot_address));
+
+        simpleble_free(snapshot_address);
+        simpleble_free(adapter_address);
+        simpleble_peripheral_release_handle(from_adapter);
+        simpleble_peripheral_release_handle(from_snapshot);
+    }
+
+    EXPECT_EQ(nullptr, simpleble_adapter_scan_snapshot_get_handle(snapshot, count));
+
+    simpleble_adapter_scan_snapshot_release_handle(snapshot);
+    simpleble_adapter_release_handle(adapter);
+}
+
+TEST(ScanSnapshot, HandlesOutliveSnapshot) {
+    simpleble_adapter_t adapter = simpleble_adapter_get_handle(0);
+    ASSERT_NE(nullptr, adapter);
+    simpleble_adapter_scan_start(adapter);
+    simpleble_adapter_scan_stop(adapter);
+
+    simpleble_adapter_scan_snapshot_t snapshot = simpleble_adapter_scan_get_results_snapshot(adapter);
+    ASSERT_GT(simpleble_adapter_scan_snapshot_count(snapshot), 0);
+    simpleble_peripheral_t peripheral = simpleble_adapter_scan_snapshot_get_handle(snapshot, 0);
+    simpleble_adapter_scan_snapshot_release_handle(snapshot);
+
+    char* address = simpleble_peripheral_address(peripheral);
+    ASSERT_NE(nullptr, address);
+    simpleble_free(address);
+
+    simpleble_peripheral_release_handle(peripheral);
+    simpleble_adapter_release_handle(adapter);
+}
+
+TEST(ScanSnapshot, RejectsNullHandles) {
+    EXPECT_EQ(nullptr, simpleble_adapter_scan_get_results_snapshot(nullptr));
+    EXPECT_EQ(nullptr, simpleble_adapter_get_paired_peripherals_snapshot(nullptr));
+    EXPECT_EQ(nullptr, simpleble_adapter_get_connected_peripherals_snapshot(nullptr));
+    EXPECT_EQ(0, simpleble_adapter_scan_snapshot_count(nullptr));
+    EXPECT_EQ(nullptr, simpleble_adapter_scan_snapshot_get_handle(nullptr, 0));
+    simpleble_adapter_scan_snapshot_release_handle(nullptr);
+}
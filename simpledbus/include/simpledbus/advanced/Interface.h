@@ -132,7 +132,10 @@ class Interface {
 
         kvn::safe_callback<void(T)> on_changed;
 
-        void notify_changed() override { on_changed(get()); }
+        void notify_changed() override {
+            // Skip the conversion from Holder entirely if nobody is listening.
+            if (on_changed) on_changed(get());
+        }
     };
 
     Interface(std::shared_ptr<Connection> conn, std::shared_ptr<Proxy> proxy, const std::string& interface_name);
@@ -140,7 +143,7 @@ class Interface {
     virtual ~Interface() = default;
 
     // ----- LIFE CYCLE -----
-    void load(Holder options);
+    virtual void load(Holder options);
     void unload();
     bool is_loaded() const;
 
@@ -159,7 +162,7 @@ class Interface {
     virtual void message_handle(Message& msg) {}
 
     // ----- HANDLES -----
-    void handle_properties_changed(Holder changed_properties, Holder invalidated_properties);
+    virtual void handle_properties_changed(Holder changed_properties, Holder invalidated_properties);
     void handle_property_set(std::string property_name, Holder value);
     Holder handle_property_get(std::string property_name);
     Holder handle_property_get_all();
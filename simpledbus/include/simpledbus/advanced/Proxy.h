@@ -103,6 +103,8 @@ class Proxy : public std::enable_shared_from_this<Proxy> {
     // ----- INTERNAL CALLBACKS -----
     virtual void on_registration();
     virtual void on_child_signal_received(std::shared_ptr<Proxy> child);
+    // Called after objects below this proxy have been added, reloaded or removed.
+    virtual void on_descendants_changed();
 
   protected:
     bool _valid;
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <dbus/dbus.h>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <exception>
+#include <functional>
 #include <mutex>
 #include <unordered_map>
-#include <functional>
+#include <vector>
 #include "Message.h"
 
 namespace SimpleDBus {
@@ -13,6 +17,10 @@ class Message;
 
 class Connection {
   public:
+    // Invoked with the reply of an asynchronous method call. If the call failed, error holds the
+    // exception that send_with_reply() would have thrown and the reply is invalid.
+    using ReplyCallback = std::function<void(Message reply, std::exception_ptr error)>;
+
     Connection(::DBusBusType dbus_bus_type);
     ~Connection();
 
@@ -27,10 +35,33 @@ class Connection {
     void read_write_dispatch();
     Message pop_message();
 
+    // ----- EVENT LOOP -----
+    // Blocks until the bus socket has activity, a libdbus timeout expires, wakeup() is
+    // called or the given timeout elapses, then reads, writes and dispatches everything pending.
+    void read_write_dispatch_blocking(std::chrono::milliseconds timeout);
+
+    // Interrupts a thread blocked in read_write_dispatch_blocking().
+    void wakeup();
+
+    // File descriptor that becomes readable whenever read_write_dispatch_blocking() has work to do,
+    // for integration into external poll/epoll/select loops.
+    int dispatch_fd();
+
+    // Runs the handler from read_write_dispatch_blocking() whenever the given descriptor becomes readable
+    // or hangs up, so that sockets handed out over the bus are serviced by the same thread as its messages.
+    // The descriptor stays owned by the caller and must be unwatched before it's closed.
+    void watch_fd(int fd, std::function<void()> handler);
+    void unwatch_fd(int fd);
+
     void send(Message& msg);
     Message send_with_reply(Message& msg);
     Message send_with_reply_and_block(Message& msg);
 
+    // Sends a method call without waiting for its reply. The callback runs on the thread dispatching
+    // this connection (or right away if the reply is already in), so any number of calls can be in
+    // flight without blocking a thread on each.
+    void send_with_reply_async(Message& msg, ReplyCallback callback);
+
     bool register_object_path(const std::string& path, std::function<void(Message&)> handler);
     bool unregister_object_path(const std::string& path);
 
@@ -48,6 +79,42 @@ class Connection {
 
     static DBusHandlerResult static_message_handler(DBusConnection* connection, DBusMessage* message, void* user_data);
     static void static_reply_handler(DBusPendingCall* pending, void* user_data);
+    static void static_async_reply_handler(DBusPendingCall* pending, void* user_data);
+    static void static_async_context_free(void* user_data);
+    static std::exception_ptr reply_error(DBusMessage* reply, Message& msg);
+
+    // ----- EVENT LOOP -----
+    struct WatchEntry {
+        std::vector<DBusWatch*> watches;
+        bool registered = false;
+    };
+
+    int _epoll_fd = -1;
+    int _wakeup_fd = -1;
+
+    // Guards the watch and timeout tables. Only ever taken from within libdbus callbacks or
+    // while not calling into libdbus, so it can't deadlock against the connection lock.
+    std::mutex _watch_mutex;
+    std::unordered_map<int, WatchEntry> _watches;
+    std::unordered_map<DBusTimeout*, std::chrono::steady_clock::time_point> _timeouts;
+    std::unordered_map<int, std::function<void()>> _fd_watches;
+
+    void _event_loop_setup();
+    void _event_loop_teardown();
+    void _watch_update(int fd);
+    void _handle_watches(int fd, uint32_t events);
+    bool _handle_fd_watch(int fd);
+    void _handle_timeouts();
+    int _next_timeout_ms(std::chrono::milliseconds timeout);
+
+    static dbus_bool_t static_add_watch(DBusWatch* watch, void* user_data);
+    static void static_remove_watch(DBusWatch* watch, void* user_data);
+    static void static_toggle_watch(DBusWatch* watch, void* user_data);
+    static dbus_bool_t static_add_timeout(DBusTimeout* timeout, void* user_data);
+    static void static_remove_timeout(DBusTimeout* timeout, void* user_data);
+    static void static_toggle_timeout(DBusTimeout* timeout, void* user_data);
+    static void static_wakeup_main(void* user_data);
+    static void static_dispatch_status(DBusConnection* connection, DBusDispatchStatus new_status, void* user_data);
 
     struct AsyncContext {
         DBusMessage* reply = nullptr;
@@ -55,6 +122,12 @@ class Connection {
         std::mutex mtx;
         std::condition_variable cv;
     };
+
+    struct AsyncReplyContext {
+        Message msg;
+        ReplyCallback callback;
+        std::atomic_bool completed{false};
+    };
 };
 
 }  // namespace SimpleDBus
@@ -3,10 +3,12 @@
 #include <any>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
-#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace SimpleDBus {
@@ -93,6 +95,9 @@ class Holder {
         DICT
     } Type;
 
+    // Dictionaries are stored as an ordered list of <key, value> pairs, where the key is a Holder of a simple type.
+    using DictEntries = std::vector<std::pair<Holder, Holder>>;
+
     Type type() const;
     std::string represent() const;
     std::string signature() const;
@@ -101,8 +106,20 @@ class Holder {
     std::any get_contents() const;
 
     void dict_append(Type key_type, std::any key, Holder value);
+    void dict_append(Holder key, Holder value);
     void array_append(Holder holder);
 
+    // Byte arrays ("ay") can be stored as a single contiguous buffer instead of one Holder per byte.
+    // The buffer is shared between copies of the Holder, so copying them is cheap.
+    static Holder create_byte_array(const uint8_t* data, size_t size);
+    bool is_byte_array() const;
+    const uint8_t* byte_array_data() const;
+    size_t byte_array_size() const;
+
+    // Non-copying accessors. They return an empty container if the Holder is of a different type.
+    const std::string& string_ref() const;
+    const DictEntries& dict_ref() const;
+
     // Template implementations.
     template <typename T>
     static Holder create() {
@@ -110,8 +127,10 @@ class Holder {
         using U = std::decay_t<T>;
         if constexpr (detail::is_vector_v<U>) {
             h._type = ARRAY;
+            h._storage = Array();
         } else if constexpr (detail::is_map_v<U>) {
             h._type = DICT;
+            h._storage = DictEntries();
         }
         return h;
     }
@@ -124,13 +143,13 @@ class Holder {
             return value;
         } else if constexpr (std::is_same_v<U, bool>) {
             h._type = BOOLEAN;
-            h.holder_boolean = value;
+            h._storage = value;
         } else if constexpr (std::is_integral_v<U>) {
             h._type = _type_to_enum<U>();
-            h.holder_integer = static_cast<uint64_t>(value);
+            h._storage = static_cast<uint64_t>(value);
         } else if constexpr (std::is_floating_point_v<U>) {
             h._type = DOUBLE;
-            h.holder_double = static_cast<double>(value);
+            h._storage = static_cast<double>(value);
         } else if constexpr (std::is_convertible_v<U, std::string> && !detail::is_vector_v<U>) {
             if constexpr (std::is_same_v<U, ObjectPath>) {
                 h._type = OBJ_PATH;
@@ -139,17 +158,25 @@ class Holder {
             } else {
                 h._type = STRING;
             }
-            h.holder_string = static_cast<std::string>(value);
+            h._storage = static_cast<std::string>(value);
+        } else if constexpr (detail::is_vector_v<U> && std::is_same_v<typename U::value_type, uint8_t>) {
+            return create_byte_array(value.data(), value.size());
         } else if constexpr (detail::is_vector_v<U>) {
             h._type = ARRAY;
+            Array array;
+            array.reserve(value.size());
             for (const auto& item : value) {
-                h.array_append(Holder::create(item));
+                array.push_back(Holder::create(item));
             }
+            h._storage = std::move(array);
         } else if constexpr (detail::is_map_v<U>) {
             h._type = DICT;
+            DictEntries entries;
+            entries.reserve(value.size());
             for (const auto& [key, val] : value) {
-                h.dict_append(_type_to_enum<typename U::key_type>(), key, Holder::create(val));
+                entries.emplace_back(Holder::create(key), Holder::create(val));
             }
+            h._storage = std::move(entries);
         }
         return h;
     }
@@ -158,85 +185,87 @@ class Holder {
     T get() const {
         using U = std::decay_t<T>;
         if constexpr (std::is_same_v<U, bool>) {
-            return holder_boolean;
+            const bool* value = std::get_if<bool>(&_storage);
+            return value ? *value : false;
         } else if constexpr (std::is_integral_v<U>) {
-            return static_cast<U>(holder_integer);
+            const uint64_t* value = std::get_if<uint64_t>(&_storage);
+            return value ? static_cast<U>(*value) : U();
         } else if constexpr (std::is_floating_point_v<U>) {
-            return static_cast<U>(holder_double);
+            const double* value = std::get_if<double>(&_storage);
+            return value ? static_cast<U>(*value) : U();
         } else if constexpr (std::is_same_v<U, std::string>) {
-            return holder_string;
+            return string_ref();
         } else if constexpr (std::is_same_v<U, ObjectPath>) {
-            return ObjectPath(holder_string);
+            return ObjectPath(string_ref());
         } else if constexpr (std::is_same_v<U, Signature>) {
-            return Signature(holder_string);
+            return Signature(string_ref());
         } else if constexpr (detail::is_vector_v<U>) {
             using V = typename U::value_type;
+            const Bytes* bytes = std::get_if<Bytes>(&_storage);
+            if constexpr (std::is_integral_v<V> && std::is_constructible_v<U, const uint8_t*, const uint8_t*>) {
+                if (bytes) {
+                    return U((*bytes)->data(), (*bytes)->data() + (*bytes)->size());
+                }
+            }
+
             if constexpr (std::is_same_v<V, Holder>) {
-                return holder_array;
+                return _array_elements();
             } else {
                 U result;
-                for (const auto& h : holder_array) {
-                    result.push_back(h.template get<V>());
+                if (bytes) {
+                    for (const auto& h : _array_elements()) {
+                        result.push_back(h.template get<V>());
+                    }
+                } else {
+                    for (const auto& h : array_ref()) {
+                        result.push_back(h.template get<V>());
+                    }
                 }
                 return result;
             }
         } else if constexpr (detail::is_map_v<U>) {
             using K = typename U::key_type;
             using V = typename U::mapped_type;
-            if constexpr (std::is_same_v<V, Holder>) {
-                return _get_dict<K>(_type_to_enum<K>());
-            } else {
-                std::map<K, V> result;
-                for (auto& [key_type_internal, key, value] : holder_dict) {
-                    if (key_type_internal == _type_to_enum<K>()) {
-                        if constexpr (std::is_same_v<std::decay_t<K>, ObjectPath> || std::is_same_v<std::decay_t<K>, Signature>) {
-                            result[K(std::any_cast<std::string>(key))] = value.template get<V>();
-                        } else {
-                            result[std::any_cast<K>(key)] = value.template get<V>();
-                        }
+            U result;
+            for (const auto& [key, value] : dict_ref()) {
+                if (key._type == _type_to_enum<K>()) {
+                    if constexpr (std::is_same_v<V, Holder>) {
+                        result[key.template get<K>()] = value;
+                    } else {
+                        result[key.template get<K>()] = value.template get<V>();
                     }
                 }
-                return result;
             }
+            return result;
         } else {
             static_assert(detail::always_false_v<U>, "Unsupported type for Holder::get");
         }
     }
 
   private:
-    Type _type = NONE;
-    std::optional<std::string> _signature;
+    using Array = std::vector<Holder>;
+    using Bytes = std::shared_ptr<const std::vector<uint8_t>>;
+
+    // Only one representation is ever in use, so they share storage. Integers of all widths are
+    // kept as uint64_t and strings rely on the small-string optimization of std::string.
+    using Storage = std::variant<std::monostate, bool, uint64_t, double, std::string, Array, Bytes, DictEntries>;
 
-    bool holder_boolean = false;
-    uint64_t holder_integer = 0;
-    double holder_double = 0;
-    std::string holder_string;
-    std::vector<Holder> holder_array;
+    Type _type = NONE;
+    Storage _storage;
+    std::shared_ptr<const std::string> _signature;
 
-    // Dictionaries are stored within a vector as a tuple of <key_type, key, holder>
-    std::vector<std::tuple<Type, std::any, Holder>> holder_dict;
+    // Message serializes arrays straight from the storage and decodes dictionaries straight into it.
+    friend class Message;
 
+    // Throws std::logic_error for byte arrays, which don't hold their elements as Holders.
+    const std::vector<Holder>& array_ref() const;
+    std::vector<Holder> _array_elements() const;
     std::vector<std::string> _represent_container() const;
     std::string _represent_simple() const;
     std::string _signature_simple() const;
 
-    template <typename T>
-    std::map<T, Holder> _get_dict(Type key_type) const {
-        std::map<T, Holder> output;
-        for (auto& [key_type_internal, key, value] : holder_dict) {
-            if (key_type_internal == key_type) {
-                if constexpr (std::is_same_v<std::decay_t<T>, ObjectPath> || std::is_same_v<std::decay_t<T>, Signature>) {
-                    output[T(std::any_cast<std::string>(key))] = value;
-                } else {
-                    output[std::any_cast<T>(key)] = value;
-                }
-            }
-        }
-        return output;
-    }
-
     static std::string _signature_type(Type type) noexcept;
-    static std::string _represent_type(Type type, std::any value) noexcept;
+    static Holder _key_from_any(Type type, const std::any& key);
 
     template <typename T>
     static constexpr Type _type_to_enum() {
@@ -253,8 +282,6 @@ class Holder {
         if constexpr (std::is_same_v<U, Signature>) return SIGNATURE;
         return NONE;
     }
-
-    static bool _compare_any(Type type, const std::any& a, const std::any& b);
 };
 
 }  // namespace SimpleDBus
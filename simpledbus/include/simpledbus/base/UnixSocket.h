@@ -2,6 +2,7 @@
 
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 #include <cstddef>
 #include <cstdint>
@@ -41,6 +42,11 @@ class UnixSocket {
     ssize_t send(const std::vector<uint8_t>& data, int flags = MSG_NOSIGNAL);
     ssize_t receive(void* data, size_t size, int flags = 0);
 
+    // Sends each buffer as a packet of its own, in as few system calls as the socket buffer allows. Whenever the
+    // buffer is full, waits for room until timeout_ms have passed since the call. Returns how many packets were
+    // sent, which falls short of the batch if the timeout expired, or -1 with errno set if the socket failed.
+    ssize_t send_packets(const std::vector<iovec>& packets, int timeout_ms, int flags = MSG_NOSIGNAL);
+
   private:
     int _fd = -1;
 };
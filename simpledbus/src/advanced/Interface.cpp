@@ -18,14 +18,15 @@ std::shared_ptr<Proxy> Interface::proxy() const { return _proxy.lock(); }
 // ----- LIFE CYCLE -----
 
 void Interface::load(Holder options) {
-    auto changed_options = options.get<std::map<std::string, Holder>>();
-
     // NEW PROPERTY UPDATE
     // Note: Properties that have not been defined inside _property_bases will explicitly be ignored.
-    for (auto& [name, value] : changed_options) {
-        if (_properties.find(name) == _properties.end()) continue;
+    for (const auto& [key, value] : options.dict_ref()) {
+        if (key.type() != Holder::STRING) continue;
+
+        auto property = _properties.find(key.string_ref());
+        if (property == _properties.end()) continue;
 
-        _properties[name]->set(value);
+        property->second->set(value);
     }
 
     _loaded = true;
@@ -115,18 +116,20 @@ void Interface::property_invalidate(const std::string& property_name) {
 // ----- HANDLES -----
 
 void Interface::handle_properties_changed(Holder changed_properties, Holder invalidated_properties) {
-    auto changed_options = changed_properties.get<std::map<std::string, Holder>>();
-    for (auto& [name, value] : changed_options) {
-        if (_properties.find(name) == _properties.end()) continue;
+    for (const auto& [key, value] : changed_properties.dict_ref()) {
+        if (key.type() != Holder::STRING) continue;
+
+        auto property = _properties.find(key.string_ref());
+        if (property == _properties.end()) continue;
 
-        _properties[name]->set(value);
+        property->second->set(value);
     }
 
-    auto removed_options = invalidated_properties.get<std::vector<Holder>>();
-    for (auto& removed_option : removed_options) {
-        if (_properties.find(removed_option.get<std::string>()) == _properties.end()) continue;
+    for (const auto& removed_option : invalidated_properties.get<std::vector<std::string>>()) {
+        auto property = _properties.find(removed_option);
+        if (property == _properties.end()) continue;
 
-        _properties[removed_option.get<std::string>()]->invalidate();
+        property->second->invalidate();
     }
 }
 
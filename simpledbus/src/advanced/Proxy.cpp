@@ -26,6 +26,8 @@ void Proxy::on_registration() {}
 
 void Proxy::on_child_signal_received(std::shared_ptr<Proxy> /*child*/) { notify_parent_signal_received(); }
 
+void Proxy::on_descendants_changed() {}
+
 std::shared_ptr<Proxy> Proxy::path_create(const std::string& path) {
     return std::make_shared<Proxy>(_conn, _bus_name, path);
 }
@@ -189,41 +191,47 @@ void Proxy::path_add(const std::string& path, SimpleDBus::Holder managed_interfa
         auto child = path_get(path);
         child->revalidate();
         child->interfaces_load(managed_interfaces);
+        on_descendants_changed();
         return;
     }
 
-    // As children will be extensively accessed, we need to lock the child access mutex.
-    std::scoped_lock lock(_child_access_mutex);
+    {
+        // As children will be extensively accessed, we need to lock the child access mutex.
+        std::scoped_lock lock(_child_access_mutex);
 
-    if (PathUtils::is_child(_path, path)) {
-        // If the path is a direct child of the proxy path, create a new proxy for it.
-        std::shared_ptr<Proxy> child = path_create(path);
-        child->_parent = weak_from_this();
-        child->interfaces_load(managed_interfaces);
-        _children.emplace(std::make_pair(path, child));
-        on_child_created(path);
-    } else {
-        // If the new path is for a descendant of the current proxy, check if there is a child proxy for it.
-        auto child_result = std::find_if(
-            _children.begin(), _children.end(),
-            [path](const std::pair<std::string, std::shared_ptr<Proxy>>& child_data) -> bool {
-                return PathUtils::is_descendant(child_data.first, path);
-            });
-
-        if (child_result != _children.end()) {
-            // If there is a child proxy for the new path, forward it to that child proxy.
-            child_result->second->path_add(path, managed_interfaces);
-        } else {
-            // If there is no child proxy for the new path, create the child and forward the path to it.
-            // This path will be taken if an empty proxy object needs to be created for an intermediate path.
-            std::string child_path = PathUtils::next_child(_path, path);
-            std::shared_ptr<Proxy> child = path_create(child_path);
+        if (PathUtils::is_child(_path, path)) {
+            // If the path is a direct child of the proxy path, create a new proxy for it.
+            std::shared_ptr<Proxy> child = path_create(path);
             child->_parent = weak_from_this();
-            _children.emplace(std::make_pair(child_path, child));
-            child->path_add(path, managed_interfaces);
-            on_child_created(child_path);
+            child->interfaces_load(managed_interfaces);
+            _children.emplace(std::make_pair(path, child));
+            on_child_created(path);
+        } else {
+            // If the new path is for a descendant of the current proxy, check if there is a child proxy for it.
+            auto child_result = std::find_if(
+                _children.begin(), _children.end(),
+                [path](const std::pair<std::string, std::shared_ptr<Proxy>>& child_data) -> bool {
+                    return PathUtils::is_descendant(child_data.first, path);
+                });
+
+            if (child_result != _children.end()) {
+                // If there is a child proxy for the new path, forward it to that child proxy.
+                child_result->second->path_add(path, managed_interfaces);
+            } else {
+                // If there is no child proxy for the new path, create the child and forward the path to it.
+                // This path will be taken if an empty proxy object needs to be created for an intermediate path.
+                std::string child_path = PathUtils::next_child(_path, path);
+                std::shared_ptr<Proxy> child = path_create(child_path);
+                child->_parent = weak_from_this();
+                _children.emplace(std::make_pair(child_path, child));
+                child->path_add(path, managed_interfaces);
+                on_child_created(child_path);
+            }
         }
     }
+
+    // Notified without holding the child access mutex, so that the hook can safely walk the children.
+    on_descendants_changed();
 }
 
 bool Proxy::path_remove(const std::string& path, SimpleDBus::Holder options) {
@@ -240,12 +248,16 @@ bool Proxy::path_remove(const std::string& path, SimpleDBus::Holder options) {
         return false;
     }
 
-    // As children will be extensively accessed, we need to lock the child access mutex.
-    std::scoped_lock lock(_child_access_mutex);
+    {
+        // As children will be extensively accessed, we need to lock the child access mutex.
+        std::scoped_lock lock(_child_access_mutex);
+
+        // If the path is a direct child of the proxy path, forward the request to the child proxy.
+        std::string child_path = PathUtils::next_child(_path, path);
+        if (!path_exists(child_path)) {
+            return false;
+        }
 
-    // If the path is a direct child of the proxy path, forward the request to the child proxy.
-    std::string child_path = PathUtils::next_child(_path, path);
-    if (path_exists(child_path)) {
         bool must_erase = _children.at(child_path)->path_remove(path, options);
 
         // if the child proxy is no longer needed and there is only one active instance of the child proxy,
@@ -255,6 +267,7 @@ bool Proxy::path_remove(const std::string& path, SimpleDBus::Holder options) {
         }
     }
 
+    on_descendants_changed();
     return false;
 }
 
@@ -2,8 +2,15 @@
 #include <simpledbus/base/Connection.h>
 #include <simpledbus/base/Exceptions.h>
 #include <simpledbus/base/Logging.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
 #include <condition_variable>
+#include <cstring>
+#include <exception>
 #include <mutex>
 #include <stdexcept>
 #include <thread>
@@ -54,6 +61,8 @@ void Connection::uninit() {
         read_write_dispatch();
     } while (message.is_valid());
 
+    _event_loop_teardown();
+
     dbus_connection_unref(_conn);
     _initialized = false;
 }
@@ -126,6 +135,99 @@ void Connection::read_write_dispatch() {
     }
 }
 
+void Connection::read_write_dispatch_blocking(std::chrono::milliseconds timeout) {
+    if (!_initialized) {
+        throw Exception::NotInitialized();
+    }
+
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _event_loop_setup();
+
+        // Messages might have been queued by another thread (e.g. while blocking on a reply),
+        // in which case there is nothing to wait for.
+        if (dbus_connection_get_dispatch_status(_conn) == DBUS_DISPATCH_DATA_REMAINS) {
+            while (dbus_connection_dispatch(_conn) == DBUS_DISPATCH_DATA_REMAINS) {
+            }
+            return;
+        }
+    }
+
+    // The wait must happen without holding the connection mutex, otherwise every other
+    // user of the connection would be stalled until the bus becomes active.
+    epoll_event events[8];
+    int num_events = epoll_wait(_epoll_fd, events, 8, _next_timeout_ms(timeout));
+    if (num_events < 0) {
+        if (errno == EINTR) {
+            return;
+        }
+        throw std::runtime_error(std::string("Failed to wait on D-Bus connection: ") + std::strerror(errno));
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    for (int i = 0; i < num_events; i++) {
+        if (events[i].data.fd == _wakeup_fd) {
+            uint64_t counter;
+            while (::read(_wakeup_fd, &counter, sizeof(counter)) < 0 && errno == EINTR) {
+            }
+        } else if (!_handle_fd_watch(events[i].data.fd)) {
+            _handle_watches(events[i].data.fd, events[i].events);
+        }
+    }
+
+    _handle_timeouts();
+
+    while (dbus_connection_dispatch(_conn) == DBUS_DISPATCH_DATA_REMAINS) {
+    }
+}
+
+void Connection::wakeup() {
+    if (_wakeup_fd < 0) {
+        return;
+    }
+
+    uint64_t counter = 1;
+    while (::write(_wakeup_fd, &counter, sizeof(counter)) < 0 && errno == EINTR) {
+    }
+}
+
+int Connection::dispatch_fd() {
+    if (!_initialized) {
+        throw Exception::NotInitialized();
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _event_loop_setup();
+    return _epoll_fd;
+}
+
+void Connection::watch_fd(int fd, std::function<void()> handler) {
+    if (!_initialized) {
+        throw Exception::NotInitialized();
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _event_loop_setup();
+
+    std::lock_guard<std::mutex> watch_lock(_watch_mutex);
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    int operation = _fd_watches.count(fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (epoll_ctl(_epoll_fd, operation, fd, &event) < 0) {
+        throw std::runtime_error(std::string("Failed to watch file descriptor: ") + std::strerror(errno));
+    }
+    _fd_watches[fd] = std::move(handler);
+}
+
+void Connection::unwatch_fd(int fd) {
+    std::lock_guard<std::mutex> lock(_watch_mutex);
+    if (_fd_watches.erase(fd) && _epoll_fd >= 0) {
+        epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+}
+
 Message Connection::pop_message() {
     if (!_initialized) {
         throw Exception::NotInitialized();
@@ -162,6 +264,16 @@ Message Connection::send_with_reply(Message& msg) {
         throw std::runtime_error("Failed to set D-Bus pending call notify callback");
     }
 
+    // The reply might have been dispatched before the notify callback was installed,
+    // in which case the callback will never fire.
+    if (dbus_pending_call_get_completed(pending)) {
+        std::lock_guard<std::mutex> lock(ctx.mtx);
+        if (!ctx.completed) {
+            ctx.reply = dbus_pending_call_steal_reply(pending);
+            ctx.completed = true;
+        }
+    }
+
     bool timed_out = false;
     {
         std::unique_lock<std::mutex> lock(ctx.mtx);
@@ -186,19 +298,43 @@ Message Connection::send_with_reply(Message& msg) {
         throw std::runtime_error("Received null reply from D-Bus");
     }
 
-    if (dbus_message_get_type(reply) == DBUS_MESSAGE_TYPE_ERROR) {
-        const char* err_name = dbus_message_get_error_name(reply);
-        const char* err_text = "No error detail provided";
-
-        // Try to extract the error string argument if it exists
-        dbus_message_get_args(reply, nullptr, DBUS_TYPE_STRING, &err_text, DBUS_TYPE_INVALID);
+    if (std::exception_ptr error = reply_error(reply, msg)) {
         dbus_message_unref(reply);
-        throw Exception::SendFailed(err_name, err_text, msg.to_string());
+        std::rethrow_exception(error);
     }
 
     return Message::from_acquired(reply);
 }
 
+void Connection::send_with_reply_async(Message& msg, ReplyCallback callback) {
+    if (!_initialized) {
+        throw Exception::NotInitialized();
+    }
+
+    DBusPendingCall* pending = nullptr;
+    if (!dbus_connection_send_with_reply(_conn, msg, &pending, -1) || !pending) {
+        throw std::runtime_error("Failed to queue D-Bus message (Out of memory?)");
+    }
+
+    // The context is owned by the pending call from here on and released together with it.
+    // The sent message is only retained, so that it can be described if the call fails.
+    auto* ctx = new AsyncReplyContext{Message::from_retained(msg), std::move(callback)};
+    if (!dbus_pending_call_set_notify(pending, static_async_reply_handler, ctx, static_async_context_free)) {
+        delete ctx;
+        dbus_pending_call_cancel(pending);
+        dbus_pending_call_unref(pending);
+        throw std::runtime_error("Failed to set D-Bus pending call notify callback");
+    }
+
+    // The reply might have been dispatched before the notify callback was installed,
+    // in which case the callback will never fire.
+    if (dbus_pending_call_get_completed(pending)) {
+        static_async_reply_handler(pending, ctx);
+    }
+
+    dbus_pending_call_unref(pending);
+}
+
 Message Connection::send_with_reply_and_block(Message& msg) {
     if (!_initialized) {
         throw Exception::NotInitialized();
@@ -272,6 +408,9 @@ void Connection::static_reply_handler(DBusPendingCall* pending, void* user_data)
     auto* ctx = static_cast<AsyncContext*>(user_data);
 
     std::lock_guard<std::mutex> lock(ctx->mtx);
+    if (ctx->completed) {
+        return;
+    }
 
     // Steal the reply from the pending call object
     ctx->reply = dbus_pending_call_steal_reply(pending);
@@ -280,3 +419,320 @@ void Connection::static_reply_handler(DBusPendingCall* pending, void* user_data)
     // Wake the send_with_reply thread
     ctx->cv.notify_one();
 }
+
+void Connection::static_async_reply_handler(DBusPendingCall* pending, void* user_data) {
+    auto* ctx = static_cast<AsyncReplyContext*>(user_data);
+    if (ctx->completed.exchange(true)) {
+        return;
+    }
+
+    Message reply;
+    std::exception_ptr error;
+
+    DBusMessage* reply_raw = dbus_pending_call_steal_reply(pending);
+    if (!reply_raw) {
+        error = std::make_exception_ptr(std::runtime_error("Received null reply from D-Bus"));
+    } else if ((error = reply_error(reply_raw, ctx->msg))) {
+        dbus_message_unref(reply_raw);
+    } else {
+        reply = Message::from_acquired(reply_raw);
+    }
+
+    try {
+        ctx->callback(std::move(reply), error);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Exception in D-Bus reply callback: " + std::string(e.what()));
+    } catch (...) {
+        LOG_ERROR("Unknown exception in D-Bus reply callback");
+    }
+}
+
+void Connection::static_async_context_free(void* user_data) { delete static_cast<AsyncReplyContext*>(user_data); }
+
+std::exception_ptr Connection::reply_error(DBusMessage* reply, Message& msg) {
+    if (dbus_message_get_type(reply) != DBUS_MESSAGE_TYPE_ERROR) {
+        return nullptr;
+    }
+
+    const char* err_name = dbus_message_get_error_name(reply);
+    const char* err_text = "No error detail provided";
+
+    // Try to extract the error string argument if it exists
+    dbus_message_get_args(reply, nullptr, DBUS_TYPE_STRING, &err_text, DBUS_TYPE_INVALID);
+    return std::make_exception_ptr(Exception::SendFailed(err_name, err_text, msg.to_string()));
+}
+
+// ----- EVENT LOOP -----
+
+void Connection::_event_loop_setup() {
+    // The event loop is set up lazily, so that connections which are only ever polled
+    // don't replace the watch functions of the (shared) bus connection.
+    if (_epoll_fd >= 0) {
+        return;
+    }
+
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll_fd < 0) {
+        throw std::runtime_error(std::string("Failed to create epoll instance: ") + std::strerror(errno));
+    }
+
+    _wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_wakeup_fd < 0) {
+        int error = errno;
+        ::close(_epoll_fd);
+        _epoll_fd = -1;
+        throw std::runtime_error(std::string("Failed to create eventfd: ") + std::strerror(error));
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = _wakeup_fd;
+    epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wakeup_fd, &event);
+
+    dbus_connection_set_watch_functions(_conn, static_add_watch, static_remove_watch, static_toggle_watch, this,
+                                        nullptr);
+    dbus_connection_set_timeout_functions(_conn, static_add_timeout, static_remove_timeout, static_toggle_timeout,
+                                          this, nullptr);
+    dbus_connection_set_wakeup_main_function(_conn, static_wakeup_main, this, nullptr);
+    dbus_connection_set_dispatch_status_function(_conn, static_dispatch_status, this, nullptr);
+}
+
+void Connection::_event_loop_teardown() {
+    if (_epoll_fd < 0) {
+        return;
+    }
+
+    dbus_connection_set_dispatch_status_function(_conn, nullptr, nullptr, nullptr);
+    dbus_connection_set_wakeup_main_function(_conn, nullptr, nullptr, nullptr);
+    dbus_connection_set_timeout_functions(_conn, nullptr, nullptr, nullptr, nullptr, nullptr);
+    dbus_connection_set_watch_functions(_conn, nullptr, nullptr, nullptr, nullptr, nullptr);
+
+    std::lock_guard<std::mutex> lock(_watch_mutex);
+    _watches.clear();
+    _timeouts.clear();
+    _fd_watches.clear();
+
+    ::close(_wakeup_fd);
+    ::close(_epoll_fd);
+    _wakeup_fd = -1;
+    _epoll_fd = -1;
+}
+
+void Connection::_watch_update(int fd) {
+    // NOTE: Must be called with _watch_mutex held.
+    // libdbus usually creates separate read and write watches for the same socket,
+    // so the epoll registration needs to be the union of all enabled watches on the fd.
+    auto it = _watches.find(fd);
+    if (it == _watches.end()) {
+        return;
+    }
+
+    WatchEntry& entry = it->second;
+
+    uint32_t events = 0;
+    for (DBusWatch* watch : entry.watches) {
+        if (!dbus_watch_get_enabled(watch)) {
+            continue;
+        }
+
+        unsigned int flags = dbus_watch_get_flags(watch);
+        if (flags & DBUS_WATCH_READABLE) events |= EPOLLIN;
+        if (flags & DBUS_WATCH_WRITABLE) events |= EPOLLOUT;
+    }
+
+    if (events == 0) {
+        if (entry.registered) {
+            epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            entry.registered = false;
+        }
+    } else {
+        epoll_event event = {};
+        event.events = events;
+        event.data.fd = fd;
+        epoll_ctl(_epoll_fd, entry.registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event);
+        entry.registered = true;
+    }
+
+    if (entry.watches.empty()) {
+        _watches.erase(it);
+    }
+}
+
+void Connection::_handle_watches(int fd, uint32_t events) {
+    unsigned int flags = 0;
+    if (events & EPOLLIN) flags |= DBUS_WATCH_READABLE;
+    if (events & EPOLLOUT) flags |= DBUS_WATCH_WRITABLE;
+    if (events & EPOLLHUP) flags |= DBUS_WATCH_HANGUP;
+    if (events & EPOLLERR) flags |= DBUS_WATCH_ERROR;
+
+    std::vector<DBusWatch*> watches;
+    {
+        std::lock_guard<std::mutex> lock(_watch_mutex);
+        auto it = _watches.find(fd);
+        if (it == _watches.end()) {
+            return;
+        }
+        watches = it->second.watches;
+    }
+
+    // dbus_watch_handle() calls back into the watch functions, so the watch mutex can't be held here.
+    for (DBusWatch* watch : watches) {
+        {
+            std::lock_guard<std::mutex> lock(_watch_mutex);
+            auto it = _watches.find(fd);
+            if (it == _watches.end()) {
+                return;
+            }
+            auto& current = it->second.watches;
+            if (std::find(current.begin(), current.end(), watch) == current.end()) {
+                continue;
+            }
+        }
+
+        if (!dbus_watch_get_enabled(watch)) {
+            continue;
+        }
+
+        unsigned int watch_flags = flags & (dbus_watch_get_flags(watch) | DBUS_WATCH_HANGUP | DBUS_WATCH_ERROR);
+        if (watch_flags != 0) {
+            dbus_watch_handle(watch, watch_flags);
+        }
+    }
+}
+
+bool Connection::_handle_fd_watch(int fd) {
+    std::function<void()> handler;
+    {
+        std::lock_guard<std::mutex> lock(_watch_mutex);
+        auto it = _fd_watches.find(fd);
+        if (it == _fd_watches.end()) {
+            return false;
+        }
+        handler = it->second;
+    }
+
+    // The handler is run without the watch mutex, as it's expected to unwatch its descriptor on hangup.
+    try {
+        handler();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Exception in file descriptor handler: " + std::string(e.what()));
+    } catch (...) {
+        LOG_ERROR("Unknown exception in file descriptor handler");
+    }
+    return true;
+}
+
+void Connection::_handle_timeouts() {
+    auto now = std::chrono::steady_clock::now();
+
+    std::vector<DBusTimeout*> expired;
+    {
+        std::lock_guard<std::mutex> lock(_watch_mutex);
+        for (auto& [timeout, deadline] : _timeouts) {
+            if (dbus_timeout_get_enabled(timeout) && deadline <= now) {
+                expired.push_back(timeout);
+                deadline = now + std::chrono::milliseconds(dbus_timeout_get_interval(timeout));
+            }
+        }
+    }
+
+    for (DBusTimeout* timeout : expired) {
+        {
+            std::lock_guard<std::mutex> lock(_watch_mutex);
+            if (_timeouts.find(timeout) == _timeouts.end()) {
+                continue;
+            }
+        }
+        dbus_timeout_handle(timeout);
+    }
+}
+
+int Connection::_next_timeout_ms(std::chrono::milliseconds timeout) {
+    auto now = std::chrono::steady_clock::now();
+    auto wait = std::max(timeout, std::chrono::milliseconds(0));
+
+    std::lock_guard<std::mutex> lock(_watch_mutex);
+    for (auto& [dbus_timeout, deadline] : _timeouts) {
+        if (!dbus_timeout_get_enabled(dbus_timeout)) {
+            continue;
+        }
+
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now);
+        wait = std::clamp(remaining, std::chrono::milliseconds(0), wait);
+    }
+
+    return static_cast<int>(wait.count());
+}
+
+dbus_bool_t Connection::static_add_watch(DBusWatch* watch, void* user_data) {
+    Connection* conn = static_cast<Connection*>(user_data);
+    int fd = dbus_watch_get_unix_fd(watch);
+
+    std::lock_guard<std::mutex> lock(conn->_watch_mutex);
+    conn->_watches[fd].watches.push_back(watch);
+    conn->_watch_update(fd);
+    return TRUE;
+}
+
+void Connection::static_remove_watch(DBusWatch* watch, void* user_data) {
+    Connection* conn = static_cast<Connection*>(user_data);
+    int fd = dbus_watch_get_unix_fd(watch);
+
+    std::lock_guard<std::mutex> lock(conn->_watch_mutex);
+    auto it = conn->_watches.find(fd);
+    if (it == conn->_watches.end()) {
+        return;
+    }
+
+    auto& watches = it->second.watches;
+    watches.erase(std::remove(watches.begin(), watches.end(), watch), watches.end());
+    conn->_watch_update(fd);
+}
+
+void Connection::static_toggle_watch(DBusWatch* watch, void* user_data) {
+    Connection* conn = static_cast<Connection*>(user_data);
+
+    std::lock_guard<std::mutex> lock(conn->_watch_mutex);
+    conn->_watch_update(dbus_watch_get_unix_fd(watch));
+}
+
+dbus_bool_t Connection::static_add_timeout(DBusTimeout* timeout, void* user_data) {
+    Connection* conn = static_cast<Connection*>(user_data);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(dbus_timeout_get_interval(timeout));
+
+    {
+        std::lock_guard<std::mutex> lock(conn->_watch_mutex);
+        conn->_timeouts[timeout] = deadline;
+    }
+
+    // The dispatching thread might be blocked with a longer timeout than this one.
+    conn->wakeup();
+    return TRUE;
+}
+
+void Connection::static_remove_timeout(DBusTimeout* timeout, void* user_data) {
+    Connection* conn = static_cast<Connection*>(user_data);
+
+    std::lock_guard<std::mutex> lock(conn->_watch_mutex);
+    conn->_timeouts.erase(timeout);
+}
+
+void Connection::static_toggle_timeout(DBusTimeout* timeout, void* user_data) {
+    Connection* conn = static_cast<Connection*>(user_data);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(dbus_timeout_get_interval(timeout));
+
+    {
+        std::lock_guard<std::mutex> lock(conn->_watch_mutex);
+        conn->_timeouts[timeout] = deadline;
+    }
+
+    conn->wakeup();
+}
+
+void Connection::static_wakeup_main(void* user_data) { static_cast<Connection*>(user_data)->wakeup(); }
+
+void Connection::static_dispatch_status(DBusConnection* connection, DBusDispatchStatus new_status, void* user_data) {
+    if (new_status == DBUS_DISPATCH_DATA_REMAINS) {
+        static_cast<Connection*>(user_data)->wakeup();
+    }
+}
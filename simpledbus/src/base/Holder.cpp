@@ -1,6 +1,8 @@
 #include <simpledbus/base/Holder.h>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
+#include <typeinfo>
 
 #include "dbus/dbus-protocol.h"
 
@@ -20,36 +22,29 @@ bool Holder::operator==(const Holder& other) const {
     switch (_type) {
         case NONE:
             return true;
-        case BYTE:
-        case INT16:
-        case UINT16:
-        case INT32:
-        case UINT32:
-        case INT64:
-        case UINT64:
-            return holder_integer == other.holder_integer;
-        case BOOLEAN:
-            return holder_boolean == other.holder_boolean;
-        case DOUBLE:
-            return holder_double == other.holder_double;
-        case STRING:
-        case OBJ_PATH:
-        case SIGNATURE:
-            return holder_string == other.holder_string;
-        case ARRAY:
-            return holder_array == other.holder_array;
+        case ARRAY: {
+            const Bytes* bytes = std::get_if<Bytes>(&_storage);
+            const Bytes* other_bytes = std::get_if<Bytes>(&other._storage);
+            if (bytes && other_bytes) {
+                return **bytes == **other_bytes;
+            }
+            if (!bytes && !other_bytes) {
+                return array_ref() == other.array_ref();
+            }
+            return _array_elements() == other._array_elements();
+        }
         case DICT: {
-            if (holder_dict.size() != other.holder_dict.size()) {
+            const DictEntries& entries = dict_ref();
+            const DictEntries& other_entries = other.dict_ref();
+            if (entries.size() != other_entries.size()) {
                 return false;
             }
-            for (const auto& [type_a, key_a, val_a] : holder_dict) {
+            for (const auto& [key_a, val_a] : entries) {
                 bool found = false;
-                for (const auto& [type_b, key_b, val_b] : other.holder_dict) {
-                    if (type_a == type_b && val_a == val_b) {
-                        if (_compare_any(type_a, key_a, key_b)) {
-                            found = true;
-                            break;
-                        }
+                for (const auto& [key_b, val_b] : other_entries) {
+                    if (key_a == key_b && val_a == val_b) {
+                        found = true;
+                        break;
                     }
                 }
                 if (!found) return false;
@@ -57,7 +52,7 @@ bool Holder::operator==(const Holder& other) const {
             return true;
         }
         default:
-            return false;
+            return _storage == other._storage;
     }
 }
 
@@ -126,13 +121,14 @@ std::vector<std::string> Holder::_represent_container() const {
         case ARRAY: {
             output_lines.push_back("Array:");
             std::vector<std::string> additional_lines;
-            if (holder_array.size() > 0 && holder_array[0]._type == BYTE) {
+            std::vector<Holder> array_elements = _array_elements();
+            if (array_elements.size() > 0 && array_elements[0]._type == BYTE) {
                 // Dealing with an array of bytes, use custom print functionality.
                 std::string temp_line = "";
-                for (size_t i = 0; i < holder_array.size(); i++) {
+                for (size_t i = 0; i < array_elements.size(); i++) {
                     // Represent each byte as a hex string
                     std::stringstream stream;
-                    stream << std::setfill('0') << std::setw(2) << std::hex << ((int)holder_array[i].get<uint8_t>());
+                    stream << std::setfill('0') << std::setw(2) << std::hex << ((int)array_elements[i].get<uint8_t>());
                     temp_line += (stream.str() + " ");
                     if ((i + 1) % 32 == 0) {
                         additional_lines.push_back(temp_line);
@@ -141,8 +137,8 @@ std::vector<std::string> Holder::_represent_container() const {
                 }
                 additional_lines.push_back(temp_line);
             } else {
-                for (size_t i = 0; i < holder_array.size(); i++) {
-                    for (auto& line : holder_array[i]._represent_container()) {
+                for (size_t i = 0; i < array_elements.size(); i++) {
+                    for (auto& line : array_elements[i]._represent_container()) {
                         additional_lines.push_back(line);
                     }
                 }
@@ -154,8 +150,8 @@ std::vector<std::string> Holder::_represent_container() const {
         }
         case DICT:
             output_lines.push_back("Dictionary:");
-            for (auto& [key_type_internal, key, value] : holder_dict) {
-                output_lines.push_back(_represent_type(key_type_internal, key) + ":");
+            for (auto& [key, value] : dict_ref()) {
+                output_lines.push_back(key._represent_simple() + ":");
                 auto additional_lines = value._represent_container();
                 for (auto& line : additional_lines) {
                     output_lines.push_back("  " + line);
@@ -239,52 +235,9 @@ std::string Holder::_signature_type(Type type) noexcept {
     }
 }
 
-std::string Holder::_represent_type(Type type, std::any value) noexcept {
-    std::ostringstream output;
-    output << std::boolalpha;
-
-    switch (type) {
-        case BOOLEAN:
-            output << std::any_cast<bool>(value);
-            break;
-        case BYTE:
-            output << std::any_cast<uint8_t>(value);
-            break;
-        case INT16:
-            output << std::any_cast<int16_t>(value);
-            break;
-        case UINT16:
-            output << std::any_cast<uint16_t>(value);
-            break;
-        case INT32:
-            output << std::any_cast<int32_t>(value);
-            break;
-        case UINT32:
-            output << std::any_cast<uint32_t>(value);
-            break;
-        case INT64:
-            output << std::any_cast<int64_t>(value);
-            break;
-        case UINT64:
-            output << std::any_cast<uint64_t>(value);
-            break;
-        case DOUBLE:
-            output << std::any_cast<double>(value);
-            break;
-        case STRING:
-        case OBJ_PATH:
-        case SIGNATURE:
-            output << std::any_cast<std::string>(value);
-            break;
-        default:
-            break;
-    }
-    return output.str();
-}
-
 void Holder::signature_override(const std::string& signature) {
     // TODO: Check that the signature is valid for the Holder type and contents.
-    _signature = signature;
+    _signature = std::make_shared<const std::string>(signature);
 }
 
 std::string Holder::signature() const {
@@ -308,15 +261,21 @@ std::string Holder::signature() const {
         case SIGNATURE:
             output = _signature_simple();
             break;
-        case ARRAY:
+        case ARRAY: {
             output = DBUS_TYPE_ARRAY_AS_STRING;
-            if (holder_array.size() == 0) {
+            if (is_byte_array()) {
+                output += DBUS_TYPE_BYTE_AS_STRING;
+                break;
+            }
+
+            const std::vector<Holder>& array = array_ref();
+            if (array.size() == 0) {
                 output += DBUS_TYPE_VARIANT_AS_STRING;
             } else {
-                // Check if all elements of holder_array are the same type
-                auto first_type = holder_array[0]._type;
+                // Check if all elements of the array are the same type
+                auto first_type = array[0]._type;
                 bool all_same_type = true;
-                for (auto& element : holder_array) {
+                for (auto& element : array) {
                     if (element._type != first_type) {
                         all_same_type = false;
                         break;
@@ -324,25 +283,27 @@ std::string Holder::signature() const {
                 }
 
                 if (all_same_type) {
-                    output += holder_array[0]._signature_simple();
+                    output += array[0]._signature_simple();
                 } else {
                     output += DBUS_TYPE_VARIANT_AS_STRING;
                 }
             }
             break;
-        case DICT:
+        }
+        case DICT: {
             output = DBUS_TYPE_ARRAY_AS_STRING;
             output += DBUS_DICT_ENTRY_BEGIN_CHAR_AS_STRING;
 
-            if (holder_dict.size() == 0) {
+            const DictEntries& entries = dict_ref();
+            if (entries.size() == 0) {
                 output += DBUS_TYPE_STRING_AS_STRING;
                 output += DBUS_TYPE_VARIANT_AS_STRING;
             } else {
-                // Check if all keys of holder_dict are the same type
-                auto first_key_type = std::get<0>(holder_dict[0]);
+                // Check if all keys of the dictionary are the same type
+                auto first_key_type = entries[0].first._type;
                 bool all_same_key_type = true;
-                for (auto& [key_type_internal, key, value] : holder_dict) {
-                    if (key_type_internal != first_key_type) {
+                for (auto& [key, value] : entries) {
+                    if (key._type != first_key_type) {
                         all_same_key_type = false;
                         break;
                     }
@@ -353,10 +314,10 @@ std::string Holder::signature() const {
                     output += DBUS_TYPE_VARIANT_AS_STRING;
                 }
 
-                // Check if all values of holder_dict are the same type
-                auto first_value_type = std::get<2>(holder_dict[0])._type;
+                // Check if all values of the dictionary are the same type
+                auto first_value_type = entries[0].second._type;
                 bool all_same_value_type = true;
-                for (auto& [key_type_internal, key, value] : holder_dict) {
+                for (auto& [key, value] : entries) {
                     if (value._type != first_value_type) {
                         all_same_value_type = false;
                         break;
@@ -364,7 +325,7 @@ std::string Holder::signature() const {
                 }
 
                 if (all_same_value_type && first_value_type != ARRAY && first_value_type != DICT) {
-                    output += std::get<2>(holder_dict[0])._signature_simple();
+                    output += entries[0].second._signature_simple();
                 } else {
                     output += DBUS_TYPE_VARIANT_AS_STRING;
                 }
@@ -372,6 +333,7 @@ std::string Holder::signature() const {
 
             output += DBUS_DICT_ENTRY_END_CHAR_AS_STRING;
             break;
+        }
         default:
             break;
     }
@@ -410,48 +372,148 @@ std::any Holder::get_contents() const {
     }
 }
 
-void Holder::array_append(Holder holder) { holder_array.push_back(holder); }
+void Holder::array_append(Holder holder) {
+    if (is_byte_array()) {
+        _storage = _array_elements();
+    } else if (!std::holds_alternative<Array>(_storage)) {
+        _storage = Array();
+    }
+    std::get<Array>(_storage).push_back(std::move(holder));
+}
 
 void Holder::dict_append(Type key_type, std::any key, Holder value) {
-    if (key.type() == typeid(const char*)) {
-        key = std::string(std::any_cast<const char*>(key));
-    } else if (key.type() == typeid(ObjectPath)) {
-        key = std::string(std::any_cast<ObjectPath>(key));
-    } else if (key.type() == typeid(Signature)) {
-        key = std::string(std::any_cast<Signature>(key));
+    if (!std::holds_alternative<DictEntries>(_storage)) {
+        _storage = DictEntries();
     }
 
     // TODO : VALIDATE THAT THE SPECIFIED KEY TYPE IS CORRECT
 
-    holder_dict.push_back(std::make_tuple(key_type, key, value));
+    dict_append(_key_from_any(key_type, key), std::move(value));
 }
 
-bool Holder::_compare_any(Type type, const std::any& a, const std::any& b) {
-    if (a.type() != b.type()) return false;
+void Holder::dict_append(Holder key, Holder value) {
+    if (!std::holds_alternative<DictEntries>(_storage)) {
+        _storage = DictEntries();
+    }
+
+    // Appending an existing key replaces its value, so that every key is only sent once.
+    DictEntries& entries = std::get<DictEntries>(_storage);
+    for (auto& entry : entries) {
+        if (entry.first == key) {
+            entry.second = std::move(value);
+            return;
+        }
+    }
+    entries.emplace_back(std::move(key), std::move(value));
+}
+
+Holder Holder::create_byte_array(const uint8_t* data, size_t size) {
+    Holder h;
+    h._type = ARRAY;
+    h._storage = std::make_shared<const std::vector<uint8_t>>(data, data + size);
+    return h;
+}
+
+bool Holder::is_byte_array() const { return std::holds_alternative<Bytes>(_storage); }
+
+const uint8_t* Holder::byte_array_data() const {
+    const Bytes* bytes = std::get_if<Bytes>(&_storage);
+    return bytes ? (*bytes)->data() : nullptr;
+}
+
+size_t Holder::byte_array_size() const {
+    const Bytes* bytes = std::get_if<Bytes>(&_storage);
+    return bytes ? (*bytes)->size() : 0;
+}
+
+const std::string& Holder::string_ref() const {
+    static const std::string empty;
+    const std::string* value = std::get_if<std::string>(&_storage);
+    return value ? *value : empty;
+}
+
+const std::vector<Holder>& Holder::array_ref() const {
+    static const std::vector<Holder> empty;
+    if (is_byte_array()) {
+        throw std::logic_error("Byte arrays can't be accessed as an array of Holders");
+    }
+    const Array* value = std::get_if<Array>(&_storage);
+    return value ? *value : empty;
+}
+
+const Holder::DictEntries& Holder::dict_ref() const {
+    static const DictEntries empty;
+    const DictEntries* value = std::get_if<DictEntries>(&_storage);
+    return value ? *value : empty;
+}
+
+std::vector<Holder> Holder::_array_elements() const {
+    const Bytes* bytes = std::get_if<Bytes>(&_storage);
+    if (!bytes) {
+        return array_ref();
+    }
+
+    std::vector<Holder> elements;
+    elements.reserve((*bytes)->size());
+    for (uint8_t byte : **bytes) {
+        elements.push_back(Holder::create<uint8_t>(byte));
+    }
+    return elements;
+}
+
+namespace {
+
+// Keys are passed in as std::any, so the exact integer type they were stored with is unknown.
+template <typename... Ts>
+bool any_to_integer(const std::any& value, uint64_t& output) {
+    return ((value.type() == typeid(Ts) ? (output = static_cast<uint64_t>(std::any_cast<Ts>(value)), true) : false) ||
+            ...);
+}
+
+}  // namespace
+
+Holder Holder::_key_from_any(Type type, const std::any& key) {
+    Holder h;
+    h._type = type;
+
     switch (type) {
         case BOOLEAN:
-            return std::any_cast<bool>(a) == std::any_cast<bool>(b);
+            h._storage = std::any_cast<bool>(key);
+            break;
         case BYTE:
-            return std::any_cast<uint8_t>(a) == std::any_cast<uint8_t>(b);
         case INT16:
-            return std::any_cast<int16_t>(a) == std::any_cast<int16_t>(b);
         case UINT16:
-            return std::any_cast<uint16_t>(a) == std::any_cast<uint16_t>(b);
         case INT32:
-            return std::any_cast<int32_t>(a) == std::any_cast<int32_t>(b);
         case UINT32:
-            return std::any_cast<uint32_t>(a) == std::any_cast<uint32_t>(b);
         case INT64:
-            return std::any_cast<int64_t>(a) == std::any_cast<int64_t>(b);
-        case UINT64:
-            return std::any_cast<uint64_t>(a) == std::any_cast<uint64_t>(b);
+        case UINT64: {
+            uint64_t value = 0;
+            if (!any_to_integer<uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t, char, long,
+                                unsigned long, long long, unsigned long long>(key, value)) {
+                throw std::bad_any_cast();
+            }
+            h._storage = value;
+            break;
+        }
         case DOUBLE:
-            return std::any_cast<double>(a) == std::any_cast<double>(b);
+            h._storage = std::any_cast<double>(key);
+            break;
         case STRING:
         case OBJ_PATH:
         case SIGNATURE:
-            return std::any_cast<std::string>(a) == std::any_cast<std::string>(b);
+            if (key.type() == typeid(const char*)) {
+                h._storage = std::string(std::any_cast<const char*>(key));
+            } else if (key.type() == typeid(ObjectPath)) {
+                h._storage = std::string(std::any_cast<ObjectPath>(key));
+            } else if (key.type() == typeid(Signature)) {
+                h._storage = std::string(std::any_cast<Signature>(key));
+            } else {
+                h._storage = std::any_cast<std::string>(key);
+            }
+            break;
         default:
-            return false;
+            h._type = NONE;
+            break;
     }
+    return h;
 }
@@ -4,25 +4,6 @@
 
 using namespace SimpleDBus;
 
-#define MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents)                                   \
-    for (auto& [key, value] : dict_contents) {                                                \
-        DBusMessageIter entry_iter;                                                           \
-        dbus_message_iter_open_container(&sub_iter, DBUS_TYPE_DICT_ENTRY, NULL, &entry_iter); \
-        dbus_message_iter_append_basic(&entry_iter, key_sig, &key);                           \
-        _append_argument(&entry_iter, value, value_sig);                                      \
-        dbus_message_iter_close_container(&sub_iter, &entry_iter);                            \
-    }
-
-#define MESSAGE_DICT_APPEND_KEY_STR(key_sig, dict_contents)                                   \
-    for (auto& [key, value] : dict_contents) {                                                \
-        const char* p_value = key.c_str();                                                    \
-        DBusMessageIter entry_iter;                                                           \
-        dbus_message_iter_open_container(&sub_iter, DBUS_TYPE_DICT_ENTRY, NULL, &entry_iter); \
-        dbus_message_iter_append_basic(&entry_iter, key_sig, &p_value);                       \
-        _append_argument(&entry_iter, value, value_sig);                                      \
-        dbus_message_iter_close_container(&sub_iter, &entry_iter);                            \
-    }
-
 std::atomic_int32_t Message::_creation_counter = 0;
 
 Message::Message() {}
@@ -199,67 +180,44 @@ void Message::_append_argument(DBusMessageIter* iter, const Holder& argument, co
             auto sig_next = signature.substr(1);
             DBusMessageIter sub_iter;
             dbus_message_iter_open_container(iter, DBUS_TYPE_ARRAY, sig_next.c_str(), &sub_iter);
-            if (sig_next[0] != DBUS_DICT_ENTRY_BEGIN_CHAR) {
-                auto array_contents = argument.get<std::vector<Holder>>();
-                for (auto elem : array_contents) {
-                    _append_argument(&sub_iter, elem, sig_next);
+            if (sig_next == DBUS_TYPE_BYTE_AS_STRING) {
+                // Byte arrays are appended in a single call instead of byte by byte.
+                if (argument.is_byte_array()) {
+                    const uint8_t* p_bytes = argument.byte_array_data();
+                    dbus_message_iter_append_fixed_array(&sub_iter, DBUS_TYPE_BYTE, &p_bytes,
+                                                         static_cast<int>(argument.byte_array_size()));
+                } else {
+                    auto bytes = argument.get<std::vector<uint8_t>>();
+                    const uint8_t* p_bytes = bytes.data();
+                    dbus_message_iter_append_fixed_array(&sub_iter, DBUS_TYPE_BYTE, &p_bytes,
+                                                         static_cast<int>(bytes.size()));
+                }
+            } else if (sig_next[0] != DBUS_DICT_ENTRY_BEGIN_CHAR) {
+                if (argument.is_byte_array()) {
+                    for (const auto& elem : argument._array_elements()) {
+                        _append_argument(&sub_iter, elem, sig_next);
+                    }
+                } else {
+                    for (const auto& elem : argument.array_ref()) {
+                        _append_argument(&sub_iter, elem, sig_next);
+                    }
                 }
             } else {
                 sig_next = sig_next.substr(1, sig_next.length() - 2);
-                auto key_sig = sig_next[0];
+                auto key_sig = sig_next.substr(0, 1);
                 auto value_sig = sig_next.substr(1);
 
-                switch (key_sig) {
-                    case DBUS_TYPE_BYTE: {
-                        auto dict_contents = argument.get<std::map<uint8_t, Holder>>();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_INT16: {
-                        auto dict_contents = argument.get<std::map<int16_t, Holder>>();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_UINT16: {
-                        auto dict_contents = argument.get<std::map<uint16_t, Holder>>();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_INT32: {
-                        auto dict_contents = argument.get<std::map<int32_t, Holder>>();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_UINT32: {
-                        auto dict_contents = argument.get<std::map<uint32_t, Holder>>();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_INT64: {
-                        auto dict_contents = argument.get<std::map<int64_t, Holder>>();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_UINT64: {
-                        auto dict_contents = argument.get<std::map<uint64_t, Holder>>();
-                        MESSAGE_DICT_APPEND_KEY_NUM(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_STRING: {
-                        auto dict_contents = argument.get<std::map<std::string, Holder>>();
-                        MESSAGE_DICT_APPEND_KEY_STR(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_OBJECT_PATH: {
-                        auto dict_contents = argument.get<std::map<ObjectPath, Holder>>();
-                        MESSAGE_DICT_APPEND_KEY_STR(key_sig, dict_contents);
-                        break;
-                    }
-                    case DBUS_TYPE_SIGNATURE: {
-                        auto dict_contents = argument.get<std::map<Signature, Holder>>();
-                        MESSAGE_DICT_APPEND_KEY_STR(key_sig, dict_contents);
-                        break;
+                // Entries with a key type that doesn't match the signature are skipped.
+                for (const auto& [key, value] : argument.dict_ref()) {
+                    if (key.signature() != key_sig) {
+                        continue;
                     }
+
+                    DBusMessageIter entry_iter;
+                    dbus_message_iter_open_container(&sub_iter, DBUS_TYPE_DICT_ENTRY, NULL, &entry_iter);
+                    _append_argument(&entry_iter, key, key_sig);
+                    _append_argument(&entry_iter, value, value_sig);
+                    dbus_message_iter_close_container(&sub_iter, &entry_iter);
                 }
             }
             dbus_message_iter_close_container(iter, &sub_iter);
@@ -415,27 +373,19 @@ Holder Message::_extract_bytearray(DBusMessageIter* iter) {
     const unsigned char* bytes;
     int len;
     dbus_message_iter_get_fixed_array(iter, &bytes, &len);
-    Holder holder_array = Holder::create<std::vector<Holder>>();
-    for (int i = 0; i < len; i++) {
-        holder_array.array_append(Holder::create<uint8_t>(bytes[i]));
-    }
-    return holder_array;
+    return Holder::create_byte_array(bytes, static_cast<size_t>(len));
 }
 
 Holder Message::_extract_array(DBusMessageIter* iter) {
     Holder holder_array = Holder::create<std::vector<Holder>>();
     _indent += 1;
-    int current_type = dbus_message_iter_get_arg_type(iter);
-    if (current_type == DBUS_TYPE_BYTE) {
-        holder_array = _extract_bytearray(iter);
-    } else {
-        while ((current_type = dbus_message_iter_get_arg_type(iter)) != DBUS_TYPE_INVALID) {
-            Holder h = _extract_generic(iter);
-            if (h.type() != Holder::NONE) {
-                holder_array.array_append(h);
-            }
-            dbus_message_iter_next(iter);
+    int current_type;
+    while ((current_type = dbus_message_iter_get_arg_type(iter)) != DBUS_TYPE_INVALID) {
+        Holder h = _extract_generic(iter);
+        if (h.type() != Holder::NONE) {
+            holder_array.array_append(h);
         }
+        dbus_message_iter_next(iter);
     }
     _indent -= 1;
     return holder_array;
@@ -464,7 +414,8 @@ Holder Message::_extract_dict(DBusMessageIter* iter) {
             holder_initialized = true;
         }
 
-        holder_dict.dict_append(key.type(), key.get_contents(), value);
+        // A message can't carry the same key twice, so the duplicate check of dict_append() is skipped.
+        std::get<Holder::DictEntries>(holder_dict._storage).emplace_back(std::move(key), std::move(value));
         dbus_message_iter_next(iter);
     }
     _indent -= 1;
@@ -541,6 +492,9 @@ Holder Message::_extract_generic(DBusMessageIter* iter) {
                 int sub_type = dbus_message_iter_get_arg_type(&sub);
                 if (sub_type == DBUS_TYPE_DICT_ENTRY) {
                     return _extract_dict(&sub);
+                } else if (dbus_message_iter_get_element_type(iter) == DBUS_TYPE_BYTE) {
+                    // Byte arrays are copied out in one go instead of element by element.
+                    return _extract_bytearray(&sub);
                 } else {
                     return _extract_array(&sub);
                 }
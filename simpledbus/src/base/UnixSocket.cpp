@@ -1,6 +1,9 @@
 #include <simpledbus/base/UnixSocket.h>
 
+#include <poll.h>
+
 #include <cerrno>
+#include <chrono>
 #include <cstring>
 #include <stdexcept>
 #include <string>
@@ -97,3 +100,46 @@ ssize_t UnixSocket::receive(void* data, size_t size, int flags) {
 
     return ::recv(_fd, data, size, flags);
 }
+
+ssize_t UnixSocket::send_packets(const std::vector<iovec>& packets, int timeout_ms, int flags) {
+    if (_fd < 0) {
+        errno = EBADF;
+        return -1;
+    }
+
+    std::vector<mmsghdr> messages(packets.size());
+    for (size_t i = 0; i < packets.size(); i++) {
+        messages[i].msg_hdr.msg_iov = const_cast<iovec*>(&packets[i]);
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    size_t sent = 0;
+    while (sent < messages.size()) {
+        int result = ::sendmmsg(_fd, messages.data() + sent, messages.size() - sent, flags | MSG_DONTWAIT);
+        if (result > 0) {
+            sent += static_cast<size_t>(result);
+            continue;
+        }
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            return -1;
+        }
+
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            break;
+        }
+
+        // A hangup or error also wakes the poll up, and is then reported by the next send.
+        pollfd descriptor = {_fd, POLLOUT, 0};
+        if (::poll(&descriptor, 1, static_cast<int>(remaining.count())) < 0 && errno != EINTR) {
+            return -1;
+        }
+    }
+
+    return static_cast<ssize_t>(sent);
+}
@@ -1,6 +1,6 @@
 
 #include <gtest/gtest.h>
-#include "helpers/PythonRunner.h"
+#include "pythonrunner/PythonRunner.h"
 
 int main(int argc, char** argv) {
     PythonRunner runner("test_fixture.py");
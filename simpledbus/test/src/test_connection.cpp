@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <simpledbus/base/Connection.h>
+#include <simpledbus/base/Exceptions.h>
+#include <simpledbus/base/Message.h>
+#include <simpledbus/base/UnixSocket.h>
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <thread>
+#include <vector>
+
+using namespace SimpleDBus;
+
+class ConnectionTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        conn = new Connection(DBUS_BUS_SESSION);
+        conn->init();
+    }
+
+    void TearDown() override {
+        conn->uninit();
+        delete conn;
+        conn = nullptr;
+    }
+
+    Connection* conn;
+};
+
+TEST_F(ConnectionTest, DispatchFdIsValid) { EXPECT_GE(conn->dispatch_fd(), 0); }
+
+TEST_F(ConnectionTest, WakeupInterruptsBlockingDispatch) {
+    std::thread waker([this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        conn->wakeup();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    conn->read_write_dispatch_blocking(std::chrono::seconds(10));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    waker.join();
+
+    EXPECT_LT(elapsed, std::chrono::seconds(5));
+}
+
+TEST_F(ConnectionTest, BlockingDispatchTimesOut) {
+    // Drain anything left over from connecting to the bus.
+    conn->read_write_dispatch_blocking(std::chrono::milliseconds(0));
+
+    auto start = std::chrono::steady_clock::now();
+    conn->read_write_dispatch_blocking(std::chrono::milliseconds(50));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // epoll_wait rounds to whole milliseconds, leave some slack below the requested timeout.
+    EXPECT_GE(elapsed, std::chrono::milliseconds(45));
+    EXPECT_LT(elapsed, std::chrono::seconds(5));
+}
+
+TEST_F(ConnectionTest, BlockingDispatchDeliversMessages) {
+    std::atomic_bool received = false;
+    conn->register_object_path("/simpledbus/test", [&received](Message& msg) { received = true; });
+
+    Message msg = Message::create_method_call(conn->unique_name(), "/simpledbus/test", "simpledbus.test", "Ping");
+    conn->send(msg);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!received && std::chrono::steady_clock::now() < deadline) {
+        conn->read_write_dispatch_blocking(std::chrono::milliseconds(100));
+    }
+
+    conn->unregister_object_path("/simpledbus/test");
+    EXPECT_TRUE(received);
+}
+
+TEST_F(ConnectionTest, SendWithReplyWhileDispatching) {
+    std::atomic_bool running = true;
+    std::thread dispatcher([this, &running]() {
+        while (running) {
+            conn->read_write_dispatch_blocking(std::chrono::milliseconds(500));
+        }
+    });
+
+    Message msg = Message::create_method_call("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+                                              "GetId");
+    Message reply = conn->send_with_reply(msg);
+
+    running = false;
+    conn->wakeup();
+    dispatcher.join();
+
+    Holder h_reply = reply.extract();
+    EXPECT_EQ(h_reply.type(), Holder::Type::STRING);
+    EXPECT_FALSE(h_reply.get<std::string>().empty());
+}
+
+TEST_F(ConnectionTest, SendWithReplyAsyncKeepsManyCallsInFlight) {
+    constexpr int CALL_COUNT = 200;
+    std::atomic_int replies = 0;
+    std::atomic_int failures = 0;
+
+    for (int i = 0; i < CALL_COUNT; i++) {
+        Message msg = Message::create_method_call("org.freedesktop.DBus", "/org/freedesktop/DBus",
+                                                  "org.freedesktop.DBus", "GetId");
+        conn->send_with_reply_async(msg, [&replies, &failures](Message reply, std::exception_ptr error) {
+            if (error || reply.extract().get<std::string>().empty()) {
+                failures++;
+            }
+            replies++;
+        });
+    }
+
+    // All calls are issued before any reply is processed, and completed from this very thread.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (replies < CALL_COUNT && std::chrono::steady_clock::now() < deadline) {
+        conn->read_write_dispatch_blocking(std::chrono::milliseconds(100));
+    }
+
+    EXPECT_EQ(replies, CALL_COUNT);
+    EXPECT_EQ(failures, 0);
+}
+
+TEST_F(ConnectionTest, SendWithReplyAsyncReportsErrors) {
+    std::atomic_bool completed = false;
+    bool reply_valid = true;
+    std::exception_ptr error;
+
+    Message msg = Message::create_method_call("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+                                              "NoSuchMethod");
+    conn->send_with_reply_async(msg, [&completed, &reply_valid, &error](Message reply, std::exception_ptr e) {
+        reply_valid = reply.is_valid();
+        error = e;
+        completed = true;
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!completed && std::chrono::steady_clock::now() < deadline) {
+        conn->read_write_dispatch_blocking(std::chrono::milliseconds(100));
+    }
+
+    ASSERT_TRUE(completed);
+    EXPECT_FALSE(reply_valid);
+    ASSERT_TRUE(error);
+    EXPECT_THROW(std::rethrow_exception(error), Exception::SendFailed);
+}
+
+TEST_F(ConnectionTest, WatchedFdIsServicedByBlockingDispatch) {
+    auto sockets = UnixSocket::create_pair();
+    std::vector<uint8_t> received;
+    bool hung_up = false;
+
+    int fd = sockets.second.fd();
+    conn->watch_fd(fd, [&]() {
+        uint8_t buffer[16];
+        ssize_t size = sockets.second.receive(buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (size > 0) {
+            received.insert(received.end(), buffer, buffer + size);
+        } else if (size == 0) {
+            hung_up = true;
+            conn->unwatch_fd(fd);
+        }
+    });
+
+    sockets.first.send(std::vector<uint8_t>{0x01, 0x02});
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received.empty() && std::chrono::steady_clock::now() < deadline) {
+        conn->read_write_dispatch_blocking(std::chrono::milliseconds(100));
+    }
+    EXPECT_EQ(received, std::vector<uint8_t>({0x01, 0x02}));
+
+    sockets.first.close();
+    while (!hung_up && std::chrono::steady_clock::now() < deadline) {
+        conn->read_write_dispatch_blocking(std::chrono::milliseconds(100));
+    }
+    EXPECT_TRUE(hung_up);
+}
@@ -237,3 +237,76 @@ TEST(Holder, DictionaryObjectPathKey) {
         EXPECT_EQ(out[ObjectPath("/test")].get<int32_t>(), 123);
     });
 }
+
+TEST(Holder, ByteArray) {
+    const uint8_t bytes[] = {0x01, 0x02, 0x03, 0xFF};
+    Holder h = Holder::create_byte_array(bytes, sizeof(bytes));
+
+    EXPECT_EQ(h.type(), Holder::Type::ARRAY);
+    EXPECT_TRUE(h.is_byte_array());
+    EXPECT_EQ(h.byte_array_size(), 4);
+    EXPECT_EQ(h.signature(), "ay");
+    EXPECT_EQ(h.represent(), "Array:\n  01 02 03 ff \n");
+
+    EXPECT_EQ(h.get<std::vector<uint8_t>>(), std::vector<uint8_t>({0x01, 0x02, 0x03, 0xFF}));
+
+    auto elements = h.get<std::vector<Holder>>();
+    ASSERT_EQ(elements.size(), 4);
+    EXPECT_EQ(elements[3].type(), Holder::Type::BYTE);
+    EXPECT_EQ(elements[3].get<uint8_t>(), 0xFF);
+
+    // A byte array must compare equal to the same contents stored one Holder per byte.
+    Holder h_elements = Holder::create(std::vector<uint8_t>({0x01, 0x02, 0x03, 0xFF}));
+    EXPECT_EQ(h, h_elements);
+    EXPECT_EQ(h_elements, h);
+
+    // Appending falls back to per-element storage without losing contents.
+    h.array_append(Holder::create<uint8_t>(0x04));
+    EXPECT_FALSE(h.is_byte_array());
+    EXPECT_EQ(h.get<std::vector<uint8_t>>(), std::vector<uint8_t>({0x01, 0x02, 0x03, 0xFF, 0x04}));
+}
+
+TEST(Holder, ReferenceAccessors) {
+    Holder h = Holder::create<std::map<std::string, Holder>>();
+    h.dict_append(Holder::Type::STRING, "RSSI", Holder::create<int16_t>(-70));
+    h.dict_append(Holder::create<std::string>("Name"), Holder::create<std::string>("Sensor"));
+
+    const auto& entries = h.dict_ref();
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries[0].first.string_ref(), "RSSI");
+    EXPECT_EQ(entries[0].second.get<int16_t>(), -70);
+    EXPECT_EQ(entries[1].first.string_ref(), "Name");
+    EXPECT_EQ(entries[1].second.string_ref(), "Sensor");
+    EXPECT_EQ(h.signature(), "a{sv}");
+
+    Holder array = Holder::create<std::vector<Holder>>();
+    array.array_append(Holder::create<int32_t>(42));
+
+    // Accessors for a different type return an empty value instead of failing.
+    EXPECT_TRUE(array.dict_ref().empty());
+    EXPECT_TRUE(array.string_ref().empty());
+}
+
+TEST(Holder, DictionaryDuplicateKeyReplacesValue) {
+    Holder h = Holder::create<std::map<std::string, Holder>>();
+    h.dict_append(Holder::Type::STRING, "RSSI", Holder::create<int16_t>(-70));
+    h.dict_append(Holder::Type::STRING, "Name", Holder::create<std::string>("Sensor"));
+    h.dict_append(Holder::create<std::string>("RSSI"), Holder::create<int16_t>(-50));
+
+    const auto& entries = h.dict_ref();
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries[0].first.string_ref(), "RSSI");
+    EXPECT_EQ(entries[0].second.get<int16_t>(), -50);
+    EXPECT_EQ(entries[1].first.string_ref(), "Name");
+}
+
+TEST(Holder, DictionaryIntegerKeyConversion) {
+    // Keys passed with a different integer type than the declared key type are still accepted.
+    Holder h = Holder::create<std::map<uint16_t, Holder>>();
+    h.dict_append(Holder::Type::UINT16, 0x004C, Holder::create<std::string>("value"));
+
+    auto dict = h.get<std::map<uint16_t, Holder>>();
+    ASSERT_EQ(dict.count(0x004C), 1);
+    EXPECT_EQ(dict[0x004C].get<std::string>(), "value");
+    EXPECT_EQ(h.signature(), "a{qs}");
+}
@@ -398,4 +398,62 @@ TEST_F(MessageTest, MoveAssignment) {
     EXPECT_EQ(move_assigned.get_path(), "/org/example/Path");
     EXPECT_EQ(move_assigned.get_interface(), "org.example.Interface");
     EXPECT_EQ(move_assigned.get_member(), "ExampleMethod");
-}
\ No newline at end of file
+}
+
+TEST_F(MessageTest, ExtractByteArray) {
+    Message msg = Message::create_method_call("org.example.Bus", "/org/example/Path", "org.example.Interface",
+                                              "ExampleMethod");
+
+    const uint8_t bytes[] = {0xDE, 0xAD, 0xBE, 0xEF};
+    const uint8_t* p_bytes = bytes;
+    DBusMessage* raw_msg = msg;
+    dbus_message_append_args(raw_msg, DBUS_TYPE_ARRAY, DBUS_TYPE_BYTE, &p_bytes, 4, DBUS_TYPE_INVALID);
+
+    Holder h = msg.extract();
+    EXPECT_EQ(h.type(), Holder::Type::ARRAY);
+    EXPECT_TRUE(h.is_byte_array());
+    EXPECT_EQ(h.get<std::vector<uint8_t>>(), std::vector<uint8_t>({0xDE, 0xAD, 0xBE, 0xEF}));
+}
+
+TEST_F(MessageTest, ExtractDictionary) {
+    Message msg = Message::create_method_call("org.example.Bus", "/org/example/Path", "org.example.Interface",
+                                              "ExampleMethod");
+
+    Holder h_dict = Holder::create<std::map<std::string, Holder>>();
+    for (int i = 0; i < 100; i++) {
+        h_dict.dict_append(Holder::STRING, "key" + std::to_string(i), Holder::create<int32_t>(i));
+    }
+    msg.append_argument(h_dict, "a{sv}");
+
+    // Entries are decoded in the order in which they were sent.
+    Holder h = msg.extract();
+    const Holder::DictEntries& entries = h.dict_ref();
+    ASSERT_EQ(entries.size(), 100);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(entries[i].first.get<std::string>(), "key" + std::to_string(i));
+        EXPECT_EQ(entries[i].second.get<int32_t>(), i);
+    }
+}
+
+TEST_F(MessageTest, AppendByteArray) {
+    const std::vector<uint8_t> bytes = {0xDE, 0xAD, 0xBE, 0xEF};
+
+    // Both the byte array and the per-element representations must serialize to the same 'ay' argument.
+    Holder h_elements = Holder::create<std::vector<Holder>>();
+    for (uint8_t byte : bytes) {
+        h_elements.array_append(Holder::create<uint8_t>(byte));
+    }
+
+    for (const Holder& argument : {Holder::create_byte_array(bytes.data(), bytes.size()), h_elements}) {
+        Message msg = Message::create_method_call("org.example.Bus", "/org/example/Path", "org.example.Interface",
+                                                  "ExampleMethod");
+        msg.append_argument(argument, "ay");
+
+        const uint8_t* p_bytes = nullptr;
+        int len = 0;
+        DBusMessage* raw_msg = msg;
+        ASSERT_TRUE(dbus_message_get_args(raw_msg, nullptr, DBUS_TYPE_ARRAY, DBUS_TYPE_BYTE, &p_bytes, &len,
+                                          DBUS_TYPE_INVALID));
+        EXPECT_EQ(std::vector<uint8_t>(p_bytes, p_bytes + len), bytes);
+    }
+}
@@ -156,3 +156,34 @@ TEST(ProxyChildren, RemoveChildWithInterfaces) {
     p.path_remove("/a", removed_interfaces);
     ASSERT_EQ(0, p.children().size());
 }
+
+namespace {
+
+class DescendantsCounter : public Proxy {
+  public:
+    using Proxy::Proxy;
+
+    void on_descendants_changed() override { changes++; }
+
+    int changes = 0;
+};
+
+}  // namespace
+
+TEST(ProxyChildren, NotifyDescendantsChanged) {
+    DescendantsCounter p(nullptr, "", "/a");
+
+    p.path_add("/a/b", Holder());
+    EXPECT_EQ(1, p.changes);
+
+    p.path_add("/a/b/c", Holder());
+    EXPECT_EQ(2, p.changes);
+
+    p.path_remove("/a/b/c", Holder::create<std::vector<Holder>>());
+    EXPECT_EQ(3, p.changes);
+
+    // Paths outside of the proxy are not its descendants.
+    p.path_add("/x", Holder());
+    p.path_remove("/x", Holder::create<std::vector<Holder>>());
+    EXPECT_EQ(3, p.changes);
+}
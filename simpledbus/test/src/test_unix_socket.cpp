@@ -3,6 +3,9 @@
 #include <simpledbus/base/UnixSocket.h>
 
 #include <array>
+#include <cerrno>
+#include <chrono>
+#include <thread>
 #include <vector>
 #include <unistd.h>
 
@@ -37,3 +40,70 @@ TEST(UnixSocketTest, MoveTransfersOwnership) {
 
     ::close(released_fd);
 }
+
+namespace {
+
+// Sends packets until the socket buffer is full and returns how many it took.
+size_t fill(UnixSocket& socket, std::vector<uint8_t>& packet) {
+    size_t count = 0;
+    while (socket.send(packet, MSG_NOSIGNAL | MSG_DONTWAIT) > 0) {
+        count++;
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(UnixSocketTest, SendPacketsKeepsPacketBoundaries) {
+    auto sockets = UnixSocket::create_pair();
+
+    std::vector<uint8_t> first{0x01};
+    std::vector<uint8_t> second{0x02, 0x03};
+    std::vector<iovec> packets{{first.data(), first.size()}, {second.data(), second.size()}};
+    EXPECT_EQ(sockets.first.send_packets(packets, 0), 2);
+
+    std::array<uint8_t, 8> incoming{};
+    EXPECT_EQ(sockets.second.receive(incoming.data(), incoming.size()), 1);
+    EXPECT_EQ(incoming[0], 0x01);
+    EXPECT_EQ(sockets.second.receive(incoming.data(), incoming.size()), 2);
+    EXPECT_EQ(incoming[0], 0x02);
+    EXPECT_EQ(incoming[1], 0x03);
+}
+
+TEST(UnixSocketTest, SendPacketsWaitsForRoom) {
+    auto sockets = UnixSocket::create_pair();
+    std::vector<uint8_t> packet(64, 0x5A);
+    const size_t capacity = fill(sockets.first, packet);
+    ASSERT_GT(capacity, 0);
+
+    std::thread reader([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::array<uint8_t, 64> incoming{};
+        for (size_t i = 0; i < capacity; i++) {
+            sockets.second.receive(incoming.data(), incoming.size());
+        }
+    });
+
+    std::vector<iovec> packets(4, iovec{packet.data(), packet.size()});
+    EXPECT_EQ(sockets.first.send_packets(packets, 5000), 4);
+    reader.join();
+}
+
+TEST(UnixSocketTest, SendPacketsReportsPacketsLeftAfterTimeout) {
+    auto sockets = UnixSocket::create_pair();
+    std::vector<uint8_t> packet(64, 0x5A);
+    ASSERT_GT(fill(sockets.first, packet), 0);
+
+    std::vector<iovec> packets(4, iovec{packet.data(), packet.size()});
+    EXPECT_EQ(sockets.first.send_packets(packets, 20), 0);
+}
+
+TEST(UnixSocketTest, SendPacketsFailsOnceThePeerIsGone) {
+    auto sockets = UnixSocket::create_pair();
+    sockets.second.close();
+
+    std::vector<uint8_t> packet{0x01};
+    std::vector<iovec> packets{{packet.data(), packet.size()}};
+    EXPECT_EQ(sockets.first.send_packets(packets, 1000), -1);
+    EXPECT_EQ(errno, EPIPE);
+}
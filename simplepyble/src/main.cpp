@@ -23,6 +23,7 @@ void wrap_backend(py::module& m);
 void wrap_advanced(py::module& m);
 void wrap_config(py::module& m);
 void wrap_logging(py::module& m);
+void wrap_metrics(py::module& m);
 
 PYBIND11_MODULE(_simplepyble, m) {
     m.attr("__version__") = SIMPLEPYBLE_VERSION;
@@ -58,4 +59,5 @@ PYBIND11_MODULE(_simplepyble, m) {
     wrap_advanced(m);
     wrap_config(m);
     wrap_logging(m);
+    wrap_metrics(m);
 }
@@ -4,8 +4,8 @@ Type stubs for SimplePyBLE - Python bindings for SimpleBLE
 This module provides Bluetooth Low Energy (BLE) functionality for Python.
 """
 
-from typing import Callable, Dict, List, Optional
-from enum import Enum
+from typing import Callable, Dict, List, Optional, Union
+from enum import Enum, IntFlag
 
 __version__: str
 
@@ -23,6 +23,20 @@ class BluetoothAddressType(Enum):
     RANDOM = ...
     UNSPECIFIED = ...
 
+class CharacteristicProperty(IntFlag):
+    """Characteristic property bits, as defined by the Bluetooth specification."""
+    NONE = ...
+    BROADCAST = ...
+    READ = ...
+    WRITE_COMMAND = ...
+    WRITE_REQUEST = ...
+    NOTIFY = ...
+    INDICATE = ...
+    AUTHENTICATED_SIGNED_WRITES = ...
+    EXTENDED_PROPERTIES = ...
+    RELIABLE_WRITE = ...
+    WRITABLE_AUXILIARIES = ...
+
 class AndroidConnectionPriority(Enum):
     """Android connection priority request."""
     DISABLED = ...
@@ -81,6 +95,15 @@ class Characteristic:
         """
         ...
     
+    def properties(self) -> CharacteristicProperty:
+        """
+        Get the properties of the characteristic, including the extended ones.
+        
+        Returns:
+            CharacteristicProperty: Bitmask of the characteristic properties
+        """
+        ...
+    
     def can_read(self) -> bool:
         """
         Check if the characteristic can be read.
@@ -532,6 +555,20 @@ class Adapter:
         """
         ...
     
+    def set_callback_on_scan_batch(self, callback: Optional[Callable[[List[Peripheral]], None]],
+                                   interval_ms: int = 50) -> None:
+        """
+        Set the callback to be called with batches of found or updated peripherals.
+        
+        Updates are coalesced per peripheral over the given interval and delivered
+        from a dedicated thread, which reduces the number of GIL acquisitions.
+        
+        Args:
+            callback: Callback function to call with each batch of peripherals
+            interval_ms: Coalescing window in milliseconds
+        """
+        ...
+    
     def get_paired_peripherals(self) -> List[Peripheral]:
         """
         Get all paired peripherals.
@@ -605,6 +642,12 @@ class _SimpleBluezConfig:
 
     disconnection_timeout_ms: int
     """Disconnection timeout in milliseconds."""
+
+    peripheral_cache_max_entries: int
+    """Maximum number of peripherals kept per adapter, 0 for no limit."""
+
+    peripheral_cache_ttl_ms: int
+    """Time in milliseconds after which an unseen peripheral is evicted, 0 to disable."""
     
     @staticmethod
     def reset() -> None:
@@ -679,6 +722,49 @@ class _Config:
 config: _Config
 """Configuration module for SimpleBLE"""
 
+class _Metrics:
+    """Counters and latency histograms of the operations done by SimpleBLE."""
+
+    def set_enabled(self, enabled: bool) -> None:
+        """Enable or disable the recording of metrics."""
+        ...
+
+    def is_enabled(self) -> bool:
+        """Returns whether metrics are recorded."""
+        ...
+
+    def reset(self) -> None:
+        """Clear every counter, latency and trace event."""
+        ...
+
+    def snapshot(self) -> Dict[str, List[Dict[str, Union[str, int]]]]:
+        """
+        Returns the recorded counters and latencies.
+
+        Each entry holds the operation, adapter and peripheral it is keyed by. Counters have a value,
+        latencies a count and their min, max, mean and 50th, 90th, 99th and 99.9th percentiles in nanoseconds.
+        """
+        ...
+
+    def export_json(self) -> str:
+        """Returns the recorded metrics as a JSON document."""
+        ...
+
+    def set_tracing(self, enabled: bool, capacity: int = 65536) -> None:
+        """Record timed operations as trace events, keeping up to capacity of them."""
+        ...
+
+    def is_tracing(self) -> bool:
+        """Returns whether trace events are recorded."""
+        ...
+
+    def export_trace(self) -> str:
+        """Returns the trace events in the Chrome trace event format, which Perfetto can open."""
+        ...
+
+metrics: _Metrics
+"""Metrics module for SimpleBLE"""
+
 class _AdvancedMacOS:
     """Advanced CoreBluetooth APIs."""
 
@@ -60,6 +60,9 @@ class Characteristic:
     def capabilities(self) -> list[str]:
         return self._internal.capabilities()
 
+    def properties(self) -> simplepyble.CharacteristicProperty:
+        return self._internal.properties()
+
     def can_read(self) -> bool:
         return self._internal.can_read()
 
@@ -78,6 +78,11 @@ constexpr auto kDocsAdapterSetCallbackOnScanUpdated = R"pbdoc(
     Set the callback to be called when a peripheral is updated
 )pbdoc";
 
+constexpr auto kDocsAdapterSetCallbackOnScanBatch = R"pbdoc(
+    Set the callback to be called with batches of found or updated peripherals,
+    coalesced over the given interval in milliseconds
+)pbdoc";
+
 constexpr auto kDocsAdapterSetCallbackOnPowerOn = R"pbdoc(
     Set the callback to be called when the adapter is powered on
 )pbdoc";
@@ -114,6 +119,13 @@ void wrap_adapter(py::module& m) {
         .def("set_callback_on_scan_stop", &SimpleBLE::Adapter::set_callback_on_scan_stop, py::keep_alive<1, 2>(), kDocsAdapterSetCallbackOnScanStop)
         .def("set_callback_on_scan_found", &SimpleBLE::Adapter::set_callback_on_scan_found, py::keep_alive<1, 2>(), kDocsAdapterSetCallbackOnScanFound)
         .def("set_callback_on_scan_updated", &SimpleBLE::Adapter::set_callback_on_scan_updated, py::keep_alive<1, 2>(), kDocsAdapterSetCallbackOnScanUpdated)
+        .def(
+            "set_callback_on_scan_batch",
+            [](SimpleBLE::Adapter& adapter, std::function<void(std::vector<SimpleBLE::Peripheral>)> callback,
+               int interval_ms) {
+                adapter.set_callback_on_scan_batch(std::move(callback), std::chrono::milliseconds(interval_ms));
+            },
+            py::arg("callback"), py::arg("interval_ms") = 50, py::keep_alive<1, 2>(), kDocsAdapterSetCallbackOnScanBatch)
         .def("set_callback_on_power_on", &SimpleBLE::Adapter::set_callback_on_power_on, py::keep_alive<1, 2>(), kDocsAdapterSetCallbackOnPowerOn)
         .def("set_callback_on_power_off", &SimpleBLE::Adapter::set_callback_on_power_off, py::keep_alive<1, 2>(), kDocsAdapterSetCallbackOnPowerOff)
         .def("get_paired_peripherals", &SimpleBLE::Adapter::get_paired_peripherals, kDocsAdapterGetPairedPeripherals)
@@ -26,6 +26,10 @@ constexpr auto kDocsCharacteristicCapabilities = R"pbdoc(
     Capabilities of the characteristic
 )pbdoc";
 
+constexpr auto kDocsCharacteristicProperties = R"pbdoc(
+    Properties of the characteristic as a bitmask of CharacteristicProperty values
+)pbdoc";
+
 constexpr auto kDocsCharacteristicCanRead = R"pbdoc(
     Whether the characteristic can be read
 )pbdoc";
@@ -53,6 +57,12 @@ void wrap_characteristic(py::module& m) {
         .def("uuid", &SimpleBLE::Characteristic::uuid, kDocsCharacteristicUuid)
         .def("descriptors", &SimpleBLE::Characteristic::descriptors, kDocsCharacteristicDescriptors)
         .def("capabilities", &SimpleBLE::Characteristic::capabilities, kDocsCharacteristicCapabilities)
+        .def(
+            "properties",
+            [property_type = m.attr("CharacteristicProperty")](SimpleBLE::Characteristic& characteristic) {
+                return property_type(characteristic.properties());
+            },
+            kDocsCharacteristicProperties)
         .def("can_read", &SimpleBLE::Characteristic::can_read, kDocsCharacteristicCanRead)
         .def("can_write_request", &SimpleBLE::Characteristic::can_write_request, kDocsCharacteristicCanWriteRequest)
         .def("can_write_command", &SimpleBLE::Characteristic::can_write_command, kDocsCharacteristicCanWriteCommand)
@@ -56,6 +56,20 @@ namespace PyWrappers {
         static void set_disconnection_timeout_ms(int64_t value) {
             SimpleBLE::Config::SimpleBluez::disconnection_timeout = std::chrono::milliseconds(value);
         }
+        static size_t get_peripheral_cache_max_entries() {
+            return SimpleBLE::Config::SimpleBluez::peripheral_cache_max_entries;
+        }
+        static void set_peripheral_cache_max_entries(size_t value) {
+            SimpleBLE::Config::SimpleBluez::peripheral_cache_max_entries = value;
+        }
+        static int64_t get_peripheral_cache_ttl_ms() {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                       SimpleBLE::Config::SimpleBluez::peripheral_cache_ttl)
+                .count();
+        }
+        static void set_peripheral_cache_ttl_ms(int64_t value) {
+            SimpleBLE::Config::SimpleBluez::peripheral_cache_ttl = std::chrono::milliseconds(value);
+        }
 
         static void reset() {
             SimpleBLE::Config::SimpleBluez::reset();
@@ -174,6 +188,14 @@ constexpr auto kDocsConfigSimpleBluezDisconnectionTimeout = R"pbdoc(
     Disconnection timeout in milliseconds
 )pbdoc";
 
+constexpr auto kDocsConfigSimpleBluezPeripheralCacheMaxEntries = R"pbdoc(
+    Maximum number of peripherals kept per adapter, 0 for no limit
+)pbdoc";
+
+constexpr auto kDocsConfigSimpleBluezPeripheralCacheTtl = R"pbdoc(
+    Time in milliseconds after which an unseen peripheral is evicted, 0 to disable
+)pbdoc";
+
 constexpr auto kDocsConfigCoreBluetoothReset = R"pbdoc(
     Reset CoreBluetooth configuration options to their default values
 )pbdoc";
@@ -247,6 +269,14 @@ void wrap_config(py::module& m) {
             [](py::object) { return PyWrappers::SimpleBluez::get_disconnection_timeout_ms(); },
             [](py::object, int64_t value) { PyWrappers::SimpleBluez::set_disconnection_timeout_ms(value); },
             kDocsConfigSimpleBluezDisconnectionTimeout)
+        .def_property_static("peripheral_cache_max_entries",
+            [](py::object) { return PyWrappers::SimpleBluez::get_peripheral_cache_max_entries(); },
+            [](py::object, size_t value) { PyWrappers::SimpleBluez::set_peripheral_cache_max_entries(value); },
+            kDocsConfigSimpleBluezPeripheralCacheMaxEntries)
+        .def_property_static("peripheral_cache_ttl_ms",
+            [](py::object) { return PyWrappers::SimpleBluez::get_peripheral_cache_ttl_ms(); },
+            [](py::object, int64_t value) { PyWrappers::SimpleBluez::set_peripheral_cache_ttl_ms(value); },
+            kDocsConfigSimpleBluezPeripheralCacheTtl)
         .def_static("reset", &PyWrappers::SimpleBluez::reset, kDocsConfigSimpleBluezReset);
 
     py::class_<PyWrappers::CoreBluetooth> corebluetooth_config(config, "corebluetooth", kDocsConfigCoreBluetoothClass, py::metaclass());
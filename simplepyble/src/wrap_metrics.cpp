@@ -0,0 +1,73 @@
+#include <pybind11/pybind11.h>
+
+#include "simpleble/Metrics.h"
+
+namespace py = pybind11;
+
+namespace {
+
+py::dict key_to_dict(const SimpleBLE::Metrics::Key& key) {
+    py::dict result;
+    result["operation"] = key.operation;
+    result["adapter"] = key.adapter;
+    result["peripheral"] = key.peripheral;
+    return result;
+}
+
+py::dict snapshot() {
+    const SimpleBLE::Metrics::Snapshot metrics = SimpleBLE::Metrics::snapshot();
+
+    py::list counters;
+    for (const auto& counter : metrics.counters) {
+        py::dict entry = key_to_dict(counter.key);
+        entry["value"] = counter.value;
+        counters.append(entry);
+    }
+
+    py::list latencies;
+    for (const auto& latency : metrics.latencies) {
+        py::dict entry = key_to_dict(latency.key);
+        entry["count"] = latency.count;
+        entry["min_ns"] = latency.min.count();
+        entry["max_ns"] = latency.max.count();
+        entry["mean_ns"] = latency.mean().count();
+        entry["p50_ns"] = latency.percentile(0.5).count();
+        entry["p90_ns"] = latency.percentile(0.9).count();
+        entry["p99_ns"] = latency.percentile(0.99).count();
+        entry["p999_ns"] = latency.percentile(0.999).count();
+        latencies.append(entry);
+    }
+
+    py::dict result;
+    result["counters"] = counters;
+    result["latencies"] = latencies;
+    return result;
+}
+
+}  // namespace
+
+constexpr auto kDocsMetricsModule = R"pbdoc(
+    Counters and latency histograms of the operations done by SimpleBLE
+)pbdoc";
+
+constexpr auto kDocsMetricsSnapshot = R"pbdoc(
+    Returns the recorded counters and latencies, with the percentiles of each latency in nanoseconds
+)pbdoc";
+
+constexpr auto kDocsMetricsExportTrace = R"pbdoc(
+    Returns the trace events in the Chrome trace event format, which Perfetto can open
+)pbdoc";
+
+void wrap_metrics(py::module& m) {
+    auto metrics = m.def_submodule("metrics", kDocsMetricsModule);
+
+    metrics.def("set_enabled", &SimpleBLE::Metrics::set_enabled, "Enable or disable the recording of metrics");
+    metrics.def("is_enabled", &SimpleBLE::Metrics::is_enabled, "Returns whether metrics are recorded");
+    metrics.def("reset", &SimpleBLE::Metrics::reset, "Clear every counter, latency and trace event");
+    metrics.def("snapshot", &snapshot, kDocsMetricsSnapshot);
+    metrics.def("export_json", &SimpleBLE::Metrics::export_json, "Returns the recorded metrics as a JSON document");
+    metrics.def("set_tracing", &SimpleBLE::Metrics::set_tracing, py::arg("enabled"), py::arg("capacity") = 65536,
+                "Record timed operations as trace events, keeping up to capacity of them");
+    metrics.def("is_tracing", &SimpleBLE::Metrics::is_tracing, "Returns whether trace events are recorded");
+    metrics.def("export_trace", &SimpleBLE::Metrics::export_trace, kDocsMetricsExportTrace);
+}
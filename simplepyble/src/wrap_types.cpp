@@ -20,4 +20,21 @@ void wrap_types(py::module& m) {
         .value("RANDOM", SimpleBLE::BluetoothAddressType::RANDOM)
         .value("UNSPECIFIED", SimpleBLE::BluetoothAddressType::UNSPECIFIED)
         .export_values();
+
+    // Exposed as an IntFlag, so that the bitmask returned by Characteristic.properties() can be tested directly.
+    py::dict properties;
+    properties["NONE"] = static_cast<uint32_t>(SimpleBLE::CharacteristicProperty::NONE);
+    properties["BROADCAST"] = static_cast<uint32_t>(SimpleBLE::CharacteristicProperty::BROADCAST);
+    properties["READ"] = static_cast<uint32_t>(SimpleBLE::CharacteristicProperty::READ);
+    properties["WRITE_COMMAND"] = static_cast<uint32_t>(SimpleBLE::CharacteristicProperty::WRITE_COMMAND);
+    properties["WRITE_REQUEST"] = static_cast<uint32_t>(SimpleBLE::CharacteristicProperty::WRITE_REQUEST);
+    properties["NOTIFY"] = static_cast<uint32_t>(SimpleBLE::CharacteristicProperty::NOTIFY);
+    properties["INDICATE"] = static_cast<uint32_t>(SimpleBLE::CharacteristicProperty::INDICATE);
+    properties["AUTHENTICATED_SIGNED_WRITES"] =
+        static_cast<uint32_t>(SimpleBLE::CharacteristicProperty::AUTHENTICATED_SIGNED_WRITES);
+    properties["EXTENDED_PROPERTIES"] = static_cast<uint32_t>(SimpleBLE::CharacteristicProperty::EXTENDED_PROPERTIES);
+    properties["RELIABLE_WRITE"] = static_cast<uint32_t>(SimpleBLE::CharacteristicProperty::RELIABLE_WRITE);
+    properties["WRITABLE_AUXILIARIES"] = static_cast<uint32_t>(SimpleBLE::CharacteristicProperty::WRITABLE_AUXILIARIES);
+    m.attr("CharacteristicProperty") = py::module_::import("enum").attr("IntFlag")(
+        "CharacteristicProperty", properties, py::arg("module") = m.attr("__name__"));
 }